@@ -0,0 +1,267 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * bench_crc.cpp
+ *
+ * @brief Throughput comparison and cross check of all CRC32 implementations
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "crc/crc.hpp"
+#include "crc/crc32_parallel.hpp"
+
+extern "C" {
+#include "crc/crc32.h"
+#include "crc/crc32_kernels.h"
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+struct Implementation
+{
+    std::string name;
+    std::function<uint32_t(const uint8_t*, size_t)> Calculate;
+};
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define KB (1024U)
+#define MB (1024U * KB)
+
+#define MIN_SIZE (16U)
+#define UNALIGNED_OFFSET (3U)
+#define BUFFER_ALIGNMENT (64U)
+#define COLUMN_WIDTH (12)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+/* Keeps the compiler from dropping benchmarked calls */
+static volatile uint32_t f_sink;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static void AddArguments(argparse::ArgumentParser& parser)
+{
+    parser.add_argument("-m", "--max-size")
+        .help("Largest buffer size in bytes")
+        .default_value(size_t(64U * MB))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-t", "--min-time")
+        .help("Minimum measurement time per cell in milliseconds")
+        .default_value(size_t(100U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-q", "--quick")
+        .help("Short run for regression testing (1 MB, 1 ms)")
+        .flag();
+}
+
+static Implementation FromKernel(const char* name, Crc32Kernel_t kernel)
+{
+    return {name, [kernel](const uint8_t* data, size_t len) {
+        return kernel(0xFFFFFFFFU, data, len) ^ 0xFFFFFFFFU;
+    }};
+}
+
+static std::vector<Implementation> GetImplementations()
+{
+    std::vector<Implementation> impl;
+
+    /* First one is the reference for result checks */
+    impl.push_back(FromKernel("bitwise", &CRC32_KernelBitwise));
+    impl.push_back(FromKernel("table", &CRC32_KernelTable));
+
+    if (CRC32_HasPclmul())
+    {
+        impl.push_back(FromKernel("pclmul", &CRC32_KernelPclmul));
+    }
+
+    if (CRC32_HasArmv8())
+    {
+        impl.push_back(FromKernel("armv8", &CRC32_KernelArmv8));
+    }
+
+    impl.push_back({std::string("Calc/") + CRC32_GetKernelName(), &CRC32_Calculate});
+    impl.push_back({"Crc32<8>", [](const uint8_t* data, size_t len) {
+        return Crc::Crc32::Calculate(data, len);
+    }});
+    impl.push_back({"Crc32<16>", [](const uint8_t* data, size_t len) {
+        using Crc32x16 = Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, true, 0xFFFFFFFFU, 16U>;
+        return Crc32x16::Calculate(data, len);
+    }});
+    impl.push_back({"parallel", [](const uint8_t* data, size_t len) {
+        return Crc32::CalculateParallel(data, len);
+    }});
+
+    return impl;
+}
+
+static double MeasureNsPerByte(
+    const Implementation& impl,
+    const uint8_t* data,
+    size_t len,
+    std::chrono::nanoseconds minTime)
+{
+    using Clock = std::chrono::steady_clock;
+
+    size_t iterations = 0U;
+    const Clock::time_point start = Clock::now();
+    Clock::time_point now;
+
+    do
+    {
+        f_sink = f_sink + impl.Calculate(data, len);
+        iterations++;
+        now = Clock::now();
+    } while ((now - start) < minTime);
+
+    const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count();
+    return ns / ((double)iterations * (double)len);
+}
+
+static std::string FormatSize(size_t size)
+{
+    if ((size >= MB) && ((size % MB) == 0U))
+    {
+        return std::to_string(size / MB) + " MB";
+    }
+    if ((size >= KB) && ((size % KB) == 0U))
+    {
+        return std::to_string(size / KB) + " KB";
+    }
+    return std::to_string(size) + " B";
+}
+
+static void PrintHeader(const std::vector<Implementation>& impl)
+{
+    std::printf("%-10s %-9s", "size", "align");
+    for (const auto& i: impl)
+    {
+        std::printf(" %*s", COLUMN_WIDTH, i.name.c_str());
+    }
+    std::printf("   (ns/byte)\n");
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    std::cout << "bench_crc v0.1" << std::endl;
+
+    argparse::ArgumentParser parser("bench_crc v0.1");
+    AddArguments(parser);
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    const bool quick = parser.get<bool>("--quick");
+    const size_t maxSize = quick ? (1U * MB) : parser.get<size_t>("--max-size");
+    const std::chrono::nanoseconds minTime = std::chrono::milliseconds(
+        quick ? 1U : parser.get<size_t>("--min-time"));
+
+    const std::vector<Implementation> impl = GetImplementations();
+
+    std::vector<uint8_t> buffer(maxSize + BUFFER_ALIGNMENT + UNALIGNED_OFFSET);
+    for (auto& b: buffer)
+    {
+        b = (uint8_t)std::rand();
+    }
+
+    const uintptr_t base = (uintptr_t)buffer.data();
+    const size_t alignOffset = (BUFFER_ALIGNMENT - (base % BUFFER_ALIGNMENT)) % BUFFER_ALIGNMENT;
+    const uint8_t* aligned = &buffer[alignOffset];
+
+    std::cout << "Dispatched kernel: " << CRC32_GetKernelName() << std::endl;
+    PrintHeader(impl);
+
+    size_t mismatches = 0U;
+
+    for (size_t size = MIN_SIZE; size <= maxSize; size *= 4U)
+    {
+        for (size_t offset: {size_t(0U), size_t(UNALIGNED_OFFSET)})
+        {
+            const uint8_t* data = &aligned[offset];
+            const uint32_t expected = impl[0].Calculate(data, size);
+
+            std::printf("%-10s %-9s", FormatSize(size).c_str(), (offset == 0U) ? "aligned" : "unaligned");
+
+            for (const auto& i: impl)
+            {
+                if (i.Calculate(data, size) != expected)
+                {
+                    std::printf(" %*s", COLUMN_WIDTH, "MISMATCH");
+                    mismatches++;
+                    continue;
+                }
+
+                std::printf(" %*.3f", COLUMN_WIDTH, MeasureNsPerByte(i, data, size, minTime));
+            }
+
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+    }
+
+    if (mismatches > 0U)
+    {
+        std::cout << mismatches << " result mismatches" << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
+
+/* EoF bench_crc.cpp */
@@ -0,0 +1,680 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * bench_smallframe.cpp
+ *
+ * @brief Update transfer over a virtual CAN-FD bus
+ * 
+ * Uploads fragments through the multi packet transfer layer, which answers
+ * every packet, and through the small frame layer with several block sizes.
+ * The bus is simulated in process: each frame costs its CAN-FD bit time and
+ * each change of direction costs the configured turnaround latency, so
+ * results are repeatable and independent of the host. Frames can be dropped
+ * at random with a fixed seed to exercise recovery, which restarts the
+ * request after an error response or a timeout.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+
+extern "C" {
+#include "sha512.h"
+#include "updateserver/server.h"
+#include "updateserver/smallframe.h"
+#include "updateserver/transfer.h"
+}
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define KB (1024U)
+
+#define TRANSFER_BUFFER_SIZE (8U * KB)
+#define MAX_FRAME_SIZE (64U)
+#define MAX_ATTEMPTS (16U)
+#define CACHE_SIZE (4U)
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+enum Sender
+{
+    SENDER_NONE,
+    SENDER_CLIENT,
+    SENDER_SERVER
+};
+
+struct BusConfig
+{
+    size_t frameSize;
+    uint32_t nominalBps;
+    uint32_t dataBps;
+    uint64_t latencyNs;
+    uint64_t timeoutNs;
+    size_t dropInterval;
+};
+
+struct VirtualBus
+{
+    BusConfig config;
+    uint64_t nowNs;
+    uint64_t frames;
+    uint64_t serverFrames;
+    uint64_t dropped;
+    uint64_t timeouts;
+    uint32_t seed;
+    Sender last;
+};
+
+struct Profile
+{
+    const char* name;
+    bool smallFrame;
+    uint8_t blockSize;
+};
+
+typedef std::vector<uint8_t> Frame;
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static const Profile f_profiles[] = {
+    {"transfer", false, 0U},
+    {"small bs=1", true, 1U},
+    {"small bs=8", true, 8U},
+    {"small bs=16", true, 16U},
+    {"small bs=0", true, 0U},
+};
+
+static size_t f_errors;
+static size_t f_fragmentSize;
+static std::vector<size_t> f_received;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static void AddArguments(argparse::ArgumentParser& parser)
+{
+    parser.add_argument("-f", "--frame")
+        .help("Frame size in bytes, a CAN-FD data length of 8 to 64")
+        .default_value(size_t(64U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-s", "--size")
+        .help("Fragment payload size in bytes")
+        .default_value(size_t(4U * KB))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-c", "--count")
+        .help("Fragments uploaded per profile")
+        .default_value(size_t(64U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("--nominal")
+        .help("Arbitration bit rate")
+        .default_value(size_t(500000U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("--data")
+        .help("Data phase bit rate")
+        .default_value(size_t(2000000U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-l", "--latency")
+        .help("Turnaround latency in us when the sender changes")
+        .default_value(size_t(500U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-t", "--timeout")
+        .help("Response timeout in ms")
+        .default_value(size_t(20U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-d", "--drop")
+        .help("Drop one in N frames on the bus at random, 0 for none")
+        .default_value(size_t(0U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-q", "--quick")
+        .help("Short run for regression testing (8 fragments)")
+        .flag();
+}
+
+static void Check(bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::printf("FAILED: %s\n", what);
+        f_errors++;
+    }
+}
+
+static double Ms(uint64_t ns)
+{
+    return (double)ns / 1000000.0;
+}
+
+static size_t FdLength(size_t len)
+{
+    static const size_t lengths[] = {12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+    if (len <= 8U)
+    {
+        return len;
+    }
+    for (size_t l: lengths)
+    {
+        if (len <= l)
+        {
+            return l;
+        }
+    }
+    return 64U;
+}
+
+/* Frame as delivered by CAN-FD, padded up to the data length */
+static Frame Padded(const Frame& frame)
+{
+    Frame padded = frame;
+    padded.resize(FdLength(frame.size()), 0xCCU);
+    return padded;
+}
+
+static uint64_t FrameTimeNs(const BusConfig& config, size_t len)
+{
+    const uint64_t dataLength = FdLength(len);
+
+    /* SOF, base ID and control bits up to BRS, then CRC delimiter, ACK,
+     * EOF and intermission at the nominal rate */
+    const uint64_t nominalBits = 30U;
+
+    /* ESI, DLC, data, stuff count and CRC at the data rate, plus an
+     * average of one stuff bit in ten */
+    const uint64_t crcBits = (dataLength > 16U) ? 21U : 17U;
+    uint64_t dataBits = 5U + (8U * dataLength) + 4U + crcBits;
+    dataBits += dataBits / 10U;
+
+    return ((nominalBits * 1000000000ULL) / config.nominalBps) +
+           ((dataBits * 1000000000ULL) / config.dataBps);
+}
+
+static bool Transmit(VirtualBus& bus, Sender sender, size_t len)
+{
+    if ((bus.last != SENDER_NONE) && (bus.last != sender))
+    {
+        bus.nowNs += bus.config.latencyNs;
+    }
+
+    bus.last = sender;
+    bus.nowNs += FrameTimeNs(bus.config, len);
+    bus.frames++;
+
+    if (sender == SENDER_SERVER)
+    {
+        bus.serverFrames++;
+    }
+
+    bus.seed = (bus.seed * 1103515245U) + 12345U;
+
+    if ((bus.config.dropInterval != 0U) && (((bus.seed >> 8U) % bus.config.dropInterval) == 0U))
+    {
+        bus.dropped++;
+        return false;
+    }
+
+    return true;
+}
+
+static void Timeout(VirtualBus& bus)
+{
+    bus.nowNs += bus.config.timeoutNs;
+    bus.timeouts++;
+    bus.last = SENDER_NONE;
+}
+
+static void FragmentPayload(uint8_t* data, size_t size, uint32_t index)
+{
+    uint32_t seed = index;
+    for (size_t i = 0U; i < size; i++)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        data[i] = (uint8_t)(seed >> 16U);
+    }
+    memcpy(data, &index, std::min(size, sizeof(index)));
+}
+
+static Frame FragmentRequest(uint32_t index)
+{
+    Frame request(1U + f_fragmentSize);
+    request[0] = PROTOCOL_SID_PUT_FRAGMENT;
+    FragmentPayload(&request[1], f_fragmentSize, index);
+    return request;
+}
+
+/* Truncated SHA-512 of a request for the response cache */
+static void RequestDigest(
+    const uint8_t* data, 
+    size_t size, 
+    uint8_t* digest)
+{
+    uint8_t hash[64];
+    sha512(data, size, hash);
+    memcpy(digest, hash, US_REQUEST_DIGEST_SIZE);
+}
+
+static uint8_t BenchReadDataById(uint8_t, uint8_t*, size_t, size_t*)
+{
+    return PROTOCOL_NACK_REQUEST_OUT_OF_RANGE;
+}
+
+static uint8_t BenchWriteDataById(uint8_t, const uint8_t*, size_t)
+{
+    return PROTOCOL_NACK_REQUEST_OUT_OF_RANGE;
+}
+
+static uint8_t BenchPutMetadata(uint8_t*, size_t, size_t)
+{
+    return PROTOCOL_NACK_REQUEST_OUT_OF_RANGE;
+}
+
+static uint8_t BenchPutFragment(uint8_t* data, size_t size, size_t)
+{
+    uint32_t index = 0U;
+    std::vector<uint8_t> expected(f_fragmentSize);
+
+    if (size == f_fragmentSize)
+    {
+        memcpy(&index, data, std::min(size, sizeof(index)));
+    }
+    if ((size != f_fragmentSize) || (index >= f_received.size()))
+    {
+        Check(false, "fragment size and index");
+        return PROTOCOL_NACK_INVALID_REQUEST;
+    }
+
+    FragmentPayload(expected.data(), expected.size(), index);
+    Check(memcmp(data, expected.data(), size) == 0, "fragment content");
+
+    f_received[index]++;
+    return PROTOCOL_ACK_OK;
+}
+
+/* Server side of the bus for one profile */
+class Server
+{
+public:
+    Server(const Profile& profile, size_t frameSize)
+        : m_profile(profile), m_frameSize(frameSize), m_buffer(TRANSFER_BUFFER_SIZE)
+    {
+        bool ok = 
+            US_InitServer(&m_server, BenchReadDataById, BenchWriteDataById, BenchPutMetadata, BenchPutFragment) &&
+            US_SetResponseCache(&m_server, &m_cache, m_cacheEntries, CACHE_SIZE, RequestDigest);
+
+        if (profile.smallFrame)
+        {
+            ok = ok && SMALLFRAME_Init(&m_sf, &m_server, m_buffer.data(), m_buffer.size(), 8U, profile.blockSize);
+        }
+        else
+        {
+            ok = ok && TRANSFER_InitAligned(&m_tb, &m_server, m_buffer.data(), m_buffer.size(), 8U);
+        }
+
+        Check(ok, "server init");
+    }
+
+    /* Deliver a client frame, returns the response frame or an empty one.
+     * Small frames are padded to the CAN-FD data length in both directions.
+     * The multi packet transfer layer takes its data length from the frame,
+     * so its frames are delivered unpadded. */
+    Frame Receive(const Frame& frame)
+    {
+        const Frame rx = m_profile.smallFrame ? Padded(frame) : frame;
+
+        uint8_t buf[MAX_FRAME_SIZE];
+        memcpy(buf, rx.data(), rx.size());
+
+        const size_t len = m_profile.smallFrame ?
+            SMALLFRAME_Process(&m_sf, buf, rx.size(), m_frameSize) :
+            TRANSFER_Process(&m_tb, buf, rx.size(), m_frameSize);
+
+        const Frame tx(&buf[0], &buf[len]);
+        return (m_profile.smallFrame && !tx.empty()) ? Padded(tx) : tx;
+    }
+
+private:
+    const Profile& m_profile;
+    size_t m_frameSize;
+    std::vector<uint8_t> m_buffer;
+    UpdateServer_t m_server;
+    ResponseCache_t m_cache;
+    ResponseCacheEntry_t m_cacheEntries[CACHE_SIZE];
+    TransferBuffer_t m_tb;
+    SmallFrameTransfer_t m_sf;
+};
+
+/* Client frame over the bus, returns the server response if one arrives */
+static Frame Send(VirtualBus& bus, Server& server, const Frame& frame)
+{
+    if (!Transmit(bus, SENDER_CLIENT, frame.size()))
+    {
+        return Frame();
+    }
+
+    const Frame response = server.Receive(frame);
+
+    if (response.empty() || !Transmit(bus, SENDER_SERVER, response.size()))
+    {
+        return Frame();
+    }
+
+    return response;
+}
+
+static Frame Chunk(uint8_t header, const Frame& request, size_t offset, size_t size)
+{
+    Frame frame = {header};
+    frame.insert(frame.end(), request.begin() + offset, request.begin() + offset + size);
+    return frame;
+}
+
+static Frame SingleRequest(VirtualBus& bus, Server& server, uint8_t header, const Frame& request)
+{
+    Frame response = Send(bus, server, Chunk(header, request, 0U, request.size()));
+    if (response.empty())
+    {
+        Timeout(bus);
+    }
+    return response;
+}
+
+/* One attempt over the multi packet transfer layer */
+static Frame TransferAttempt(VirtualBus& bus, Server& server, const Frame& request)
+{
+    const size_t chunkSize = bus.config.frameSize - 1U;
+
+    if (request.size() <= chunkSize)
+    {
+        return SingleRequest(bus, server, TRANSFER_SINGLE_PACKET, request);
+    }
+
+    const uint32_t size = (uint32_t)request.size();
+    const Frame init = {
+        TRANSFER_MULTI_PACKET_INIT,
+        (uint8_t)(size >> 24U), (uint8_t)(size >> 16U), (uint8_t)(size >> 8U), (uint8_t)size
+    };
+
+    Frame response = Send(bus, server, init);
+
+    for (size_t offset = 0U; !response.empty() && (response[2] == PROTOCOL_ACK_OK); )
+    {
+        if (offset == request.size())
+        {
+            return SingleRequest(bus, server, TRANSFER_MULTI_PACKET_END, Frame());
+        }
+
+        const size_t n = std::min(chunkSize, request.size() - offset);
+        response = Send(bus, server, Chunk(TRANSFER_MULTI_PACKET_TRANSFER, request, offset, n));
+        offset += n;
+    }
+
+    if (response.empty())
+    {
+        Timeout(bus);
+    }
+    return Frame();
+}
+
+/* Single frame response without the header and padding */
+static Frame SmallFrameResponse(const Frame& response)
+{
+    if (response.empty() || ((response[0] & SMALLFRAME_TYPE_MASK) != SMALLFRAME_SINGLE))
+    {
+        return Frame();
+    }
+
+    const size_t length = response[0] & SMALLFRAME_LENGTH_MASK;
+    if (length >= response.size())
+    {
+        return Frame();
+    }
+
+    return Frame(response.begin(), response.begin() + 1 + length);
+}
+
+/* One attempt over the small frame transfer layer */
+static Frame SmallFrameAttempt(VirtualBus& bus, Server& server, const Frame& request)
+{
+    const size_t frameSize = bus.config.frameSize;
+
+    if (request.size() <= (frameSize - 1U))
+    {
+        const uint8_t header = SMALLFRAME_SINGLE | (uint8_t)request.size();
+        return SmallFrameResponse(SingleRequest(bus, server, header, request));
+    }
+
+    const uint32_t size = (uint32_t)request.size();
+    Frame first = {
+        SMALLFRAME_FIRST,
+        (uint8_t)(size >> 24U), (uint8_t)(size >> 16U), (uint8_t)(size >> 8U), (uint8_t)size
+    };
+    size_t offset = frameSize - first.size();
+    first.insert(first.end(), request.begin(), request.begin() + offset);
+
+    Frame response = Send(bus, server, first);
+    if (response.empty())
+    {
+        Timeout(bus);
+        return Frame();
+    }
+    if ((response[0] & SMALLFRAME_TYPE_MASK) != SMALLFRAME_FLOW_CONTROL)
+    {
+        return Frame();
+    }
+
+    const uint8_t blockSize = response[1];
+    uint8_t blockFrames = 0U;
+    uint8_t sequence = 1U;
+
+    while (offset < request.size())
+    {
+        const size_t n = std::min(frameSize - 1U, request.size() - offset);
+        const uint8_t header = SMALLFRAME_CONSECUTIVE | (sequence & SMALLFRAME_SEQUENCE_MASK);
+
+        response = Send(bus, server, Chunk(header, request, offset, n));
+        offset += n;
+        sequence++;
+        blockFrames++;
+
+        const bool last = (offset == request.size());
+        const bool blockEnd = (blockSize != 0U) && (blockFrames == blockSize);
+
+        if (response.empty())
+        {
+            if (last || blockEnd)
+            {
+                /* Waiting for a response or flow control that was lost */
+                Timeout(bus);
+                return Frame();
+            }
+            continue;
+        }
+
+        if ((response[0] & SMALLFRAME_TYPE_MASK) == SMALLFRAME_FLOW_CONTROL)
+        {
+            blockFrames = 0U;
+            continue;
+        }
+
+        /* Final response, or an error that ends the attempt */
+        return last ? SmallFrameResponse(response) : Frame();
+    }
+
+    return Frame();
+}
+
+static void BenchProfile(const BusConfig& config, const Profile& profile, size_t count)
+{
+    VirtualBus bus = {};
+    bus.config = config;
+    bus.seed = 1U;
+
+    Server server(profile, config.frameSize);
+    f_received.assign(count, 0U);
+
+    size_t retries = 0U;
+
+    for (uint32_t i = 0U; i < count; i++)
+    {
+        const Frame request = FragmentRequest(i);
+        bool done = false;
+
+        for (size_t attempt = 0U; !done && (attempt < MAX_ATTEMPTS); attempt++)
+        {
+            const Frame response = profile.smallFrame ?
+                SmallFrameAttempt(bus, server, request) :
+                TransferAttempt(bus, server, request);
+
+            done = (response.size() == 3U) &&
+                   (response[1] == PROTOCOL_SID_PUT_FRAGMENT) &&
+                   (response[2] == PROTOCOL_ACK_OK);
+
+            retries += done ? 0U : 1U;
+        }
+
+        Check(done, "fragment upload");
+    }
+
+    for (size_t n: f_received)
+    {
+        Check(n == 1U, "fragment stored once");
+    }
+    if (config.dropInterval == 0U)
+    {
+        Check(retries == 0U, "no retries on a lossless bus");
+    }
+
+    const double seconds = (double)bus.nowNs / 1000000000.0;
+    const double kbps = (seconds > 0.0) ? ((double)(count * f_fragmentSize) / KB / seconds) : 0.0;
+
+    std::printf("%-12s %10llu %10llu %8llu %8zu %12.1f %10.1f\n",
+        profile.name,
+        (unsigned long long)bus.frames,
+        (unsigned long long)bus.serverFrames,
+        (unsigned long long)bus.dropped,
+        retries,
+        Ms(bus.nowNs) / (double)count,
+        kbps);
+}
+
+/*----------------------------------------------------------------------------*/
+/* MAIN FUNCTION                                                              */
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    std::cout << "bench_smallframe v0.1" << std::endl;
+
+    argparse::ArgumentParser parser("bench_smallframe v0.1");
+    AddArguments(parser);
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    const bool quick = parser.get<bool>("--quick");
+    const size_t count = quick ? 8U : parser.get<size_t>("--count");
+
+    BusConfig config;
+    config.frameSize = parser.get<size_t>("--frame");
+    config.nominalBps = (uint32_t)parser.get<size_t>("--nominal");
+    config.dataBps = (uint32_t)parser.get<size_t>("--data");
+    config.latencyNs = parser.get<size_t>("--latency") * 1000U;
+    config.timeoutNs = parser.get<size_t>("--timeout") * 1000000U;
+    config.dropInterval = parser.get<size_t>("--drop");
+
+    f_fragmentSize = parser.get<size_t>("--size");
+
+    if ((config.frameSize < SMALLFRAME_MIN_FRAME_SIZE) || 
+        (config.frameSize > MAX_FRAME_SIZE) ||
+        (FdLength(config.frameSize) != config.frameSize))
+    {
+        std::cerr << "Frame size must be a CAN-FD data length of 8 to 64 bytes" << std::endl;
+        return 1;
+    }
+    if ((f_fragmentSize < sizeof(uint32_t)) || (f_fragmentSize >= TRANSFER_BUFFER_SIZE))
+    {
+        std::cerr << "Fragment size must be 4 to " << (TRANSFER_BUFFER_SIZE - 1U) << " bytes" << std::endl;
+        return 1;
+    }
+    if ((count == 0U) || (config.nominalBps == 0U) || (config.dataBps == 0U))
+    {
+        std::cerr << "Count and bit rates must be non-zero" << std::endl;
+        return 1;
+    }
+
+    std::printf("Virtual CAN-FD bus, %zu byte frames, %u/%u kbit/s, %llu us turnaround\n",
+        config.frameSize,
+        (unsigned)(config.nominalBps / 1000U),
+        (unsigned)(config.dataBps / 1000U),
+        (unsigned long long)(config.latencyNs / 1000U));
+    std::printf("%zu fragments of %zu bytes\n\n", count, f_fragmentSize);
+
+    std::printf("Profile          frames  responses  dropped  retries  ms/fragment       KB/s\n");
+
+    for (const Profile& profile: f_profiles)
+    {
+        BenchProfile(config, profile, count);
+    }
+
+    if (f_errors > 0U)
+    {
+        std::cout << f_errors << " errors" << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
+
+/* EoF bench_smallframe.cpp */
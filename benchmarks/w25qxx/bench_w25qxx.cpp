@@ -0,0 +1,471 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * bench_w25qxx.cpp
+ *
+ * @brief W25Qxx interface timing on the simulated device
+ * 
+ * All times are virtual: SPI bus time at the simulated clock plus the delays
+ * the driver waits for programs and erases, so results are repeatable and
+ * independent of the host.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+
+extern "C" {
+#include "w25qsim.h"
+#include "w25qxx/async_interface.h"
+#include "w25qxx/flash_interface.h"
+}
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define KB (1024U)
+#define MB (1024U * KB)
+
+#define DEVICE_SIZE (16U * MB)
+#define WORK_BUFFER_SIZE (4U * KB)
+#define READ_AHEAD_SIZE (1U * KB)
+#define TICK_NS (100000U)
+#define ASYNC_QUEUE_SIZE (4U)
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+struct Device
+{
+    std::vector<uint8_t> memory;
+    W25QSim_t sim;
+    w25qxx_handle_t handle;
+    W25QxxInstance_t inst;
+    std::vector<uint8_t> work;
+};
+
+struct AsyncDevice
+{
+    W25QSim_t* sim;
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[ASYNC_QUEUE_SIZE];
+    bool pending;
+};
+
+struct ReadMode
+{
+    W25QxxReadMode_t mode;
+    const char* name;
+};
+
+struct Interface
+{
+    w25qxx_interface_t bus;
+    w25qxx_bool_t dualQuad;
+    const char* name;
+};
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static const ReadMode f_readModes[] = {
+    {W25QXX_READ_STANDARD, "standard"},
+    {W25QXX_READ_FAST, "fast"},
+    {W25QXX_READ_DUAL_OUTPUT, "dual out"},
+    {W25QXX_READ_QUAD_OUTPUT, "quad out"},
+    {W25QXX_READ_QUAD_IO, "quad io"},
+    {W25QXX_READ_QUAD_IO_CONTINUOUS, "quad cont"},
+};
+
+/* Driver bus configurations, the direct read commands differ for each */
+static const Interface f_interfaces[] = {
+    {W25QXX_INTERFACE_SPI, W25QXX_BOOL_FALSE, "SPI"},
+    {W25QXX_INTERFACE_QSPI, W25QXX_BOOL_FALSE, "QSPI"},
+    {W25QXX_INTERFACE_QSPI, W25QXX_BOOL_TRUE, "QSPI, QPI mode"},
+};
+
+static size_t f_errors;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static void AddArguments(argparse::ArgumentParser& parser)
+{
+    parser.add_argument("-s", "--size")
+        .help("Bytes read and written per measurement")
+        .default_value(size_t(1U * MB))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-q", "--quick")
+        .help("Short run for regression testing (64 KB)")
+        .flag();
+}
+
+static void Check(bool ok, const char* what)
+{
+    if (!ok)
+    {
+        std::printf("FAILED: %s\n", what);
+        f_errors++;
+    }
+}
+
+static double Ms(uint64_t ns)
+{
+    return (double)ns / 1000000.0;
+}
+
+static std::unique_ptr<Device> CreateDevice(const Interface& iface)
+{
+    std::unique_ptr<Device> dev(new Device());
+
+    dev->memory.resize(DEVICE_SIZE);
+    dev->work.resize(WORK_BUFFER_SIZE);
+    W25QSIM_Init(&dev->sim, dev->memory.data(), dev->memory.size(), NULL);
+    W25QSIM_Select(&dev->sim);
+
+    DRIVER_W25QXX_LINK_INIT(&dev->handle, w25qxx_handle_t);
+    DRIVER_W25QXX_LINK_SPI_QSPI_INIT(&dev->handle, W25QSIM_SpiQspiInit);
+    DRIVER_W25QXX_LINK_SPI_QSPI_DEINIT(&dev->handle, W25QSIM_SpiQspiDeinit);
+    DRIVER_W25QXX_LINK_SPI_QSPI_WRITE_READ(&dev->handle, W25QSIM_SpiQspiWriteRead);
+    DRIVER_W25QXX_LINK_DELAY_MS(&dev->handle, W25QSIM_DelayMs);
+    DRIVER_W25QXX_LINK_DELAY_US(&dev->handle, W25QSIM_DelayUs);
+    DRIVER_W25QXX_LINK_DEBUG_PRINT(&dev->handle, W25QSIM_DebugPrint);
+
+    const bool ok =
+        (0U == w25qxx_set_type(&dev->handle, (w25qxx_type_t)W25QSIM_Type(&dev->sim))) &&
+        (0U == w25qxx_set_interface(&dev->handle, iface.bus)) &&
+        (0U == w25qxx_set_dual_quad_spi(&dev->handle, iface.dualQuad)) &&
+        (0U == w25qxx_init(&dev->handle)) &&
+        W25Qxx_INSTANCE_Init(&dev->inst, &dev->handle, dev->work.data(), dev->work.size()) &&
+        W25Qxx_INSTANCE_ConfigureErase(&dev->inst, DEVICE_SIZE, NULL);
+
+    if (!ok)
+    {
+        return nullptr;
+    }
+
+    W25QSIM_WaitReady(&dev->sim);
+    return dev;
+}
+
+static void FillPattern(uint8_t* data, size_t size, uint32_t seed)
+{
+    for (size_t i = 0U; i < size; i++)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        data[i] = (uint8_t)(seed >> 16U);
+    }
+}
+
+static void BenchErase(Device& dev, size_t maxSize)
+{
+    struct Region { Address_t address; size_t size; };
+    const Region regions[] = {
+        {0x000000U, 4U * KB},
+        {0x010000U, 36U * KB},
+        {0x023000U, 200U * KB},
+        {0x100000U, maxSize},
+        {0x000000U, DEVICE_SIZE},
+    };
+
+    std::printf("\nErase                      planned ms  simulated ms   4 KB only ms\n");
+
+    for (const Region& r: regions)
+    {
+        W25QxxErasePlan_t plan;
+        Check(W25Qxx_INSTANCE_PlanErase(&dev.inst, r.address, r.size, &plan), "erase plan");
+
+        uint64_t start = dev.sim.nowNs;
+        Check(W25Qxx_INSTANCE_EraseFlash(&dev.inst, r.address, r.size), "planned erase");
+        W25QSIM_WaitReady(&dev.sim);
+        const uint64_t planned = dev.sim.nowNs - start;
+
+        std::printf("%8zu KB at 0x%06X %14.1f %13.1f",
+            r.size / KB, (unsigned)r.address, (double)plan.totalUs / 1000.0, Ms(planned));
+
+        /* Whole device in sectors is too slow to be interesting */
+        if (r.size < DEVICE_SIZE)
+        {
+            start = dev.sim.nowNs;
+            for (size_t pos = 0U; pos < r.size; pos += 4U * KB)
+            {
+                Check(W25Qxx_INSTANCE_EraseFlash(&dev.inst, r.address + pos, 4U * KB), "sector erase");
+            }
+            W25QSIM_WaitReady(&dev.sim);
+            std::printf(" %14.1f", Ms(dev.sim.nowNs - start));
+        }
+
+        std::printf("\n");
+    }
+}
+
+static void BenchRead(Device& dev, size_t size)
+{
+    std::vector<uint8_t> readAhead(READ_AHEAD_SIZE);
+    std::vector<uint8_t> out(size);
+
+    /* Content written directly, reads are what is measured */
+    FillPattern(dev.memory.data(), size, 1U);
+
+    std::printf("\nSequential read MB/s    chunk 64  chunk 64 RA   chunk 4 KB\n");
+
+    for (const ReadMode& m: f_readModes)
+    {
+        std::printf("%-20s", m.name);
+
+        /* Not available in this bus configuration */
+        if (!W25Qxx_INSTANCE_ConfigureRead(&dev.inst, m.mode, NULL, 0U))
+        {
+            std::printf(" %12s\n", "n/a");
+            continue;
+        }
+
+        for (int column = 0; column < 3; column++)
+        {
+            const size_t chunk = (column < 2) ? 64U : 4U * KB;
+            const bool ahead = (column == 1);
+
+            Check(W25Qxx_INSTANCE_ConfigureRead(&dev.inst, m.mode,
+                ahead ? readAhead.data() : NULL, ahead ? readAhead.size() : 0U), "configure read");
+
+            std::fill(out.begin(), out.end(), 0U);
+            const uint64_t start = dev.sim.nowNs;
+            for (size_t pos = 0U; pos < size; pos += chunk)
+            {
+                Check(W25Qxx_INSTANCE_ReadFlash(&dev.inst, pos, chunk, &out[pos]), "read");
+            }
+            const uint64_t ns = dev.sim.nowNs - start;
+
+            Check(0 == memcmp(out.data(), dev.memory.data(), size), "read data");
+            std::printf(" %12.2f", ((double)size * 1000.0) / ((double)ns * (double)MB / 1000000.0));
+        }
+
+        std::printf("\n");
+    }
+
+    Check(W25Qxx_INSTANCE_ConfigureRead(&dev.inst, W25QXX_READ_STANDARD, NULL, 0U), "configure read");
+}
+
+static void BenchVerify(Device& dev, size_t size)
+{
+    std::vector<uint8_t> data(size);
+    FillPattern(data.data(), size, 2U);
+
+    std::printf("\nWrite and verify         total ms    verify ms   bytes read\n");
+
+    for (W25QxxVerifyMode_t mode: {W25QXX_VERIFY_COMPARE, W25QXX_VERIFY_CRC})
+    {
+        Check(W25Qxx_INSTANCE_ConfigureVerify(&dev.inst, mode), "configure verify");
+        Check(W25Qxx_INSTANCE_EraseFlash(&dev.inst, 0U, size), "erase");
+        W25QSIM_WaitReady(&dev.sim);
+
+        uint64_t start = dev.sim.nowNs;
+        Check(W25Qxx_INSTANCE_WriteFlash(&dev.inst, 0U, size, data.data()), "write");
+        const uint64_t writeNs = dev.sim.nowNs - start;
+
+        Check(W25Qxx_INSTANCE_EraseFlash(&dev.inst, 0U, size), "erase");
+        W25QSIM_WaitReady(&dev.sim);
+
+        const uint64_t bytesRead = dev.sim.stats.bytesRead;
+        start = dev.sim.nowNs;
+        Check(W25Qxx_INSTANCE_WriteAndVerifyFlash(&dev.inst, 0U, size, data.data()), "write and verify");
+        const uint64_t totalNs = dev.sim.nowNs - start;
+
+        Check(0 == memcmp(dev.memory.data(), data.data(), size), "written data");
+        std::printf("%-20s %12.2f %12.2f %12llu\n",
+            (mode == W25QXX_VERIFY_COMPARE) ? "compare" : "crc",
+            Ms(totalNs), Ms(totalNs - writeNs),
+            (unsigned long long)(dev.sim.stats.bytesRead - bytesRead));
+    }
+}
+
+static bool AsyncTransfer(void* port, const uint8_t* cmd, size_t cmdLen, const uint8_t* tx, uint8_t* rx, size_t dataLen)
+{
+    AsyncDevice* dev = (AsyncDevice*)port;
+    dev->pending = W25QSIM_TransferBytes(dev->sim, cmd, cmdLen, tx, rx, dataLen);
+    return dev->pending;
+}
+
+/* Transfer completes on the next step, status polls on the timer tick */
+static void AsyncStep(AsyncDevice& dev)
+{
+    if (dev.pending)
+    {
+        dev.pending = false;
+        W25Qxx_ASYNC_OnTransferDone(&dev.handle, true);
+    }
+    else
+    {
+        W25QSIM_Advance(dev.sim, TICK_NS);
+        W25Qxx_ASYNC_OnTick(&dev.handle);
+    }
+}
+
+static void AsyncDone(void* ctx, bool ok)
+{
+    Check(ok, "async request");
+    *(bool*)ctx = true;
+}
+
+static void BenchAsync(Device& dev)
+{
+    AsyncDevice async = {};
+    async.sim = &dev.sim;
+
+    W25QxxAsyncPort_t port = {};
+    port.Transfer = AsyncTransfer;
+    port.port = &async;
+
+    std::vector<uint8_t> out(256U);
+
+    std::printf("\nRead during 64 KB erase   read latency ms  erase ms  suspends\n");
+
+    for (size_t limit: {size_t(0U), size_t(W25QXX_ASYNC_MAX_SUSPENDS)})
+    {
+        Check(W25Qxx_ASYNC_Init(&async.handle, &port, async.queue, ASYNC_QUEUE_SIZE, DEVICE_SIZE, NULL), "async init");
+        W25Qxx_ASYNC_SetSuspendLimit(&async.handle, limit);
+
+        bool eraseDone = false;
+        bool readDone = false;
+        const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x200000U, 64U * KB, NULL, AsyncDone, &eraseDone};
+        const W25QxxAsyncRequest_t read = {W25QXX_ASYNC_READ, 0x300000U, out.size(), out.data(), AsyncDone, &readDone};
+
+        const uint64_t suspends = dev.sim.stats.suspends;
+        const uint64_t start = dev.sim.nowNs;
+        Check(W25Qxx_ASYNC_Submit(&async.handle, &erase), "submit erase");
+
+        /* Read arrives once the erase is running */
+        for (int i = 0; i < 10; i++)
+        {
+            AsyncStep(async);
+        }
+
+        const uint64_t submitted = dev.sim.nowNs;
+        Check(W25Qxx_ASYNC_Submit(&async.handle, &read), "submit read");
+
+        uint64_t readNs = 0U;
+        uint64_t eraseNs = 0U;
+        while (W25Qxx_ASYNC_IsBusy(&async.handle))
+        {
+            AsyncStep(async);
+            if (readDone && (readNs == 0U))
+            {
+                readNs = dev.sim.nowNs - submitted;
+            }
+            if (eraseDone && (eraseNs == 0U))
+            {
+                eraseNs = dev.sim.nowNs - start;
+            }
+        }
+
+        Check(0 == memcmp(out.data(), &dev.memory[0x300000U], out.size()), "async read data");
+        std::printf("suspend limit %-10zu %17.3f %9.1f %9llu\n",
+            limit, Ms(readNs), Ms(eraseNs), (unsigned long long)(dev.sim.stats.suspends - suspends));
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    std::cout << "bench_w25qxx v0.1" << std::endl;
+
+    argparse::ArgumentParser parser("bench_w25qxx v0.1");
+    AddArguments(parser);
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    const bool quick = parser.get<bool>("--quick");
+    const size_t size = quick ? (64U * KB) : parser.get<size_t>("--size");
+
+    if ((size == 0U) || (size > (DEVICE_SIZE / 2U)) || ((size % (4U * KB)) != 0U))
+    {
+        std::cerr << "Size must be a multiple of 4 KB up to " << (DEVICE_SIZE / 2U) << std::endl;
+        return 1;
+    }
+
+    for (const Interface& iface: f_interfaces)
+    {
+        std::unique_ptr<Device> dev = CreateDevice(iface);
+        if (!dev)
+        {
+            std::cerr << "Device init failed on " << iface.name << std::endl;
+            return 1;
+        }
+
+        std::printf("\nSimulated W25Q128JV, %u MHz %s\n",
+            (unsigned)(dev->sim.timing.clockHz / 1000000U), iface.name);
+
+        /* Erase and the async port do not depend on the driver bus */
+        if (&iface == &f_interfaces[0])
+        {
+            BenchErase(*dev, size);
+            BenchAsync(*dev);
+        }
+        BenchRead(*dev, size);
+        BenchVerify(*dev, size);
+
+        std::printf("\n%llu commands, %llu status polls, %llu protocol violations\n",
+            (unsigned long long)dev->sim.stats.commands,
+            (unsigned long long)dev->sim.stats.statusPolls,
+            (unsigned long long)dev->sim.stats.violations);
+
+        Check(dev->sim.stats.violations == 0U, "no protocol violations");
+    }
+
+    if (f_errors > 0U)
+    {
+        std::cout << f_errors << " errors" << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
+
+/* EoF bench_w25qxx.cpp */
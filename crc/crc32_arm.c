@@ -0,0 +1,132 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * crc32_arm.c
+ *
+ * @brief CRC32 kernel using ARMv8 CRC32 instructions
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "crc/crc32_kernels.h"
+
+#include <string.h>
+
+#if !defined CRC32_NO_HW_KERNELS && defined __ARM_FEATURE_CRC32
+/* Instructions enabled for the whole build (-march=armv8-a+crc or newer) */
+#define CRC32_ARMV8_KERNEL
+#define TARGET_CRC
+#include <arm_acle.h>
+#elif !defined CRC32_NO_HW_KERNELS && defined __aarch64__ && defined __linux__
+/* Instructions enabled per function and detected at runtime */
+#define CRC32_ARMV8_KERNEL
+#define CRC32_ARMV8_RUNTIME_DETECT
+#if defined __clang__
+#define TARGET_CRC __attribute__((target("crc")))
+#else
+#define TARGET_CRC __attribute__((target("+crc")))
+#endif
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1UL << 7U)
+#endif
+#endif
+
+#ifdef CRC32_ARMV8_KERNEL
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static TARGET_CRC uint32_t Armv8Crc(uint32_t crc, const uint8_t* data, size_t len)
+{
+    /* Align to 8 bytes for the double word loop */
+    while ((len > 0U) && (0U != ((uintptr_t)data & 7U)))
+    {
+        crc = __crc32b(crc, *data++);
+        len--;
+    }
+
+    while (len >= 32U)
+    {
+        uint64_t w[4];
+        memcpy(w, data, sizeof(w));
+        crc = __crc32d(crc, w[0]);
+        crc = __crc32d(crc, w[1]);
+        crc = __crc32d(crc, w[2]);
+        crc = __crc32d(crc, w[3]);
+        data += 32U;
+        len -= 32U;
+    }
+
+    while (len >= 8U)
+    {
+        uint64_t w;
+        memcpy(&w, data, sizeof(w));
+        crc = __crc32d(crc, w);
+        data += 8U;
+        len -= 8U;
+    }
+
+    while (len > 0U)
+    {
+        crc = __crc32b(crc, *data++);
+        len--;
+    }
+
+    return crc;
+}
+
+#endif /* CRC32_ARMV8_KERNEL */
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool CRC32_HasArmv8(void)
+{
+#if defined CRC32_ARMV8_RUNTIME_DETECT
+    return 0U != (getauxval(AT_HWCAP) & HWCAP_CRC32);
+#elif defined CRC32_ARMV8_KERNEL
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t CRC32_KernelArmv8(uint32_t crc, const uint8_t* data, size_t len)
+{
+#ifdef CRC32_ARMV8_KERNEL
+    if (CRC32_HasArmv8())
+    {
+        return Armv8Crc(crc, data, len);
+    }
+#endif
+    return CRC32_KernelTable(crc, data, len);
+}
+
+/* EoF crc32_arm.c */
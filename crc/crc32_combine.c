@@ -0,0 +1,126 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * crc32_combine.c
+ *
+ * @brief Combine CRC32 values of consecutive data blocks
+ * 
+ * CRC(A|B) = CRC(A) * x^(8*len(B)) mod P(x) + CRC(B). The power of x is built
+ * from precalculated x^(2^n) mod P(x) values so that combining costs
+ * O(log(len(B))) polynomial multiplications instead of rereading the data.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "crc/crc32.h"
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define CRC32_POLY      (0xEDB88320U)
+#define X_POW_0         (0x80000000U)   /* x^0 in reflected representation */
+#define BYTE_BITS_LOG2  (3U)            /* Lengths are in bytes, 2^3 bits */
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+/* f_x2nTable[n] = x^(2^n) mod P(x) */
+static const uint32_t f_x2nTable[32] = {
+    0x40000000U, 0x20000000U, 0x08000000U, 0x00800000U, 0x00008000U, 0xEDB88320U,
+    0xB1E6B092U, 0xA06A2517U, 0xED627DAEU, 0x88D14467U, 0xD7BBFE6AU, 0xEC447F11U,
+    0x8E7EA170U, 0x6427800EU, 0x4D47BAE0U, 0x09FE548FU, 0x83852D0FU, 0x30362F1AU,
+    0x7B5A9CC3U, 0x31FEC169U, 0x9FEC022AU, 0x6C8DEDC4U, 0x15D6874DU, 0x5FDE7A4EU,
+    0xBAD90E37U, 0x2E4E5EEFU, 0x4EABA214U, 0xA8A472C0U, 0x429A969EU, 0x148D302AU,
+    0xC40BA6D0U, 0xC4E22C3CU
+};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/* a * b mod P(x), a must be non-zero */
+static uint32_t MultModP(uint32_t a, uint32_t b)
+{
+    uint32_t m = X_POW_0;
+    uint32_t p = 0U;
+
+    for (;;)
+    {
+        if (0U != (a & m))
+        {
+            p ^= b;
+            if (0U == (a & (m - 1U)))
+            {
+                break;
+            }
+        }
+        m >>= 1U;
+        b = (0U != (b & 1U)) ? ((b >> 1U) ^ CRC32_POLY) : (b >> 1U);
+    }
+
+    return p;
+}
+
+/* x^(n * 2^k) mod P(x) */
+static uint32_t X2nModP(size_t n, uint32_t k)
+{
+    uint32_t p = X_POW_0;
+
+    while (0U != n)
+    {
+        if (0U != (n & 1U))
+        {
+            p = MultModP(f_x2nTable[k & 31U], p);
+        }
+        n >>= 1U;
+        k++;
+    }
+
+    return p;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+uint32_t CRC32_Combine(uint32_t crcA, uint32_t crcB, size_t lenB)
+{
+    return CRC32_CombineOp(crcA, crcB, CRC32_CombineGen(lenB));
+}
+
+uint32_t CRC32_CombineGen(size_t lenB)
+{
+    return X2nModP(lenB, BYTE_BITS_LOG2);
+}
+
+uint32_t CRC32_CombineOp(uint32_t crcA, uint32_t crcB, uint32_t op)
+{
+    return MultModP(op, crcA) ^ crcB;
+}
+
+/* EoF crc32_combine.c */
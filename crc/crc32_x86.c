@@ -0,0 +1,170 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * crc32_x86.c
+ *
+ * @brief CRC32 kernel using x86 carry-less multiplication (PCLMULQDQ)
+ * 
+ * Folds 64 bytes per iteration as described in Intel white paper "Fast CRC
+ * Computation for Generic Polynomials Using PCLMULQDQ Instruction" and
+ * reduces the result with Barrett reduction.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "crc/crc32_kernels.h"
+
+#if !defined CRC32_NO_HW_KERNELS && \
+    (defined __x86_64__ || defined __i386__) && \
+    (defined __GNUC__ || defined __clang__)
+#define CRC32_PCLMUL_KERNEL
+#include <immintrin.h>
+#endif
+
+#ifdef CRC32_PCLMUL_KERNEL
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define TARGET_PCLMUL __attribute__((target("pclmul,sse4.1")))
+
+/* Folding needs one full 64 byte block, shorter input goes to the table */
+#define MIN_FOLD_LENGTH (64U)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+/* Bit-reflected folding constants x^(4*128+32), x^(4*128-32), ... mod P(x) */
+static const uint64_t f_k1k2[2] __attribute__((aligned(16))) = {0x0154442BD4U, 0x01C6E41596U};
+static const uint64_t f_k3k4[2] __attribute__((aligned(16))) = {0x01751997D0U, 0x00CCAA009EU};
+static const uint64_t f_k5k0[2] __attribute__((aligned(16))) = {0x0163CD6124U, 0x0000000000U};
+static const uint64_t f_poly[2] __attribute__((aligned(16))) = {0x01DB710641U, 0x01F7011641U};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static inline TARGET_PCLMUL __m128i Fold(__m128i acc, __m128i k, __m128i data)
+{
+    const __m128i lo = _mm_clmulepi64_si128(acc, k, 0x00);
+    const __m128i hi = _mm_clmulepi64_si128(acc, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(hi, lo), data);
+}
+
+/* Process len bytes, len must be a multiple of 16 and at least 64 */
+static TARGET_PCLMUL uint32_t FoldBlocks(uint32_t crc, const uint8_t* data, size_t len)
+{
+    const __m128i* p = (const __m128i*)data;
+
+    __m128i x1 = _mm_loadu_si128(&p[0]);
+    __m128i x2 = _mm_loadu_si128(&p[1]);
+    __m128i x3 = _mm_loadu_si128(&p[2]);
+    __m128i x4 = _mm_loadu_si128(&p[3]);
+    __m128i k = _mm_load_si128((const __m128i*)f_k1k2);
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+    p += 4U;
+    len -= 64U;
+
+    /* Fold four lanes in parallel */
+    while (len >= 64U)
+    {
+        x1 = Fold(x1, k, _mm_loadu_si128(&p[0]));
+        x2 = Fold(x2, k, _mm_loadu_si128(&p[1]));
+        x3 = Fold(x3, k, _mm_loadu_si128(&p[2]));
+        x4 = Fold(x4, k, _mm_loadu_si128(&p[3]));
+        p += 4U;
+        len -= 64U;
+    }
+
+    /* Fold lanes into one 128-bit value */
+    k = _mm_load_si128((const __m128i*)f_k3k4);
+    x1 = Fold(x1, k, x2);
+    x1 = Fold(x1, k, x3);
+    x1 = Fold(x1, k, x4);
+
+    /* Remaining 16 byte blocks */
+    while (len >= 16U)
+    {
+        x1 = Fold(x1, k, _mm_loadu_si128(p));
+        p++;
+        len -= 16U;
+    }
+
+    /* Fold 128 bits to 64 bits */
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+    k = _mm_loadl_epi64((const __m128i*)f_k5k0);
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, mask32);
+    x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    /* Barrett reduction to 32 bits */
+    k = _mm_load_si128((const __m128i*)f_poly);
+    x2 = _mm_and_si128(x1, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+    x2 = _mm_and_si128(x2, mask32);
+    x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+#endif /* CRC32_PCLMUL_KERNEL */
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool CRC32_HasPclmul(void)
+{
+#ifdef CRC32_PCLMUL_KERNEL
+    return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+uint32_t CRC32_KernelPclmul(uint32_t crc, const uint8_t* data, size_t len)
+{
+#ifdef CRC32_PCLMUL_KERNEL
+    if ((len >= MIN_FOLD_LENGTH) && CRC32_HasPclmul())
+    {
+        const size_t foldLen = len & ~(size_t)15U;
+        crc = FoldBlocks(crc, data, foldLen);
+        data += foldLen;
+        len -= foldLen;
+    }
+#endif
+    return CRC32_KernelTable(crc, data, len);
+}
+
+/* EoF crc32_x86.c */
@@ -0,0 +1,250 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * crc.hpp
+ *
+ * @brief Header-only CRC engine with compile time lookup tables
+ * 
+ * Parameters follow the Rocksoft model: width, normal (MSB first) form of the
+ * polynomial, initial value, reflection and final XOR. Width must be a
+ * multiple of 8. Runtime calculation uses slice-by-N tables, which are
+ * generated by the compiler so there is no startup initialization. All
+ * functions are constexpr and usable in constant expressions.
+*/
+
+#ifndef CRC_H_
+#define CRC_H_
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+namespace Crc {
+
+template <
+    typename T,         /* Unsigned register type, at least Width bits */
+    size_t Width,       /* CRC width in bits */
+    T Poly,             /* Polynomial in normal form, e.g. 0x04C11DB7 */
+    T Init,             /* Initial register value (unreflected) */
+    bool Reflected,     /* Reflect input bytes and output (RefIn = RefOut) */
+    T XorOut,           /* Final XOR value */
+    size_t Slices = 8U  /* Lookup tables / bytes processed per iteration */
+>
+class Engine
+{
+    static_assert((Width >= 8U) && ((Width % 8U) == 0U), "Width must be a multiple of 8");
+    static_assert(Width <= (8U * sizeof(T)), "Register type too small for width");
+    static_assert(Slices >= 1U, "At least one table is required");
+
+public:
+    using Value = T;
+    using Table = std::array<std::array<T, 256U>, Slices>;
+
+    static constexpr T MASK = (Width == (8U * sizeof(T))) ? T(~T(0)) : T((T(1) << Width) - 1U);
+
+    /** Calculate CRC of data
+     * 
+     * @param data Data buffer (any byte sized type)
+     * @param len  Data buffer length
+     * @return CRC of data
+     */
+    template <typename Byte>
+    static constexpr T Calculate(const Byte* data, size_t len)
+    {
+        return Finalize(Process(INIT_REGISTER, data, len));
+    }
+
+    static constexpr T Calculate(std::string_view str)
+    {
+        return Calculate(str.data(), str.size());
+    }
+
+    /** Continue CRC calculation
+     * 
+     * @param crc  CRC of the preceding data, Calculate() of no data at start
+     * @param data Data buffer (any byte sized type)
+     * @param len  Data buffer length
+     * @return CRC of preceding data and data
+     */
+    template <typename Byte>
+    static constexpr T Update(T crc, const Byte* data, size_t len)
+    {
+        return Finalize(Process((crc ^ XorOut) & MASK, data, len));
+    }
+
+private:
+    static constexpr size_t TOP_SHIFT = Width - 8U;
+
+    static constexpr T Reflect(T val, size_t bits)
+    {
+        T out = 0U;
+        for (size_t i = 0U; i < bits; i++)
+        {
+            out = T(out << 1U) | T(val & 1U);
+            val >>= 1U;
+        }
+        return out;
+    }
+
+    static constexpr T REFLECTED_POLY = Reflect(Poly & MASK, Width);
+    static constexpr T INIT_REGISTER = Reflected ? Reflect(Init & MASK, Width) : T(Init & MASK);
+
+    static constexpr T ByteStep(T crc)
+    {
+        for (size_t bit = 0U; bit < 8U; bit++)
+        {
+            if (Reflected)
+            {
+                crc = (crc & 1U) ? T((crc >> 1U) ^ REFLECTED_POLY) : T(crc >> 1U);
+            }
+            else
+            {
+                const bool top = 0U != (crc & (T(1) << (Width - 1U)));
+                crc = top ? T((crc << 1U) ^ Poly) : T(crc << 1U);
+            }
+        }
+        return crc & MASK;
+    }
+
+    static constexpr T ShiftByte(T crc)
+    {
+        return Reflected ? T(crc >> 8U) : T((crc << 8U) & MASK);
+    }
+
+    static constexpr uint8_t RegisterByte(T crc, size_t n)
+    {
+        return Reflected 
+            ? uint8_t(crc >> (8U * n)) 
+            : uint8_t(crc >> (TOP_SHIFT - (8U * n)));
+    }
+
+    static constexpr Table MakeTable()
+    {
+        Table t{};
+
+        for (size_t i = 0U; i < 256U; i++)
+        {
+            t[0][i] = ByteStep(Reflected ? T(i) : T(T(i) << TOP_SHIFT));
+        }
+
+        for (size_t k = 1U; k < Slices; k++)
+        {
+            for (size_t i = 0U; i < 256U; i++)
+            {
+                const T prev = t[k - 1U][i];
+                t[k][i] = ShiftByte(prev) ^ t[0][RegisterByte(prev, 0U)];
+            }
+        }
+
+        return t;
+    }
+
+    static constexpr T Finalize(T crc)
+    {
+        return (crc ^ XorOut) & MASK;
+    }
+
+    template <typename Byte>
+    static constexpr T Process(T crc, const Byte* data, size_t len)
+    {
+        static_assert(sizeof(Byte) == 1U, "Data must be byte sized");
+
+        constexpr size_t regBytes = Width / 8U;
+
+        while (len >= Slices)
+        {
+            T next = 0U;
+            for (size_t j = 0U; j < Slices; j++)
+            {
+                uint8_t byte = uint8_t(data[j]);
+                if (j < regBytes)
+                {
+                    byte ^= RegisterByte(crc, j);
+                }
+                next ^= TABLE[Slices - 1U - j][byte];
+            }
+
+            /* Register bytes not consumed by this block */
+            if (Slices < regBytes)
+            {
+                for (size_t j = 0U; j < Slices; j++)
+                {
+                    crc = ShiftByte(crc);
+                }
+                next ^= crc;
+            }
+            crc = next;
+
+            data += Slices;
+            len -= Slices;
+        }
+
+        while (len > 0U)
+        {
+            const uint8_t byte = uint8_t(data[0]) ^ RegisterByte(crc, 0U);
+            crc = ShiftByte(crc) ^ TABLE[0][byte];
+            data++;
+            len--;
+        }
+
+        return crc;
+    }
+
+public:
+    /* Lookup tables, TABLE[0] is the classic byte-wise table */
+    static constexpr Table TABLE = MakeTable();
+};
+
+/* CRC-32 (ISO-HDLC), same as CRC32_Calculate() */
+using Crc32 = Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, true, 0xFFFFFFFFU>;
+
+/* CRC-32C (Castagnoli) */
+using Crc32C = Engine<uint32_t, 32U, 0x1EDC6F41U, 0xFFFFFFFFU, true, 0xFFFFFFFFU>;
+
+/* CRC-32/MPEG-2, typical MCU CRC peripheral default */
+using Crc32Mpeg2 = Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, false, 0x00000000U>;
+
+/* CRC-16/CCITT-FALSE */
+using Crc16Ccitt = Engine<uint16_t, 16U, 0x1021U, 0xFFFFU, false, 0x0000U>;
+
+/* CRC-8/SMBUS */
+using Crc8 = Engine<uint8_t, 8U, 0x07U, 0x00U, false, 0x00U>;
+
+/* CRC-64/XZ */
+using Crc64 = Engine<uint64_t, 64U, 0x42F0E1EBA9EA3693U, 0xFFFFFFFFFFFFFFFFU, true, 0xFFFFFFFFFFFFFFFFU>;
+
+}
+
+/* EoF crc.hpp */
+
+#endif /* CRC_H_ */
@@ -24,7 +24,7 @@
  *
  * crc32.h
  *
- * @brief Reference CRC32 implementation
+ * @brief CRC32 engine with software and CPU specific kernels
 */
 
 #ifndef CRC32_H_
@@ -41,6 +41,19 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+/** CRC32 kernel processing raw CRC register
+ * 
+ * @param crc  Current CRC register (reflected, no final XOR applied)
+ * @param data Data buffer
+ * @param len  Data buffer length
+ * @return Updated CRC register
+ */
+typedef uint32_t (*Crc32Kernel_t)(uint32_t crc, const uint8_t* data, size_t len);
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
@@ -53,6 +66,58 @@ extern "C" {
  */
 extern uint32_t CRC32_Calculate(const uint8_t* data, size_t len);
 
+/** Continue CRC32 calculation with more data
+ * 
+ * @param crc  CRC32 of the preceding data (0 for first call)
+ * @param data Data buffer
+ * @param len  Data buffer length
+ * @return CRC32 of preceding data and data
+ * 
+ * @note CRC32_Update(CRC32_Update(0, a, n), b, m) equals CRC32 of a|b
+ */
+extern uint32_t CRC32_Update(uint32_t crc, const uint8_t* data, size_t len);
+
+/** Combine CRC32 values of two consecutive blocks A and B
+ * 
+ * @param crcA CRC32 of block A
+ * @param crcB CRC32 of block B
+ * @param lenB Length of block B
+ * @return CRC32 of A|B
+ */
+extern uint32_t CRC32_Combine(uint32_t crcA, uint32_t crcB, size_t lenB);
+
+/** Generate combine operator for blocks of length lenB
+ * 
+ * @param lenB Length of block B
+ * @return Operator for CRC32_CombineOp()
+ * 
+ * @note Saves work when many blocks of equal length are combined
+ */
+extern uint32_t CRC32_CombineGen(size_t lenB);
+
+/** Combine CRC32 values using an operator from CRC32_CombineGen()
+ * 
+ * @param crcA CRC32 of block A
+ * @param crcB CRC32 of block B
+ * @param op   CRC32_CombineGen(len(B))
+ * @return CRC32 of A|B
+ */
+extern uint32_t CRC32_CombineOp(uint32_t crcA, uint32_t crcB, uint32_t op);
+
+/** Install a custom kernel, e.g. driver for MCU CRC peripheral
+ * 
+ * @param kernel Kernel function or NULL to restore automatic selection
+ * 
+ * @note Call during init before any concurrent CRC32 use
+ */
+extern void CRC32_SetKernel(Crc32Kernel_t kernel);
+
+/** Get name of the kernel used for the next calculation
+ * 
+ * @return "custom", "pclmul", "armv8" or "table"
+ */
+extern const char* CRC32_GetKernelName(void);
+
 #ifdef __cplusplus
 } /* extern C */
 #endif
@@ -1,6 +1,6 @@
 /* MIT License
  * 
- * Copyright (c) 2025 Mikael Penttinen
+ * Copyright (c) 2026 Mikael Penttinen
  * 
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -22,41 +22,55 @@
  *
  * -----------------------------------------------------------------------------
  *
- * crc32.hpp
+ * crc32_kernels.h
  *
- * @brief Quick CRC32 function
+ * @brief CRC32 kernels behind the CRC32 engine dispatch
 */
 
-#ifndef CRC32_H_
-#define CRC32_H_
+#ifndef CRC32_KERNELS_H_
+#define CRC32_KERNELS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /*----------------------------------------------------------------------------*/
 /* INCLUDE DIRECTIVES                                                         */
 /*----------------------------------------------------------------------------*/
 
-#include <cstdint>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
 
-static inline uint32_t InlineCrc32(const uint8_t* data, size_t size)
-{
-  uint32_t r = ~0; const uint8_t *end = data + size;
- 
-  while(data < end)
-  {
-    r ^= *data++;
- 
-    for(int i = 0; i < 8; i++)
-    {
-      uint32_t t = ~((r&1) - 1); r = (r>>1) ^ (0xEDB88320 & t);
-    }
-  }
- 
-  return ~r;
-}
-
-/* EoF crc32.hpp */
-
-#endif /* CRC32_H_ */
+/* All kernels match Crc32Kernel_t and produce identical results. Kernels that
+ * are not supported by the running CPU fall back to CRC32_KernelTable. */
+
+/** Reference kernel, one bit at a time */
+extern uint32_t CRC32_KernelBitwise(uint32_t crc, const uint8_t* data, size_t len);
+
+/** Byte-wise lookup table kernel */
+extern uint32_t CRC32_KernelTable(uint32_t crc, const uint8_t* data, size_t len);
+
+/** x86 carry-less multiply folding kernel (PCLMULQDQ + SSE4.1) */
+extern uint32_t CRC32_KernelPclmul(uint32_t crc, const uint8_t* data, size_t len);
+
+/** ARMv8 CRC32 instruction kernel */
+extern uint32_t CRC32_KernelArmv8(uint32_t crc, const uint8_t* data, size_t len);
+
+/** @return CRC32_KernelPclmul is built and supported by the CPU */
+extern bool CRC32_HasPclmul(void);
+
+/** @return CRC32_KernelArmv8 is built and supported by the CPU */
+extern bool CRC32_HasArmv8(void);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF crc32_kernels.h */
+
+#endif /* CRC32_KERNELS_H_ */
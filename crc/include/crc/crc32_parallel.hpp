@@ -0,0 +1,124 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * crc32_parallel.hpp
+ *
+ * @brief Multi-threaded CRC32 for large host side images
+*/
+
+#ifndef CRC32_PARALLEL_H_
+#define CRC32_PARALLEL_H_
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "crc/crc32.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+namespace Crc32 {
+
+/* Smaller chunks are not worth a thread */
+constexpr size_t PARALLEL_MIN_CHUNK = 1024U * 1024U;
+
+/** Calculate CRC32 by splitting data across threads
+ * 
+ * @param data    Data buffer
+ * @param len     Data buffer length
+ * @param threads Maximum thread count, 0 for hardware concurrency
+ * @return CRC32 of data, equal to CRC32_Calculate(data, len)
+ */
+inline uint32_t CalculateParallel(const uint8_t* data, size_t len, size_t threads = 0U)
+{
+    if (0U == threads)
+    {
+        threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    threads = std::min(threads, len / PARALLEL_MIN_CHUNK);
+
+    if (threads <= 1U)
+    {
+        return CRC32_Calculate(data, len);
+    }
+
+    const size_t chunk = len / threads;
+    const size_t lastChunk = len - ((threads - 1U) * chunk);
+
+    std::vector<uint32_t> crcs(threads);
+    std::vector<std::thread> workers;
+
+    try
+    {
+        for (size_t i = 1U; i < threads; i++)
+        {
+            const size_t size = (i == (threads - 1U)) ? lastChunk : chunk;
+            workers.emplace_back([&crcs, data, chunk, size, i]() {
+                crcs[i] = CRC32_Calculate(&data[i * chunk], size);
+            });
+        }
+    }
+    catch (const std::system_error&)
+    {
+        /* Out of threads, finish the started ones and go sequential */
+        for (auto& worker: workers)
+        {
+            worker.join();
+        }
+        return CRC32_Calculate(data, len);
+    }
+
+    crcs[0] = CRC32_Calculate(data, chunk);
+
+    for (auto& worker: workers)
+    {
+        worker.join();
+    }
+
+    const uint32_t op = CRC32_CombineGen(chunk);
+    uint32_t crc = crcs[0];
+
+    for (size_t i = 1U; i < (threads - 1U); i++)
+    {
+        crc = CRC32_CombineOp(crc, crcs[i], op);
+    }
+
+    return CRC32_Combine(crc, crcs[threads - 1U], lastChunk);
+}
+
+}
+
+/* EoF crc32_parallel.hpp */
+
+#endif /* CRC32_PARALLEL_H_ */
@@ -122,4 +122,44 @@ int ed25519_multipart_end(ed25519_multipart_t* ctx)
     return 1;
 }
 
+int ed25519_precompute_key(ed25519_precomputed_key_t* key, const unsigned char *public_key)
+{
+    if (ge_frombytes_negate_vartime(&key->A, public_key) != 0) {
+        return 0;
+    }
+
+    memcpy(key->public_key, public_key, 32U);
+
+    return 1;
+}
+
+int ed25519_multipart_init_precomputed(ed25519_multipart_t* ctx, const unsigned char *signature, const ed25519_precomputed_key_t* key)
+{
+    if (signature[63] & 224) {
+        return 0;
+    }
+
+    memcpy(&ctx->A, &key->A, sizeof(ge_p3));
+    memcpy(ctx->signature, signature, 64U);
+
+    sha512_init(&ctx->hash);
+    sha512_update(&ctx->hash, signature, 32);
+    sha512_update(&ctx->hash, key->public_key, 32);
+
+    return 1;
+}
+
+int ed25519_verify_precomputed(const unsigned char *signature, const unsigned char *message, size_t message_len, const ed25519_precomputed_key_t* key)
+{
+    ed25519_multipart_t ctx;
+
+    if (!ed25519_multipart_init_precomputed(&ctx, signature, key)) {
+        return 0;
+    }
+
+    ed25519_multipart_continue(&ctx, message, message_len);
+
+    return ed25519_multipart_end(&ctx);
+}
+
 /* EoF ed25519_extra.c */
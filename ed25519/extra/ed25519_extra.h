@@ -47,6 +47,14 @@ typedef struct
     sha512_context hash;
 } ed25519_multipart_t;
 
+/* Public key with the decoded (negated) curve point, skips point
+   decompression on every verification */
+typedef struct
+{
+    unsigned char public_key[32];
+    ge_p3 A;
+} ed25519_precomputed_key_t;
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
@@ -55,6 +63,10 @@ extern int ed25519_multipart_init(ed25519_multipart_t* ctx, const unsigned char
 extern int ed25519_multipart_continue(ed25519_multipart_t* ctx, const unsigned char *message, size_t message_len);
 extern int ed25519_multipart_end(ed25519_multipart_t* ctx);
 
+extern int ed25519_precompute_key(ed25519_precomputed_key_t* key, const unsigned char *public_key);
+extern int ed25519_multipart_init_precomputed(ed25519_multipart_t* ctx, const unsigned char *signature, const ed25519_precomputed_key_t* key);
+extern int ed25519_verify_precomputed(const unsigned char *signature, const unsigned char *message, size_t message_len, const ed25519_precomputed_key_t* key);
+
 #ifdef __cplusplus
 } /* extern C */
 #endif
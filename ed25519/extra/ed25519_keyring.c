@@ -0,0 +1,134 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * ed25519_keyring.c
+ *
+ * @brief Key ID indexed set of trusted ed25519 public keys
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "ed25519_keyring.h"
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static int has_collision(const ed25519_keyring_entry_t* keys, size_t count, size_t size)
+{
+    for (size_t i = 0U; i < count; i++) {
+        for (size_t j = i + 1U; j < count; j++) {
+            if ((keys[i].key_id % size) == (keys[j].key_id % size)) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+size_t ed25519_keyring_table_size(const ed25519_keyring_entry_t* keys, size_t count)
+{
+    if ((keys == NULL) || (count == 0U)) {
+        return 0U;
+    }
+
+    for (size_t i = 0U; i < count; i++) {
+        for (size_t j = i + 1U; j < count; j++) {
+            if (keys[i].key_id == keys[j].key_id) {
+                return 0U;
+            }
+        }
+    }
+
+    /* Ends at the latest when size exceeds the largest key ID */
+    for (size_t size = count; size != 0U; size++) {
+        if (!has_collision(keys, count, size)) {
+            return size;
+        }
+    }
+
+    return 0U;
+}
+
+int ed25519_keyring_build(ed25519_keyring_t* ring, ed25519_keyring_entry_t* table, size_t table_size, const ed25519_keyring_entry_t* keys, size_t count)
+{
+    if ((ring == NULL) || (table == NULL) || (table_size == 0U) || ((keys == NULL) && (count != 0U))) {
+        return 0;
+    }
+
+    memset(table, 0, table_size * sizeof(ed25519_keyring_entry_t));
+
+    for (size_t i = 0U; i < count; i++) {
+        ed25519_keyring_entry_t* entry = &table[keys[i].key_id % table_size];
+
+        if (entry->in_use) {
+            return 0;
+        }
+
+        *entry = keys[i];
+        entry->in_use = 1U;
+    }
+
+    ring->entries = table;
+    ring->size = table_size;
+
+    return 1;
+}
+
+const ed25519_precomputed_key_t* ed25519_keyring_find(const ed25519_keyring_t* ring, uint32_t key_id)
+{
+    if ((ring == NULL) || (ring->entries == NULL) || (ring->size == 0U)) {
+        return NULL;
+    }
+
+    const ed25519_keyring_entry_t* entry = &ring->entries[key_id % ring->size];
+
+    if (!entry->in_use || (entry->key_id != key_id)) {
+        return NULL;
+    }
+
+    return &entry->key;
+}
+
+int ed25519_keyring_verify(const ed25519_keyring_t* ring, uint32_t key_id, const unsigned char *signature, const unsigned char *message, size_t message_len)
+{
+    const ed25519_precomputed_key_t* key = ed25519_keyring_find(ring, key_id);
+
+    if (key == NULL) {
+        return 0;
+    }
+
+    return ed25519_verify_precomputed(signature, message, message_len, key);
+}
+
+/* EoF ed25519_keyring.c */
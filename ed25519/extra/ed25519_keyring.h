@@ -0,0 +1,112 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * ed25519_keyring.h
+ *
+ * @brief Key ID indexed set of trusted ed25519 public keys
+ * 
+ * Key ID is the CRC32 of the 32 byte public key. Keyrings are perfect hash
+ * tables built with ed25519_keyring_build, e.g. by generate_keyfile: entry
+ * for a key ID is always at index (key_id % size), so lookup is one modulo
+ * and one compare and every signature is checked with exactly one
+ * verification.
+*/
+
+#ifndef ED25519_KEYRING_H_
+#define ED25519_KEYRING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ed25519_extra.h"
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    uint32_t key_id;                    /* CRC32 of the public key */
+    uint32_t in_use;                    /* 0 for empty table slots */
+    ed25519_precomputed_key_t key;
+} ed25519_keyring_entry_t;
+
+typedef struct
+{
+    const ed25519_keyring_entry_t* entries;
+    size_t size;                        /* Table size, not key count */
+} ed25519_keyring_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Smallest table size where every key ID has its own index
+ * 
+ * @param keys Keys, only key_id is used
+ * @param count Number of keys
+ * @return Table size, 0 if there are no keys or key IDs are not unique
+ */
+extern size_t ed25519_keyring_table_size(const ed25519_keyring_entry_t* keys, size_t count);
+
+/** Place keys to their table index and point the keyring to the table
+ * 
+ * @param ring Keyring to initialize
+ * @param table Table storage, all entries are written
+ * @param table_size Entries in table, e.g. from ed25519_keyring_table_size
+ * @param keys Keys to place, in_use is set in the copies
+ * @param count Number of keys
+ * @return 1 on success, 0 if two keys share an index
+ */
+extern int ed25519_keyring_build(ed25519_keyring_t* ring, ed25519_keyring_entry_t* table, size_t table_size, const ed25519_keyring_entry_t* keys, size_t count);
+
+/** Find key by ID
+ * 
+ * @param ring Keyring
+ * @param key_id Key ID, e.g. Metadata_t keyId
+ * @return Key or NULL if the ID is not in the keyring
+ */
+extern const ed25519_precomputed_key_t* ed25519_keyring_find(const ed25519_keyring_t* ring, uint32_t key_id);
+
+/** Verify signature with the key of the given ID
+ * 
+ * @return 1 when the key exists and the signature is valid, 0 otherwise
+ */
+extern int ed25519_keyring_verify(const ed25519_keyring_t* ring, uint32_t key_id, const unsigned char *signature, const unsigned char *message, size_t message_len);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF ed25519_keyring.h */
+
+#endif /* ED25519_KEYRING_H_ */
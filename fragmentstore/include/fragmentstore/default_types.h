@@ -56,6 +56,7 @@ struct __attribute__((packed)) Metadata_s
     uint32_t    firmwareId;                 /* Unique ID for this firmware */
     uint32_t    startAddress;               /* Jump address of the firmware */
     uint32_t    firmwareSize;               /* Bytes following startAddress */
+    uint32_t    keyId;                      /* Signing key ID, CRC32 of public key */
     char        name[32];                   /* Firmware name string */
     uint8_t     firmwareSignature[64];      /* Firmware data signature */
     uint8_t     metadataSignature[64];      /* Metadata signature */
@@ -0,0 +1,126 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * region.h
+ *
+ * @brief Streaming checksums and digests over memory regions
+ * 
+ * Region is read through MemoryConfig_t Reader one caller provided chunk at a
+ * time, so no RAM copy of the whole region is required. Chunk size should
+ * match the efficient read size of the backend (e.g. flash page or DMA block).
+*/
+
+#ifndef REGION_H_
+#define REGION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "fragmentstore/fragmentstore.h"
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+/** Continue CRC32 calculation (e.g. CRC32_Update from libs::crc)
+ * 
+ * @param crc CRC32 of preceding data, 0 for new calculation
+ * @param data Data buffer
+ * @param len Data buffer length
+ * @return CRC32 of preceding data and data
+ */
+typedef uint32_t (*Crc32Update_t)(uint32_t crc, const uint8_t* data, size_t len);
+
+/** Consume one chunk of region data (e.g. wrapper for sha512_update)
+ * 
+ * @param ctx User context
+ * @param data Chunk data
+ * @param len Chunk length
+ * @return Continue streaming
+ */
+typedef bool (*RegionConsumer_t)(void* ctx, const uint8_t* data, size_t len);
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Stream memory region to consumer
+ * 
+ * @param memConf Memory configuration
+ * @param address Region start address
+ * @param size Region size
+ * @param chunk Work buffer
+ * @param chunkSize Work buffer size, maximum read size
+ * @param Consume Chunk consumer
+ * @param ctx Consumer context
+ * 
+ * @return true when whole region was read and consumed
+ * @return false on invalid parameters, region outside memory, read failure
+ *         or when consumer aborted
+ */
+extern bool REGION_Stream(
+    const MemoryConfig_t* memConf,
+    Address_t address,
+    size_t size,
+    uint8_t* chunk,
+    size_t chunkSize,
+    RegionConsumer_t Consume,
+    void* ctx
+);
+
+/** Calculate CRC32 of memory region
+ * 
+ * @param memConf Memory configuration
+ * @param address Region start address
+ * @param size Region size
+ * @param chunk Work buffer
+ * @param chunkSize Work buffer size, maximum read size
+ * @param Crc32Update CRC32 continuation function
+ * @param crc In: CRC32 to continue from, 0 for new calculation. 
+ *            Out: CRC32 including region.
+ * 
+ * @return true when successful
+ */
+extern bool REGION_Crc32(
+    const MemoryConfig_t* memConf,
+    Address_t address,
+    size_t size,
+    uint8_t* chunk,
+    size_t chunkSize,
+    Crc32Update_t Crc32Update,
+    uint32_t* crc
+);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF region.h */
+
+#endif /* REGION_H_ */
@@ -0,0 +1,109 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * wire.h
+ *
+ * @brief Compact transfer encoding of fragments
+ * 
+ * The wire form of a fragment is its header up to content, the used size
+ * bytes of content and the fields after content. The receiver rebuilds the
+ * canonical Fragment_t with zero padding, which is what the signature covers.
+ * A full sizeof(Fragment_t) buffer is accepted as is, so both forms can be
+ * received through the same service.
+*/
+
+#ifndef WIRE_H_
+#define WIRE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "fragmentstore/fragmentstore.h"
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Wire size of fragment
+ * 
+ * @return Encoded length, 0 if the fragment size exceeds content
+ */
+extern size_t WIRE_FragmentSize(const Fragment_t* fragment);
+
+/** Encode fragment in wire form
+ * 
+ * @param fragment Fragment
+ * @param out Output buffer
+ * @param maxLen Output buffer size
+ * @return Encoded length, 0 on invalid fragment or too small buffer
+ */
+extern size_t WIRE_EncodeFragment(
+    const Fragment_t* fragment,
+    uint8_t* out,
+    size_t maxLen
+);
+
+/** Decode wire form or full size fragment
+ * 
+ * @param data Received data, must not overlap fragment
+ * @param len Received length
+ * @param fragment Canonical fragment with zero padded content
+ * @return false if the length does not match the fragment size field
+ */
+extern bool WIRE_DecodeFragment(
+    const uint8_t* data,
+    size_t len,
+    Fragment_t* fragment
+);
+
+/** Decode wire form or full size fragment in its receive buffer
+ * 
+ * The fields after content are moved to their Fragment_t offset and the
+ * content padding is zeroed, so no second fragment sized buffer is needed.
+ * 
+ * @param data Received data aligned for Fragment_t, e.g. a transfer payload
+ *             placed with TRANSFER_InitAligned
+ * @param len Received length
+ * @param capacity Size of the data buffer, at least sizeof(Fragment_t)
+ * @return Canonical fragment in data, NULL if the length does not match the
+ *         fragment size field or the buffer is too small
+ */
+extern Fragment_t* WIRE_DecodeFragmentInPlace(
+    uint8_t* data,
+    size_t len,
+    size_t capacity
+);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF wire.h */
+
+#endif /* WIRE_H_ */
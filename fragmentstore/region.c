@@ -0,0 +1,163 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * region.c
+ *
+ * @brief Streaming checksums and digests over memory regions
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "fragmentstore/region.h"
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    Crc32Update_t   Update;
+    uint32_t        crc;
+} Crc32Context_t;
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) (ptr == NULL)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static bool IsInsideMemory(
+    const MemoryConfig_t* memConf,
+    Address_t address,
+    size_t size)
+{
+    if (address < memConf->baseAddress)
+    {
+        return false;
+    }
+
+    const size_t offset = (size_t)(address - memConf->baseAddress);
+
+    return (offset <= memConf->memorySize) &&
+           (size <= (memConf->memorySize - offset));
+}
+
+static bool ConsumeCrc32(void* ctx, const uint8_t* data, size_t len)
+{
+    Crc32Context_t* c = (Crc32Context_t*)ctx;
+    c->crc = c->Update(c->crc, data, len);
+    return true;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool REGION_Stream(
+    const MemoryConfig_t* memConf,
+    Address_t address,
+    size_t size,
+    uint8_t* chunk,
+    size_t chunkSize,
+    RegionConsumer_t Consume,
+    void* ctx
+)
+{
+    if (IS_NULL(memConf) ||
+        IS_NULL(memConf->Reader) ||
+        IS_NULL(chunk) ||
+        IS_NULL(Consume) ||
+        (chunkSize == 0U))
+    {
+        return false;
+    }
+
+    if (!IsInsideMemory(memConf, address, size))
+    {
+        return false;
+    }
+
+    while (size > 0U)
+    {
+        const size_t n = (size < chunkSize) ? size : chunkSize;
+
+        if (!memConf->Reader(address, n, chunk))
+        {
+            return false;
+        }
+
+        if (!Consume(ctx, chunk, n))
+        {
+            return false;
+        }
+
+        address += n;
+        size -= n;
+    }
+
+    return true;
+}
+
+bool REGION_Crc32(
+    const MemoryConfig_t* memConf,
+    Address_t address,
+    size_t size,
+    uint8_t* chunk,
+    size_t chunkSize,
+    Crc32Update_t Crc32Update,
+    uint32_t* crc
+)
+{
+    if (IS_NULL(Crc32Update) ||
+        IS_NULL(crc))
+    {
+        return false;
+    }
+
+    Crc32Context_t ctx = {
+        .Update = Crc32Update,
+        .crc = *crc
+    };
+
+    if (!REGION_Stream(memConf, address, size, chunk, chunkSize, &ConsumeCrc32, &ctx))
+    {
+        return false;
+    }
+
+    *crc = ctx.crc;
+
+    return true;
+}
+
+/* EoF region.c */
@@ -0,0 +1,159 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * wire.c
+ *
+ * @brief Compact transfer encoding of fragments
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "fragmentstore/wire.h"
+#include <stddef.h>
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) (ptr == NULL)
+
+#define HEADER_SIZE     (offsetof(Fragment_t, content))
+#define CONTENT_SIZE    (sizeof(((Fragment_t*)NULL)->content))
+#define TRAILER_OFFSET  (HEADER_SIZE + CONTENT_SIZE)
+#define TRAILER_SIZE    (sizeof(Fragment_t) - TRAILER_OFFSET)
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+size_t WIRE_FragmentSize(const Fragment_t* fragment)
+{
+    if (IS_NULL(fragment) || (fragment->size > CONTENT_SIZE))
+    {
+        return 0U;
+    }
+
+    return HEADER_SIZE + fragment->size + TRAILER_SIZE;
+}
+
+size_t WIRE_EncodeFragment(
+    const Fragment_t* fragment,
+    uint8_t* out,
+    size_t maxLen
+)
+{
+    const size_t len = WIRE_FragmentSize(fragment);
+
+    if ((len == 0U) || IS_NULL(out) || (maxLen < len))
+    {
+        return 0U;
+    }
+
+    const uint8_t* src = (const uint8_t*)fragment;
+
+    memcpy(out, src, HEADER_SIZE);
+    memcpy(&out[HEADER_SIZE], fragment->content, fragment->size);
+    memcpy(&out[HEADER_SIZE + fragment->size], &src[TRAILER_OFFSET], TRAILER_SIZE);
+
+    return len;
+}
+
+bool WIRE_DecodeFragment(
+    const uint8_t* data,
+    size_t len,
+    Fragment_t* fragment
+)
+{
+    if (IS_NULL(data) || IS_NULL(fragment) || (len < (HEADER_SIZE + TRAILER_SIZE)))
+    {
+        return false;
+    }
+
+    uint8_t* dst = (uint8_t*)fragment;
+
+    if (len == sizeof(Fragment_t))
+    {
+        memcpy(dst, data, len);
+        return fragment->size <= CONTENT_SIZE;
+    }
+
+    memset(dst, 0, sizeof(Fragment_t));
+    memcpy(dst, data, HEADER_SIZE);
+
+    const size_t size = fragment->size;
+
+    if ((size > CONTENT_SIZE) || (len != (HEADER_SIZE + size + TRAILER_SIZE)))
+    {
+        return false;
+    }
+
+    memcpy(fragment->content, &data[HEADER_SIZE], size);
+    memcpy(&dst[TRAILER_OFFSET], &data[HEADER_SIZE + size], TRAILER_SIZE);
+
+    return true;
+}
+
+Fragment_t* WIRE_DecodeFragmentInPlace(
+    uint8_t* data,
+    size_t len,
+    size_t capacity
+)
+{
+    if (IS_NULL(data) ||
+        (capacity < sizeof(Fragment_t)) ||
+        (len > capacity) ||
+        (len < (HEADER_SIZE + TRAILER_SIZE)))
+    {
+        return NULL;
+    }
+
+    Fragment_t* fragment = (Fragment_t*)data;
+    const size_t size = fragment->size;
+
+    if (size > CONTENT_SIZE)
+    {
+        return NULL;
+    }
+
+    if (len == sizeof(Fragment_t))
+    {
+        return fragment;
+    }
+
+    if (len != (HEADER_SIZE + size + TRAILER_SIZE))
+    {
+        return NULL;
+    }
+
+    /* Trailer moves up over the padding, ranges may overlap */
+    memmove(&data[TRAILER_OFFSET], &data[HEADER_SIZE + size], TRAILER_SIZE);
+    memset(&data[HEADER_SIZE + size], 0, CONTENT_SIZE - size);
+
+    return fragment;
+}
+
+/* EoF wire.c */
@@ -0,0 +1,955 @@
+/* MIT License
+ * 
+ * Copyright (c) 2025 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * fwinspect.cpp
+ *
+ * @brief Inspect fragment and command areas in a raw flash dump
+ * 
+ * The dump is memory mapped and accessed through the fragmentstore API with
+ * a read only MemoryConfig_t, so the layout is interpreted exactly as on the
+ * device. Fragment slots of each area are validated on a thread pool. The
+ * validators have no context argument, so the area under inspection is kept
+ * in f_inspect; areas are inspected one at a time and workers only read it.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "argparse/argparse.hpp"
+#include "keyfile/openSSH_key.hpp"
+
+extern "C" {
+#include "crc/crc32.h"
+#include "ed25519.h"
+#include "ed25519_keyring.h"
+#include "fragmentstore/command.h"
+#include "fragmentstore/fragmentstore.h"
+#include "sha512.h"
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+struct Dump
+{
+    const uint8_t* data;
+    size_t size;
+    Address_t base;
+#ifdef _WIN32
+    std::vector<uint8_t> storage;
+#endif
+};
+
+struct Region
+{
+    Address_t address;
+    size_t size;
+};
+
+struct Inspection
+{
+    FragmentArea_t area;
+    MemoryConfig_t memConf;
+    Metadata_t metadata;
+    FA_ReturnCode_t metadataResult;
+};
+
+struct Slot
+{
+    FA_ReturnCode_t result;
+    uint32_t firmwareId;
+    uint32_t number;
+    uint32_t startAddress;
+    uint32_t size;
+};
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define METADATA_MAGIC "_M_E_T_A_D_A_T_A"
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static Dump f_dump;
+static std::vector<ed25519_keyring_entry_t> f_keys;
+static std::vector<ed25519_keyring_entry_t> f_table;
+static ed25519_keyring_t f_keyring;
+static const Inspection* f_inspect;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static void AddArguments(argparse::ArgumentParser& parser)
+{
+    parser.add_argument("-i", "--input")
+        .help("Raw flash dump")
+        .required();
+
+    parser.add_argument("-b", "--base")
+        .help("Address of the first byte of the dump")
+        .default_value(std::string("0"));
+
+    parser.add_argument("-a", "--area")
+        .help("Fragment area as address:size, repeat for several areas")
+        .append();
+
+    parser.add_argument("-c", "--command")
+        .help("Command area as address:size");
+
+    parser.add_argument("-s", "--sector")
+        .help("Sector size")
+        .default_value(std::string("4096"));
+
+    parser.add_argument("-e", "--erase")
+        .help("Erase value of the memory")
+        .default_value(std::string("0xFF"));
+
+    parser.add_argument("-k", "--key")
+        .help("OpenSSH key file, repeat for several keys")
+        .append();
+
+    parser.add_argument("-p", "--public")
+        .help("Public key as 64 hex digits, repeat for several keys")
+        .append();
+
+    parser.add_argument("-j", "--jobs")
+        .help("Validation threads, 0 for hardware concurrency")
+        .default_value(size_t(0U))
+        .scan<'u', size_t>();
+
+    parser.add_argument("-v", "--verbose")
+        .help("List every non-empty fragment slot")
+        .flag();
+}
+
+static bool ParseNumber(const std::string& str, uint64_t& value)
+{
+    try
+    {
+        size_t pos = 0U;
+        value = std::stoull(str, &pos, 0);
+        return pos == str.size();
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+static bool ParseRegion(const std::string& str, Region& region)
+{
+    const size_t colon = str.find(':');
+    uint64_t address = 0U;
+    uint64_t size = 0U;
+
+    if ((colon == std::string::npos) ||
+        !ParseNumber(str.substr(0U, colon), address) ||
+        !ParseNumber(str.substr(colon + 1U), size))
+    {
+        return false;
+    }
+
+    region.address = (Address_t)address;
+    region.size = (size_t)size;
+
+    return (address == region.address) && (size != 0U);
+}
+
+static std::vector<std::string> GetList(const argparse::ArgumentParser& parser, const std::string& name)
+{
+    if (!parser.is_used(name))
+    {
+        return {};
+    }
+    return parser.get<std::vector<std::string>>(name);
+}
+
+static bool OpenDump(const std::string& path, Dump& dump)
+{
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good())
+    {
+        return false;
+    }
+    dump.storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    dump.data = dump.storage.data();
+    dump.size = dump.storage.size();
+    return true;
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    void* map = MAP_FAILED;
+
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0))
+    {
+        map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        return false;
+    }
+
+    /* Slots are mostly read once, in order per worker */
+    (void)madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    dump.data = (const uint8_t*)map;
+    dump.size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+static bool InDump(Address_t address, size_t size)
+{
+    return (address >= f_dump.base) &&
+           ((size_t)(address - f_dump.base) <= f_dump.size) &&
+           (size <= (f_dump.size - (size_t)(address - f_dump.base)));
+}
+
+static bool DumpReader(Address_t address, size_t size, uint8_t* out)
+{
+    if (!InDump(address, size))
+    {
+        return false;
+    }
+
+    memcpy(out, &f_dump.data[address - f_dump.base], size);
+    return true;
+}
+
+static bool DumpWriter(Address_t, size_t, const uint8_t*)
+{
+    return false;
+}
+
+static bool DumpEraser(Address_t, size_t)
+{
+    return false;
+}
+
+static void InitMemConf(MemoryConfig_t& memConf, const Region& region, size_t sectorSize, uint8_t eraseValue)
+{
+    memConf.baseAddress = region.address;
+    memConf.sectorSize = sectorSize;
+    memConf.memorySize = region.size;
+    memConf.eraseValue = eraseValue;
+    memConf.Reader = DumpReader;
+    memConf.Writer = DumpWriter;
+    memConf.Eraser = DumpEraser;
+}
+
+static bool HexToBytes(const std::string& hex, uint8_t* out, size_t size)
+{
+    if (hex.size() != (size * 2U))
+    {
+        return false;
+    }
+
+    for (size_t i = 0U; i < size; i++)
+    {
+        uint64_t val = 0U;
+        if (!ParseNumber("0x" + hex.substr(i * 2U, 2U), val))
+        {
+            return false;
+        }
+        out[i] = (uint8_t)val;
+    }
+
+    return true;
+}
+
+static bool AddKey(const uint8_t* publicKey)
+{
+    ed25519_keyring_entry_t entry = {};
+
+    if (1 != ed25519_precompute_key(&entry.key, publicKey))
+    {
+        return false;
+    }
+
+    entry.key_id = CRC32_Calculate(publicKey, 32U);
+    entry.in_use = 1U;
+    f_keys.push_back(entry);
+
+    std::printf("Key ID %08X\n", (unsigned)entry.key_id);
+    return true;
+}
+
+static bool LoadKeys(const argparse::ArgumentParser& parser)
+{
+    for (const std::string& path: GetList(parser, "--key"))
+    {
+        std::ifstream keyFile(path);
+
+        if (!keyFile.good())
+        {
+            std::cout << "Cannot open key file " << path << std::endl;
+            return false;
+        }
+
+        KeyPair keyPair(keyFile);
+
+        if (!AddKey(keyPair.GetPublicKey().data()))
+        {
+            std::cout << "Invalid key in " << path << std::endl;
+            return false;
+        }
+    }
+
+    for (const std::string& hex: GetList(parser, "--public"))
+    {
+        uint8_t publicKey[32];
+
+        if (!HexToBytes(hex, publicKey, sizeof(publicKey)) || !AddKey(publicKey))
+        {
+            std::cout << "Invalid public key " << hex << std::endl;
+            return false;
+        }
+    }
+
+    if (f_keys.empty())
+    {
+        return false;
+    }
+
+    std::set<uint32_t> keyIds;
+
+    for (const auto& k: f_keys)
+    {
+        if (!keyIds.insert(k.key_id).second)
+        {
+            std::printf("Duplicate key ID %08X\n", (unsigned)k.key_id);
+            return false;
+        }
+    }
+
+    /* Keyring lookup only checks entries[key_id % size] */
+    f_table.resize(ed25519_keyring_table_size(f_keys.data(), f_keys.size()));
+
+    return 1 == ed25519_keyring_build(&f_keyring, f_table.data(), f_table.size(), f_keys.data(), f_keys.size());
+}
+
+static bool VerifyMetadata(const Metadata_t* meta)
+{
+    const uint8_t* msg = (const uint8_t*)(meta);
+    const size_t msgLen = sizeof(Metadata_t) - sizeof(meta->metadataSignature);
+
+    return (0 == memcmp(meta->magic, METADATA_MAGIC, sizeof(meta->magic))) &&
+           (1 == ed25519_keyring_verify(&f_keyring, meta->keyId, meta->metadataSignature, msg, msgLen));
+}
+
+static bool VerifyFragmentSignature(const Fragment_t* frag, const uint8_t* msg, size_t msgLen)
+{
+    const Inspection* insp = f_inspect;
+
+    if (insp->metadataResult != FA_ERR_EMPTY)
+    {
+        return 1 == ed25519_keyring_verify(&f_keyring, insp->metadata.keyId, frag->signature, msg, msgLen);
+    }
+
+    /* No metadata to tell the key, any known key will do */
+    for (const ed25519_keyring_entry_t& entry: f_keys)
+    {
+        if (1 == ed25519_verify_precomputed(frag->signature, msg, msgLen, &entry.key))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool VerifyFragmentChain(const Fragment_t* frag, const uint8_t* msg, size_t msgLen)
+{
+    const Inspection* insp = f_inspect;
+    uint8_t hash[64];
+    sha512_context ctx;
+    sha512_init(&ctx);
+
+    if (0U == frag->number)
+    {
+        if (insp->metadataResult == FA_ERR_EMPTY)
+        {
+            return false;
+        }
+        sha512_update(&ctx, insp->metadata.metadataSignature, 64U);
+    }
+    else
+    {
+        /* Chain continues from the slot of the previous fragment number */
+        Fragment_t prev;
+        if (FA_ERR_OK != FA_ReadFragmentForce(&insp->area, frag->number - 1U, &prev))
+        {
+            return false;
+        }
+        sha512_update(&ctx, prev.sha512, 64U);
+    }
+
+    sha512_update(&ctx, msg, msgLen);
+    sha512_final(&ctx, hash);
+
+    return 0 == memcmp(hash, frag->sha512, 64U);
+}
+
+static bool VerifyFragment(const Fragment_t* frag)
+{
+    const uint8_t* msg = (const uint8_t*)(frag);
+    const size_t msgLen = sizeof(Fragment_t) - sizeof(frag->signature);
+
+    switch (frag->verifyMethod)
+    {
+    case 0U:
+        return VerifyFragmentSignature(frag, msg, msgLen);
+    case 1U:
+        return VerifyFragmentChain(frag, msg, msgLen);
+    default:
+        return false;
+    }
+}
+
+static std::string Name(const char* str, size_t maxLen)
+{
+    size_t len = 0U;
+    while ((len < maxLen) && (str[len] != '\0'))
+    {
+        len++;
+    }
+    return std::string(str, len);
+}
+
+static void PrintMetadata(const char* label, const Metadata_t& meta)
+{
+    std::printf("  %s: \"%s\" type %u version 0x%08X firmware ID %08X, %u bytes at 0x%08X, key ID %08X%s\n",
+        label,
+        Name(meta.name, sizeof(meta.name)).c_str(),
+        (unsigned)meta.type,
+        (unsigned)meta.version,
+        (unsigned)meta.firmwareId,
+        (unsigned)meta.firmwareSize,
+        (unsigned)meta.startAddress,
+        (unsigned)meta.keyId,
+        (ed25519_keyring_find(&f_keyring, meta.keyId) == NULL) ? " (unknown)" : "");
+}
+
+static const char* ResultName(FA_ReturnCode_t result)
+{
+    switch (result)
+    {
+    case FA_ERR_OK:
+        return "valid";
+    case FA_ERR_EMPTY:
+        return "empty";
+    case FA_ERR_INVALID:
+        return "INVALID";
+    case FA_ERR_BUSY:
+        return "READ ERROR";
+    default:
+        return "PARAM ERROR";
+    }
+}
+
+/* Print indices as compact ranges, e.g. "3-5, 9" */
+static void PrintRanges(const char* label, const std::vector<size_t>& indices)
+{
+    if (indices.empty())
+    {
+        return;
+    }
+
+    std::printf("  %s:", label);
+
+    for (size_t i = 0U; i < indices.size(); )
+    {
+        size_t j = i;
+        while (((j + 1U) < indices.size()) && (indices[j + 1U] == (indices[j] + 1U)))
+        {
+            j++;
+        }
+
+        std::printf("%s %zu", (i == 0U) ? "" : ",", indices[i]);
+        if (j > i)
+        {
+            std::printf("-%zu", indices[j]);
+        }
+        i = j + 1U;
+    }
+
+    std::printf("\n");
+}
+
+static void ValidateSlots(const FragmentArea_t* area, std::vector<Slot>& slots, size_t jobs)
+{
+    std::atomic<size_t> next(0U);
+
+    auto worker = [area, &slots, &next]() {
+        Fragment_t frag;
+
+        for (size_t i = next++; i < slots.size(); i = next++)
+        {
+            Slot& slot = slots[i];
+            slot.result = FA_ReadFragment(area, i, &frag);
+
+            if ((slot.result == FA_ERR_OK) || (slot.result == FA_ERR_INVALID))
+            {
+                slot.firmwareId = frag.firmwareId;
+                slot.number = frag.number;
+                slot.startAddress = frag.startAddress;
+                slot.size = frag.size;
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1U; i < jobs; i++)
+    {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& w: workers)
+    {
+        w.join();
+    }
+}
+
+/* Verify firmware signature over fragments 0..count-1 in slot order */
+static bool VerifyFirmware(const Inspection& insp, size_t count, std::string& reason)
+{
+    const Metadata_t& meta = insp.metadata;
+    const ed25519_precomputed_key_t* key = ed25519_keyring_find(&f_keyring, meta.keyId);
+
+    ed25519_multipart_t ctx;
+    if ((key == NULL) || (1 != ed25519_multipart_init_precomputed(&ctx, meta.firmwareSignature, key)))
+    {
+        reason = "no key";
+        return false;
+    }
+
+    Fragment_t frag;
+    uint64_t covered = 0U;
+    uint32_t nextStart = 0U;
+
+    for (size_t i = 0U; i < count; i++)
+    {
+        if (FA_ERR_OK != FA_ReadFragmentForce(&insp.area, i, &frag))
+        {
+            reason = "read error";
+            return false;
+        }
+        if ((i > 0U) && (frag.startAddress != nextStart))
+        {
+            reason = "fragment " + std::to_string(i) + " not contiguous";
+            return false;
+        }
+        if (frag.size > sizeof(frag.content))
+        {
+            reason = "fragment " + std::to_string(i) + " size";
+            return false;
+        }
+
+        nextStart = frag.startAddress + frag.size;
+
+        /* Data before the firmware start is not covered by the signature */
+        uint32_t offset = 0U;
+        if (frag.startAddress < meta.startAddress)
+        {
+            offset = std::min(frag.size, meta.startAddress - frag.startAddress);
+        }
+
+        const size_t len = frag.size - offset;
+        if ((len > 0U) && (1 != ed25519_multipart_continue(&ctx, &frag.content[offset], len)))
+        {
+            reason = "hash error";
+            return false;
+        }
+        covered += len;
+    }
+
+    if (covered != meta.firmwareSize)
+    {
+        reason = "incomplete, " + std::to_string(covered) + " of " + std::to_string(meta.firmwareSize) + " bytes";
+        return false;
+    }
+
+    if (1 != ed25519_multipart_end(&ctx))
+    {
+        reason = "signature mismatch";
+        return false;
+    }
+
+    return true;
+}
+
+static bool InspectArea(const Region& region, size_t sectorSize, uint8_t eraseValue, size_t jobs, bool verbose)
+{
+    Inspection insp;
+    InitMemConf(insp.memConf, region, sectorSize, eraseValue);
+
+    std::printf("\nFragment area 0x%08X, %zu bytes\n", (unsigned)region.address, region.size);
+
+    if (FA_ERR_OK != FA_InitStruct(&insp.area, &insp.memConf, VerifyFragment, VerifyMetadata))
+    {
+        std::printf("  Invalid area geometry\n");
+        return false;
+    }
+
+    f_inspect = &insp;
+    bool ok = true;
+
+    insp.metadataResult = FA_ReadMetadata(&insp.area, &insp.metadata);
+
+    if (insp.metadataResult == FA_ERR_EMPTY)
+    {
+        std::printf("  Metadata: empty\n");
+    }
+    else
+    {
+        PrintMetadata((insp.metadataResult == FA_ERR_OK) ? "Metadata" : "Metadata INVALID", insp.metadata);
+        ok = ok && (insp.metadataResult == FA_ERR_OK);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Slot> slots(FA_GetMaxFragmentIndex(&insp.area));
+    ValidateSlots(&insp.area, slots, jobs);
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<size_t> invalid;
+    std::vector<size_t> gaps;
+    std::vector<size_t> foreign;
+    std::vector<size_t> misplaced;
+    size_t valid = 0U;
+    size_t empty = 0U;
+    size_t used = 0U;
+
+    for (size_t i = 0U; i < slots.size(); i++)
+    {
+        const Slot& slot = slots[i];
+
+        if (slot.result != FA_ERR_EMPTY)
+        {
+            used = i + 1U;
+        }
+
+        if (verbose && (slot.result != FA_ERR_EMPTY))
+        {
+            std::printf("  Slot %zu: %s, number %u, firmware ID %08X, %u bytes at 0x%08X\n",
+                i, ResultName(slot.result), (unsigned)slot.number, (unsigned)slot.firmwareId,
+                (unsigned)slot.size, (unsigned)slot.startAddress);
+        }
+
+        switch (slot.result)
+        {
+        case FA_ERR_OK:
+            valid++;
+            if ((insp.metadataResult != FA_ERR_EMPTY) && (slot.firmwareId != insp.metadata.firmwareId))
+            {
+                foreign.push_back(i);
+            }
+            if (slot.number != i)
+            {
+                misplaced.push_back(i);
+            }
+            break;
+        case FA_ERR_EMPTY:
+            empty++;
+            break;
+        default:
+            invalid.push_back(i);
+            break;
+        }
+    }
+
+    /* Empty slots followed by used ones */
+    for (size_t i = 0U; i < used; i++)
+    {
+        if (slots[i].result == FA_ERR_EMPTY)
+        {
+            gaps.push_back(i);
+        }
+    }
+
+    std::printf("  Fragments: %zu slots, %zu valid, %zu invalid, %zu empty\n",
+        slots.size(), valid, invalid.size(), empty);
+    PrintRanges("Invalid slots", invalid);
+    PrintRanges("Gaps", gaps);
+    PrintRanges("Other firmware ID", foreign);
+    PrintRanges("Fragment number not slot index", misplaced);
+
+    ok = ok && invalid.empty() && gaps.empty() && foreign.empty() && misplaced.empty();
+
+    if ((insp.metadataResult == FA_ERR_OK) && ok && (used > 0U))
+    {
+        std::string reason;
+        if (VerifyFirmware(insp, used, reason))
+        {
+            std::printf("  Firmware: complete, signature valid\n");
+        }
+        else
+        {
+            std::printf("  Firmware: %s\n", reason.c_str());
+            ok = false;
+        }
+    }
+
+    std::printf("  Validated in %.3f s on %zu threads\n", seconds, jobs);
+
+    f_inspect = nullptr;
+    return ok;
+}
+
+static bool InspectCommandArea(const Region& region, size_t sectorSize, uint8_t eraseValue)
+{
+    MemoryConfig_t memConf;
+    CommandArea_t ca;
+    InitMemConf(memConf, region, sectorSize, eraseValue);
+
+    std::printf("\nCommand area 0x%08X, %zu bytes\n", (unsigned)region.address, region.size);
+
+    if (!CA_InitStruct(&ca, &memConf, CRC32_Calculate))
+    {
+        std::printf("  Invalid area geometry\n");
+        return false;
+    }
+
+    auto isErased = [&](Address_t address, size_t sectors) {
+        const uint8_t* data = &f_dump.data[address - f_dump.base];
+        return std::all_of(data, &data[sectors * sectorSize], [eraseValue](uint8_t b) { return b == eraseValue; });
+    };
+
+    bool ok = true;
+    Metadata_t meta;
+    CommandType_t cmd = COMMAND_TYPE_NONE;
+
+    if (isErased(ca.commandAddress, ca.commandSectors))
+    {
+        std::printf("  Install command: empty\n");
+    }
+    else if (!CA_ReadInstallCommand(&ca, &cmd, &meta))
+    {
+        std::printf("  Install command: CRC ERROR\n");
+        ok = false;
+    }
+    else
+    {
+        switch (cmd)
+        {
+        case COMMAND_TYPE_INSTALL_FIRMWARE:
+            PrintMetadata("Install command (install)", meta);
+            break;
+        case COMMAND_TYPE_ROLLBACK:
+            std::printf("  Install command: rollback\n");
+            break;
+        case COMMAND_TYPE_NONE:
+            std::printf("  Install command: none\n");
+            break;
+        default:
+            std::printf("  Install command: UNKNOWN\n");
+            ok = false;
+            break;
+        }
+    }
+
+    if (isErased(ca.historyAddress, ca.historySectors))
+    {
+        std::printf("  History: empty\n");
+    }
+    else if (!CA_ReadHistory(&ca, &meta))
+    {
+        std::printf("  History: CRC ERROR\n");
+        ok = false;
+    }
+    else
+    {
+        PrintMetadata("History", meta);
+    }
+
+    static const char* const stateNames[] = {"none", "history written", "firmware written", "FAILED"};
+    const CommandStatus_t status = CA_GetStatus(&ca);
+    std::printf("  State: %s, records:", stateNames[(status < COMMAND_STATE_COUNT) ? status : COMMAND_STATE_FAILED]);
+
+    /* State records are 32 bit magics, including user status values */
+    for (size_t i = 0U; i < (ca.stateSectors * sectorSize); i += sizeof(uint32_t))
+    {
+        uint32_t record;
+        memcpy(&record, &f_dump.data[(ca.stateAddress - f_dump.base) + i], sizeof(record));
+        if (record != (0x01010101U * eraseValue))
+        {
+            std::printf(" %08X", (unsigned)record);
+        }
+    }
+    std::printf("\n");
+
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+    std::cout << "fwinspect v0.1" << std::endl;
+
+    argparse::ArgumentParser parser("fwinspect v0.1");
+    AddArguments(parser);
+
+    try
+    {
+        parser.parse_args(argc, argv);
+    }
+    catch (const std::exception& err)
+    {
+        std::cerr << err.what() << std::endl;
+        std::cerr << parser;
+        return 1;
+    }
+
+    uint64_t base = 0U;
+    uint64_t sectorSize = 0U;
+    uint64_t eraseValue = 0U;
+
+    if (!ParseNumber(parser.get("--base"), base) ||
+        !ParseNumber(parser.get("--sector"), sectorSize) ||
+        !ParseNumber(parser.get("--erase"), eraseValue) ||
+        (base > UINT32_MAX) || (sectorSize == 0U) || (eraseValue > 0xFFU))
+    {
+        std::cout << "Invalid base address, sector size or erase value" << std::endl;
+        return 1;
+    }
+
+    std::vector<Region> areas;
+    for (const std::string& str: GetList(parser, "--area"))
+    {
+        Region region;
+        if (!ParseRegion(str, region))
+        {
+            std::cout << "Invalid area " << str << ", expected address:size" << std::endl;
+            return 1;
+        }
+        areas.push_back(region);
+    }
+
+    Region commandArea = {0U, 0U};
+    if (parser.is_used("--command") && !ParseRegion(parser.get("--command"), commandArea))
+    {
+        std::cout << "Invalid command area, expected address:size" << std::endl;
+        return 1;
+    }
+
+    if (areas.empty() && (commandArea.size == 0U))
+    {
+        std::cout << "Nothing to inspect, give --area or --command" << std::endl;
+        return 1;
+    }
+
+    if (!LoadKeys(parser))
+    {
+        std::cout << "At least one valid key is required" << std::endl;
+        return 1;
+    }
+
+    if (!OpenDump(parser.get("--input"), f_dump))
+    {
+        std::cout << "Cannot open dump " << parser.get("--input") << std::endl;
+        return 1;
+    }
+    f_dump.base = (Address_t)base;
+
+    std::printf("Dump: %zu bytes at 0x%08X\n", f_dump.size, (unsigned)f_dump.base);
+
+    std::vector<Region> all = areas;
+    if (commandArea.size != 0U)
+    {
+        all.push_back(commandArea);
+    }
+    for (const Region& region: all)
+    {
+        if (!InDump(region.address, region.size))
+        {
+            std::printf("Area 0x%08X, %zu bytes is outside the dump\n", (unsigned)region.address, region.size);
+            return 1;
+        }
+    }
+
+    size_t jobs = parser.get<size_t>("--jobs");
+    if (jobs == 0U)
+    {
+        jobs = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    const bool verbose = parser.get<bool>("--verbose");
+    bool ok = true;
+
+    for (const Region& region: areas)
+    {
+        ok = InspectArea(region, (size_t)sectorSize, (uint8_t)eraseValue, jobs, verbose) && ok;
+    }
+
+    if (commandArea.size != 0U)
+    {
+        ok = InspectCommandArea(commandArea, (size_t)sectorSize, (uint8_t)eraseValue) && ok;
+    }
+
+    std::printf("\n%s\n", ok ? "No problems found" : "Problems found");
+
+    return ok ? 0 : 2;
+}
+
+/* EoF fwinspect.cpp */
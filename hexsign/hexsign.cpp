@@ -39,6 +39,7 @@
 #include <sstream>
 
 #include "argparse/argparse.hpp"
+#include "crc/crc32.h"
 #include "ed25519.h"
 #include "hexfile.hpp"
 #include "fragmentstore/fragmentstore.h"
@@ -80,14 +81,8 @@ static bool VerifyKeys(const KeyPair& keyPair)
     const char msg[] = "Test message to verify asymmetric keys";
     uint8_t signature[64];
 
-    const auto seed = keyPair.GetPrivateKey();
-    const auto pubFile = keyPair.GetPublicKey();
-
-    // Verify key sizes
-    if ((seed.size() < 32) || (pubFile.size() != 32))
-    {
-        return false;
-    }
+    const auto& seed = keyPair.GetPrivateKey();
+    const auto& pubFile = keyPair.GetPublicKey();
 
     // Generate signing keys from the keyPair
     uint8_t pubGen[32];
@@ -105,26 +100,9 @@ static bool VerifyKeys(const KeyPair& keyPair)
     return ed25519_verify(signature, (const uint8_t*)msg, strlen(msg), pubFile.data());
 }
 
-static uint32_t Crc32(const uint8_t* data, size_t size)
-{
-  uint32_t r = ~0; const uint8_t *end = data + size;
- 
-  while(data < end)
-  {
-    r ^= *data++;
- 
-    for(int i = 0; i < 8; i++)
-    {
-      uint32_t t = ~((r&1) - 1); r = (r>>1) ^ (0xEDB88320 & t);
-    }
-  }
- 
-  return ~r;
-}
-
 static std::string Crc32Str(const uint8_t* data, size_t size)
 {
-    const uint32_t crc32 = Crc32(data, size);
+    const uint32_t crc32 = CRC32_Calculate(data, size);
     std::stringstream crcStr;
     crcStr << std::uppercase << std::hex << crc32;
     return crcStr.str();
@@ -132,9 +110,9 @@ static std::string Crc32Str(const uint8_t* data, size_t size)
 
 static void OutputKeySignature(const KeyPair& keyPair)
 {
-    const auto pubKey = keyPair.GetPublicKey();
+    const auto& pubKey = keyPair.GetPublicKey();
 
-    std::cout << "Public key CRC32: " << Crc32Str(pubKey.data(), pubKey.size()) << std::endl;
+    std::cout << "Public key CRC32 (key ID): " << Crc32Str(pubKey.data(), pubKey.size()) << std::endl;
 }
 
 static bool InRange(uint32_t val, uint32_t low, uint32_t high)
@@ -167,7 +145,7 @@ static bool CheckMetadataMem(const Metadata_t* const meta, const HexFile::Sectio
     return true;
 }
 
-static void TrySignSection(HexFile::Section& sec, const uint8_t* seed)
+static void TrySignSection(HexFile::Section& sec, const uint8_t* seed, uint32_t keyId)
 {
     Metadata_t* const meta = (Metadata_t* const)sec.data.data();
 
@@ -177,8 +155,9 @@ static void TrySignSection(HexFile::Section& sec, const uint8_t* seed)
         const uint32_t fwEnd = sec.startAddress + sec.data.size();
         const uint32_t fwSize = fwEnd - fwStart;
 
-        // Set the actual HEX size to metadata
+        // Set the actual HEX size and signing key to metadata
         meta->firmwareSize = fwSize;
+        meta->keyId = keyId;
 
         const uint32_t startOffset = fwStart - sec.startAddress;
         const uint8_t* secDataPtr = sec.data.data();
@@ -278,14 +257,15 @@ int main(int argc, char* argv[])
 
     HexFile hex(inputFile);
 
+    const uint8_t* seed = keypair.GetPrivateKey().data();
+    const uint8_t* pubKey = keypair.GetPublicKey().data();
+
     for (size_t i = 0; i < hex.GetSectionCount(); i++)
     {
         HexFile::Section& sec = hex.GetSectionAt(i);
 
         std::cout << "Section" << i << ": start: 0x" << std::hex << sec.startAddress << " len: " << std::dec << sec.data.size() << std::endl;
-        const uint8_t* seed = keypair.GetPrivateKey().data();
-        const uint8_t* pubKey = keypair.GetPublicKey().data();
-        TrySignSection(sec, seed);
+        TrySignSection(sec, seed, keypair.GetKeyId());
         VerifySectionSignature(sec, pubKey);
     }
 
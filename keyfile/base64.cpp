@@ -2,7 +2,12 @@
  *
  * base64.cpp
  *
- * @brief {Short description of the source file}
+ * @brief Base64 (RFC 4648) encoder and decoder with AVX2/NEON paths
+ * 
+ * Vectorized paths follow the pshufb based algorithms of W. Mula and
+ * D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions".
+ * Blocks containing characters outside the alphabet and the tail are handled
+ * by the scalar code.
 */
 
 /*----------------------------------------------------------------------------*/
@@ -10,46 +15,444 @@
 /*----------------------------------------------------------------------------*/
 
 #include "base64.hpp"
-#include <vector>
+#include <array>
+
+#if (defined __x86_64__ || defined __i386__) && \
+    (defined __GNUC__ || defined __clang__)
+#define BASE64_AVX2
+#include <immintrin.h>
+#elif defined __aarch64__ && defined __ARM_NEON
+#define BASE64_NEON
+#include <arm_neon.h>
+#endif
 
 /*----------------------------------------------------------------------------*/
-/* PUBLIC FUNCTION DEFINITIONS                                                */
+/* MACRO DEFINITIONS                                                          */
 /*----------------------------------------------------------------------------*/
 
-std::string Base64::Decode(const std::string& encoded)
+#define INVALID (0xFFU)
+#define PAD '='
+
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+/* Input needed per vector iteration, including over-read and over-write */
+#define AVX2_DECODE_MIN (48U)
+#define AVX2_ENCODE_MIN (32U)
+#define NEON_DECODE_MIN (64U)
+#define NEON_ENCODE_MIN (48U)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static constexpr char f_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static constexpr std::array<uint8_t, 256U> MakeDecodeTable()
 {
-    std::string base64_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string decoded;
+    std::array<uint8_t, 256U> table{};
 
-    std::vector<int> T(256, -1);
+    for (size_t i = 0U; i < table.size(); i++)
+    {
+        table[i] = INVALID;
+    }
 
-    for (int i = 0; i < 64; i++) 
+    for (size_t i = 0U; i < 64U; i++)
     {
-        T[base64_chars[i]] = i;
+        table[(uint8_t)f_alphabet[i]] = (uint8_t)i;
     }
 
-    int val = 0;
-    int valb = -8;
+    return table;
+}
+
+static constexpr std::array<uint8_t, 256U> f_decodeTable = MakeDecodeTable();
+
+static bool f_simdEnabled = true;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+#ifdef BASE64_AVX2
+
+static bool HasAvx2()
+{
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+
+/* Decode 32 characters to 24 bytes, writes 32 bytes. False on invalid input. */
+static inline TARGET_AVX2 bool DecodeBlockAvx2(const char* in, uint8_t* out)
+{
+    const __m256i lutLo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask2F = _mm256_set1_epi8(0x2F);
+
+    __m256i v = _mm256_loadu_si256((const __m256i*)in);
+
+    /* Classify by nibbles, every valid character has disjoint lo/hi bits */
+    const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask2F);
+    const __m256i loNibbles = _mm256_and_si256(v, mask2F);
+    const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+    const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+
+    if (!_mm256_testz_si256(lo, hi))
+    {
+        return false;
+    }
+
+    /* Characters to 6-bit values */
+    const __m256i eq2F = _mm256_cmpeq_epi8(v, mask2F);
+    const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+    v = _mm256_add_epi8(v, roll);
+
+    /* Pack 4 x 6 bits to 3 bytes in each 32-bit word */
+    v = _mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140));
+    v = _mm256_madd_epi16(v, _mm256_set1_epi32(0x00011000));
+    v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1));
+
+    _mm256_storeu_si256((__m256i*)out, v);
+
+    return true;
+}
+
+static TARGET_AVX2 size_t DecodeAvx2(const char* in, size_t len, uint8_t* out, size_t* consumed)
+{
+    size_t i = 0U;
+    size_t o = 0U;
+
+    while (((len - i) >= AVX2_DECODE_MIN) && DecodeBlockAvx2(&in[i], &out[o]))
+    {
+        i += 32U;
+        o += 24U;
+    }
+
+    *consumed = i;
+    return o;
+}
+
+/* Encode 24 bytes to 32 characters, reads 28 bytes */
+static TARGET_AVX2 size_t EncodeAvx2(const uint8_t* in, size_t len, char* out, size_t* consumed)
+{
+    const __m256i shuffle = _mm256_setr_epi8(
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+        1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    const __m256i shiftLut = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t i = 0U;
+    size_t o = 0U;
+
+    while ((len - i) >= AVX2_ENCODE_MIN)
+    {
+        const __m128i lo = _mm_loadu_si128((const __m128i*)&in[i]);
+        const __m128i hi = _mm_loadu_si128((const __m128i*)&in[i + 12U]);
+        __m256i v = _mm256_shuffle_epi8(_mm256_set_m128i(hi, lo), shuffle);
+
+        /* Split 3 bytes to 4 x 6 bits in each 32-bit word */
+        const __m256i t0 = _mm256_and_si256(v, _mm256_set1_epi32(0x0FC0FC00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(v, _mm256_set1_epi32(0x003F03F0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        /* 6-bit values to characters */
+        __m256i r = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        r = _mm256_or_si256(r, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+        r = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLut, r), indices);
+
+        _mm256_storeu_si256((__m256i*)&out[o], r);
+
+        i += 24U;
+        o += 32U;
+    }
+
+    *consumed = i;
+    return o;
+}
+
+#endif /* BASE64_AVX2 */
+
+#ifdef BASE64_NEON
+
+static inline uint8x16x4_t LoadTable(const uint8_t* table)
+{
+    uint8x16x4_t t;
+    t.val[0] = vld1q_u8(&table[0]);
+    t.val[1] = vld1q_u8(&table[16]);
+    t.val[2] = vld1q_u8(&table[32]);
+    t.val[3] = vld1q_u8(&table[48]);
+    return t;
+}
+
+static inline uint8x16_t Lookup128(uint8x16x4_t lo, uint8x16x4_t hi, uint8x16_t c)
+{
+    /* Out of range indices keep the INVALID fill */
+    const uint8x16_t r = vqtbx4q_u8(vdupq_n_u8(INVALID), lo, c);
+    return vqtbx4q_u8(r, hi, vsubq_u8(c, vdupq_n_u8(64U)));
+}
+
+/* Decode 64 characters to 48 bytes per iteration */
+static size_t DecodeNeon(const char* in, size_t len, uint8_t* out, size_t* consumed)
+{
+    const uint8x16x4_t lo = LoadTable(&f_decodeTable[0]);
+    const uint8x16x4_t hi = LoadTable(&f_decodeTable[64]);
+
+    size_t i = 0U;
+    size_t o = 0U;
+
+    while ((len - i) >= NEON_DECODE_MIN)
+    {
+        const uint8x16x4_t c = vld4q_u8((const uint8_t*)&in[i]);
+
+        const uint8x16_t a = Lookup128(lo, hi, c.val[0]);
+        const uint8x16_t b = Lookup128(lo, hi, c.val[1]);
+        const uint8x16_t d = Lookup128(lo, hi, c.val[2]);
+        const uint8x16_t e = Lookup128(lo, hi, c.val[3]);
+
+        const uint8x16_t all = vorrq_u8(vorrq_u8(a, b), vorrq_u8(d, e));
+        if (vmaxvq_u8(all) >= 64U)
+        {
+            break;
+        }
+
+        uint8x16x3_t r;
+        r.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        r.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(d, 2));
+        r.val[2] = vorrq_u8(vshlq_n_u8(d, 6), e);
+        vst3q_u8(&out[o], r);
+
+        i += 64U;
+        o += 48U;
+    }
+
+    *consumed = i;
+    return o;
+}
+
+/* Encode 48 bytes to 64 characters per iteration */
+static size_t EncodeNeon(const uint8_t* in, size_t len, char* out, size_t* consumed)
+{
+    const uint8x16x4_t alphabet = LoadTable((const uint8_t*)f_alphabet);
+    const uint8x16_t mask = vdupq_n_u8(0x3FU);
 
-    for (char c : encoded)
+    size_t i = 0U;
+    size_t o = 0U;
+
+    while ((len - i) >= NEON_ENCODE_MIN)
+    {
+        const uint8x16x3_t x = vld3q_u8(&in[i]);
+
+        uint8x16x4_t r;
+        r.val[0] = vshrq_n_u8(x.val[0], 2);
+        r.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(x.val[0], 4), vshrq_n_u8(x.val[1], 4)), mask);
+        r.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(x.val[1], 2), vshrq_n_u8(x.val[2], 6)), mask);
+        r.val[3] = vandq_u8(x.val[2], mask);
+
+        r.val[0] = vqtbl4q_u8(alphabet, r.val[0]);
+        r.val[1] = vqtbl4q_u8(alphabet, r.val[1]);
+        r.val[2] = vqtbl4q_u8(alphabet, r.val[2]);
+        r.val[3] = vqtbl4q_u8(alphabet, r.val[3]);
+        vst4q_u8((uint8_t*)&out[o], r);
+
+        i += 48U;
+        o += 64U;
+    }
+
+    *consumed = i;
+    return o;
+}
+
+#endif /* BASE64_NEON */
+
+static size_t DecodeSimd(const char* in, size_t len, uint8_t* out, size_t* consumed)
+{
+    *consumed = 0U;
+
+    if (!f_simdEnabled)
+    {
+        return 0U;
+    }
+
+#if defined BASE64_AVX2
+    if (HasAvx2())
+    {
+        return DecodeAvx2(in, len, out, consumed);
+    }
+#elif defined BASE64_NEON
+    return DecodeNeon(in, len, out, consumed);
+#endif
+
+    return 0U;
+}
+
+static size_t EncodeSimd(const uint8_t* in, size_t len, char* out, size_t* consumed)
+{
+    *consumed = 0U;
+
+    if (!f_simdEnabled)
+    {
+        return 0U;
+    }
+
+#if defined BASE64_AVX2
+    if (HasAvx2())
+    {
+        return EncodeAvx2(in, len, out, consumed);
+    }
+#elif defined BASE64_NEON
+    return EncodeNeon(in, len, out, consumed);
+#endif
+
+    return 0U;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+size_t Base64::Decode(const char* encoded, size_t len, uint8_t* out)
+{
+    size_t i = 0U;
+    size_t o = DecodeSimd(encoded, len, out, &i);
+
+    /* Full groups */
+    while ((len - i) >= 4U)
     {
-        if (T[c] == -1)
+        const uint32_t a = f_decodeTable[(uint8_t)encoded[i]];
+        const uint32_t b = f_decodeTable[(uint8_t)encoded[i + 1U]];
+        const uint32_t c = f_decodeTable[(uint8_t)encoded[i + 2U]];
+        const uint32_t d = f_decodeTable[(uint8_t)encoded[i + 3U]];
+
+        if (((a | b | c | d) & 0x80U) != 0U)
         {
             break;
         }
 
-        val = (val << 6) + T[c];
+        const uint32_t val = (a << 18U) | (b << 12U) | (c << 6U) | d;
+        out[o] = (uint8_t)(val >> 16U);
+        out[o + 1U] = (uint8_t)(val >> 8U);
+        out[o + 2U] = (uint8_t)val;
 
+        i += 4U;
+        o += 3U;
+    }
+
+    /* Partial group, up to the first invalid character */
+    uint32_t val = 0U;
+    int valb = -8;
+
+    for (; i < len; i++)
+    {
+        const uint8_t c = f_decodeTable[(uint8_t)encoded[i]];
+
+        if (c == INVALID)
+        {
+            break;
+        }
+
+        val = (val << 6U) | c;
         valb += 6;
 
         if (valb >= 0)
         {
-            decoded.push_back(char((val >> valb) & 0xFF));
+            out[o++] = (uint8_t)(val >> valb);
             valb -= 8;
         }
     }
 
+    return o;
+}
+
+std::string Base64::Decode(const std::string& encoded)
+{
+    std::string decoded(DecodedSize(encoded.size()), '\0');
+    const size_t len = Decode(encoded.data(), encoded.size(), (uint8_t*)decoded.data());
+    decoded.resize(len);
     return decoded;
 }
 
+size_t Base64::Encode(const uint8_t* data, size_t len, char* out)
+{
+    size_t i = 0U;
+    size_t o = EncodeSimd(data, len, out, &i);
+
+    while ((len - i) >= 3U)
+    {
+        const uint32_t val = ((uint32_t)data[i] << 16U) | 
+                             ((uint32_t)data[i + 1U] << 8U) | 
+                             (uint32_t)data[i + 2U];
+
+        out[o] = f_alphabet[(val >> 18U) & 0x3FU];
+        out[o + 1U] = f_alphabet[(val >> 12U) & 0x3FU];
+        out[o + 2U] = f_alphabet[(val >> 6U) & 0x3FU];
+        out[o + 3U] = f_alphabet[val & 0x3FU];
+
+        i += 3U;
+        o += 4U;
+    }
+
+    const size_t rem = len - i;
+
+    if (rem > 0U)
+    {
+        const uint32_t val = ((uint32_t)data[i] << 16U) | 
+                             ((rem > 1U) ? ((uint32_t)data[i + 1U] << 8U) : 0U);
+
+        out[o] = f_alphabet[(val >> 18U) & 0x3FU];
+        out[o + 1U] = f_alphabet[(val >> 12U) & 0x3FU];
+        out[o + 2U] = (rem > 1U) ? f_alphabet[(val >> 6U) & 0x3FU] : PAD;
+        out[o + 3U] = PAD;
+        o += 4U;
+    }
+
+    return o;
+}
+
+std::string Base64::Encode(const uint8_t* data, size_t len)
+{
+    std::string encoded(EncodedSize(len), '\0');
+    Encode(data, len, encoded.data());
+    return encoded;
+}
+
+void Base64::SetSimdEnabled(bool enable)
+{
+    f_simdEnabled = enable;
+}
+
+const char* Base64::GetKernelName()
+{
+    if (f_simdEnabled)
+    {
+#if defined BASE64_AVX2
+        if (HasAvx2())
+        {
+            return "avx2";
+        }
+#elif defined BASE64_NEON
+        return "neon";
+#endif
+    }
+
+    return "scalar";
+}
+
 /* EoF base64.cpp */
@@ -24,7 +24,7 @@
  *
  * base64.hpp
  *
- * @brief {Short description of the source file}
+ * @brief Base64 (RFC 4648) encoder and decoder with AVX2/NEON paths
 */
 
 #ifndef BASE64_H_
@@ -34,6 +34,8 @@
 /* INCLUDE DIRECTIVES                                                         */
 /*----------------------------------------------------------------------------*/
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 /*----------------------------------------------------------------------------*/
@@ -42,8 +44,63 @@
 
 namespace Base64 {
 
+/** Maximum decoded size of encoded data
+ * 
+ * @param encodedLen Encoded length in characters
+ * @return Output buffer size required by Decode()
+ */
+constexpr size_t DecodedSize(size_t encodedLen)
+{
+    return ((encodedLen + 3U) / 4U) * 3U;
+}
+
+/** Encoded size of data, including padding
+ * 
+ * @param len Data length in bytes
+ * @return Output buffer size required by Encode()
+ */
+constexpr size_t EncodedSize(size_t len)
+{
+    return ((len + 2U) / 3U) * 4U;
+}
+
+/** Decode base64 data
+ * 
+ * Decoding stops at the first character outside of the base64 alphabet,
+ * e.g. padding or the end of the data.
+ * 
+ * @param encoded Encoded characters
+ * @param len Encoded length
+ * @param out Output buffer of at least DecodedSize(len) bytes
+ * @return Decoded length
+ */
+extern size_t Decode(const char* encoded, size_t len, uint8_t* out);
+
 extern std::string Decode(const std::string& encoded);
 
+/** Encode data to base64 with padding
+ * 
+ * @param data Data to encode
+ * @param len Data length
+ * @param out Output buffer of at least EncodedSize(len) characters
+ * @return Encoded length, always EncodedSize(len)
+ */
+extern size_t Encode(const uint8_t* data, size_t len, char* out);
+
+extern std::string Encode(const uint8_t* data, size_t len);
+
+/** Enable or disable the vectorized paths (enabled by default when supported)
+ * 
+ * @param enable Use AVX2/NEON when the CPU supports it
+ */
+extern void SetSimdEnabled(bool enable);
+
+/** Get name of the active implementation
+ * 
+ * @return "avx2", "neon" or "scalar"
+ */
+extern const char* GetKernelName();
+
 }
 
 /* EoF base64.hpp */
@@ -25,6 +25,10 @@
  * generate_keyfile.cpp
  *
  * @brief Small too for generating header files containing OpenSSH public keys
+ * 
+ * With several input keys the header also contains a keyring
+ * (ed25519_keyring.h) indexed by key ID, for accepting images signed with any
+ * of the keys during key rotation.
 */
 
 /*----------------------------------------------------------------------------*/
@@ -33,17 +37,37 @@
 
 #include <fstream>
 #include <iomanip>
+#include <iostream>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "argparse/argparse.hpp"
 #include "keyfile/openSSH_key.hpp"
 
+extern "C" {
+#include "ed25519_keyring.h"
+}
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+struct RingKey
+{
+    std::string fileName;
+    uint32_t keyId;
+    ed25519_precomputed_key_t key;
+};
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /*----------------------------------------------------------------------------*/
 
-static std::string MakeHexString(const std::vector<uint8_t>& vec, std::string delim = ", ")
+template <typename Bytes>
+static std::string MakeHexString(const Bytes& vec, std::string delim = ", ")
 {
     std::stringstream ss;
 
@@ -62,30 +86,134 @@ static std::string MakeHexString(const std::vector<uint8_t>& vec, std::string de
     return ss.str();
 }
 
+static std::string MakeFieldString(const fe& f)
+{
+    std::stringstream ss;
+
+    ss << "{";
+    for (size_t i = 0; i < 10U; i++)
+    {
+        ss << ((i == 0U) ? " " : ", ") << f[i];
+    }
+    ss << " }";
+
+    return ss.str();
+}
+
+static std::string MakeEntryString(const ed25519_keyring_entry_t& entry)
+{
+    std::stringstream ss;
+
+    if (!entry.in_use)
+    {
+        return "{ 0U, 0U, { { 0U }, { { 0 }, { 0 }, { 0 }, { 0 } } } }";
+    }
+
+    ss << "{ 0x" << std::hex << std::setw(8) << std::setfill('0') << entry.key_id << std::dec << "U, 1U, {\n";
+    ss << "        { " << MakeHexString(entry.key.public_key) << " },\n";
+    ss << "        { " << MakeFieldString(entry.key.A.X) << ",\n";
+    ss << "          " << MakeFieldString(entry.key.A.Y) << ",\n";
+    ss << "          " << MakeFieldString(entry.key.A.Z) << ",\n";
+    ss << "          " << MakeFieldString(entry.key.A.T) << " } } }";
+
+    return ss.str();
+}
+
+static RingKey LoadKey(const std::string& fileName)
+{
+    std::ifstream keyFile(fileName);
+
+    if (!keyFile.good())
+    {
+        throw std::runtime_error("Cannot open key file: " + fileName);
+    }
+
+    KeyPair keypair(keyFile);
+    RingKey ringKey;
+
+    ringKey.fileName = fileName;
+    ringKey.keyId = keypair.GetKeyId();
+
+    if (1 != ed25519_precompute_key(&ringKey.key, keypair.GetPublicKey().data()))
+    {
+        throw std::runtime_error("Invalid ed25519 public key: " + fileName);
+    }
+
+    return ringKey;
+}
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /*----------------------------------------------------------------------------*/
 
 int main(int argc, const char* argv[])
 {
-    argparse::ArgumentParser parser("generate_keyfile", "v0.1");
+    argparse::ArgumentParser parser("generate_keyfile", "v0.2");
 
     parser.add_argument("-i", "--input")
-        .help("Input OpenSSH key pair file");
+        .help("Input OpenSSH key pair file(s), first one is the generated_public_key")
+        .nargs(argparse::nargs_pattern::at_least_one);
 
     parser.add_argument("-o", "--output")
         .help("Output header file");
 
     parser.parse_args(argc, argv);
 
-    std::ifstream keyFile(parser.get("-i"));
-    KeyPair keypair(keyFile);
-    
+    std::vector<RingKey> keys;
+    std::set<uint32_t> keyIds;
+
+    for (const auto& fileName: parser.get<std::vector<std::string>>("-i"))
+    {
+        keys.push_back(LoadKey(fileName));
+
+        if (!keyIds.insert(keys.back().keyId).second)
+        {
+            std::cerr << "Duplicate key ID for " << fileName << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<ed25519_keyring_entry_t> entries;
+
+    for (const auto& k: keys)
+    {
+        ed25519_keyring_entry_t entry = {};
+        entry.key_id = k.keyId;
+        entry.key = k.key;
+        entries.push_back(entry);
+    }
+
+    std::vector<ed25519_keyring_entry_t> table(ed25519_keyring_table_size(entries.data(), entries.size()));
+    ed25519_keyring_t ring;
+
+    if (1 != ed25519_keyring_build(&ring, table.data(), table.size(), entries.data(), entries.size()))
+    {
+        std::cerr << "Cannot build keyring" << std::endl;
+        return 1;
+    }
+
+    const size_t tableSize = table.size();
+
     std::ofstream output(parser.get("-o"));
 
     output << "#ifndef __GENERATED_KEYFILE__\n";
     output << "#define __GENERATED_KEYFILE__\n";
-    output << "const unsigned char generated_public_key[] = {" << MakeHexString(keypair.GetPublicKey()) << "};\n";
+    output << "#include \"ed25519_keyring.h\"\n";
+    output << "const unsigned char generated_public_key[] = {" << MakeHexString(keys.front().key.public_key) << "};\n";
+
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        output << "#define GENERATED_KEY_ID_" << i << " (0x" << std::hex << std::setw(8) << std::setfill('0') 
+               << keys[i].keyId << std::dec << "U) /* " << keys[i].fileName << " */\n";
+    }
+
+    output << "static const ed25519_keyring_entry_t generated_keyring_entries[" << tableSize << "] = {\n";
+    for (size_t i = 0; i < tableSize; i++)
+    {
+        output << "    " << MakeEntryString(table[i]) << ((i + 1U < tableSize) ? ",\n" : "\n");
+    }
+    output << "};\n";
+    output << "static const ed25519_keyring_t generated_keyring = { generated_keyring_entries, " << tableSize << "U };\n";
     output << "#endif\n";
 
     output.close();
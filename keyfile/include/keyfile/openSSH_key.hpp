@@ -34,10 +34,12 @@
 /* INCLUDE DIRECTIVES                                                         */
 /*----------------------------------------------------------------------------*/
 
-#include <vector>
+#include <array>
 #include <cstdint>
 #include <istream>
 
+#include "keyfile/secure_buffer.hpp"
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC TYPE DEFINITIONS                                                    */
 /*----------------------------------------------------------------------------*/
@@ -45,13 +47,28 @@
 class KeyPair
 {
 public:
+    static constexpr size_t PRIVATE_KEY_SIZE = 64U; /* Seed followed by public key */
+    static constexpr size_t PUBLIC_KEY_SIZE = 32U;
+
+    using PrivateKey = std::array<uint8_t, PRIVATE_KEY_SIZE>;
+    using PublicKey = std::array<uint8_t, PUBLIC_KEY_SIZE>;
+
     KeyPair():
         m_privateKey(),
         m_publicKey()
     {}
 
-    KeyPair(std::istream& input):
-        m_privateKey(),
+    /** Empty key pair
+     * 
+     * @param lockMemory Lock private key to RAM, see SecureBuffer
+     */
+    explicit KeyPair(bool lockMemory):
+        m_privateKey(lockMemory),
+        m_publicKey()
+    {}
+
+    KeyPair(std::istream& input, bool lockMemory = false):
+        m_privateKey(lockMemory),
         m_publicKey()
     {
         FromFile(input);
@@ -61,18 +78,23 @@ public:
 
     void FromFile(std::istream& input);
 
-    std::vector<uint8_t> GetPrivateKey() const
+    /* Views to the key material, valid for the lifetime of the KeyPair. 
+       Private key is wiped when the KeyPair is destroyed. */
+    const PrivateKey& GetPrivateKey() const
     {
-        return m_privateKey;
+        return m_privateKey.Get();
     }
-    std::vector<uint8_t> GetPublicKey() const
+    const PublicKey& GetPublicKey() const
     {
         return m_publicKey;
     }
 
+    /* Key ID for keyrings and Metadata_t keyId, CRC32 of the public key */
+    uint32_t GetKeyId() const;
+
 private:
-    std::vector<uint8_t> m_privateKey;
-    std::vector<uint8_t> m_publicKey;
+    SecureBuffer<PRIVATE_KEY_SIZE> m_privateKey;
+    PublicKey m_publicKey;
 };
 
 /* EoF openSSH_key.hpp */
@@ -0,0 +1,196 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * secure_buffer.hpp
+ *
+ * @brief Fixed size heap buffer for key material, wiped on destruction
+*/
+
+#ifndef SECURE_BUFFER_H_
+#define SECURE_BUFFER_H_
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <sys/mman.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+/** Key material buffer
+ * 
+ * Content lives in its own allocation, so the address is stable over moves
+ * and the memory can be locked out of swap. Content is wiped before the memory
+ * is released. Locking works on whole pages: unlocking also unlocks other
+ * data sharing the page. Moves do not allocate: a moved-from buffer reads as
+ * zeros and gets a fresh unlocked allocation on the first non-const Get().
+ */
+template <size_t N>
+class SecureBuffer
+{
+public:
+    using Array = std::array<uint8_t, N>;
+
+    /** Allocate zeroed buffer
+     * 
+     * @param lockMemory Lock buffer to RAM (mlock/VirtualLock), throws
+     *                   std::runtime_error when the lock cannot be acquired
+     */
+    explicit SecureBuffer(bool lockMemory = false):
+        m_data(new Array()),
+        m_locked(false)
+    {
+        if (lockMemory)
+        {
+            Lock();
+        }
+    }
+
+    SecureBuffer(const SecureBuffer& other):
+        SecureBuffer(other.m_locked)
+    {
+        *m_data = other.Get();
+    }
+
+    SecureBuffer(SecureBuffer&& other) noexcept:
+        m_data(std::move(other.m_data)),
+        m_locked(other.m_locked)
+    {
+        other.m_locked = false;
+    }
+
+    SecureBuffer& operator=(const SecureBuffer& other)
+    {
+        Get() = other.Get();
+        return *this;
+    }
+
+    SecureBuffer& operator=(SecureBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_data = std::move(other.m_data);
+            m_locked = other.m_locked;
+            other.m_locked = false;
+        }
+        return *this;
+    }
+
+    ~SecureBuffer()
+    {
+        Release();
+    }
+
+    const Array& Get() const
+    {
+        static const Array empty = {};
+        return m_data ? *m_data : empty;
+    }
+
+    Array& Get()
+    {
+        if (!m_data)
+        {
+            m_data.reset(new Array());
+        }
+        return *m_data;
+    }
+
+    bool IsLocked() const
+    {
+        return m_locked;
+    }
+
+    /** Zero the content, the allocation is kept */
+    void Wipe()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+
+        /* Volatile access keeps the compiler from eliding the wipe */
+        volatile uint8_t* p = m_data->data();
+        for (size_t i = 0U; i < N; i++)
+        {
+            p[i] = 0U;
+        }
+    }
+
+private:
+    void Lock()
+    {
+#ifdef _WIN32
+        m_locked = (0 != VirtualLock(m_data->data(), N));
+#else
+        m_locked = (0 == mlock(m_data->data(), N));
+#endif
+        if (!m_locked)
+        {
+            throw std::runtime_error("Cannot lock key memory");
+        }
+    }
+
+    void Release()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+
+        Wipe();
+
+        if (m_locked)
+        {
+#ifdef _WIN32
+            VirtualUnlock(m_data->data(), N);
+#else
+            munlock(m_data->data(), N);
+#endif
+            m_locked = false;
+        }
+
+        m_data.reset();
+    }
+
+    std::unique_ptr<Array> m_data;
+    bool m_locked;
+};
+
+/* EoF secure_buffer.hpp */
+
+#endif /* SECURE_BUFFER_H_ */
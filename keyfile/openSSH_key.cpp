@@ -34,11 +34,38 @@
 #include "keyfile/openSSH_key.hpp"
 #include "base64.hpp"
 
+extern "C" {
+#include "crc/crc32.h"
+}
+
 #include <cstring>
 #include <exception>
 #include <stdexcept>
 #include <string>
 
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+/* Wipes intermediate copies of the key file when leaving scope */
+class StringWiper
+{
+public:
+    explicit StringWiper(std::string& str): m_str(str) {}
+
+    ~StringWiper()
+    {
+        volatile char* p = m_str.data();
+        for (size_t i = 0U; i < m_str.size(); i++)
+        {
+            p[i] = 0;
+        }
+    }
+
+private:
+    std::string& m_str;
+};
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /*----------------------------------------------------------------------------*/
@@ -96,7 +123,9 @@ static uint32_t ReadUint32(const uint8_t* data) {
 void KeyPair::FromFile(std::istream& input)
 {
     std::string fileData = ReadKeyFileContent(input);
+    StringWiper fileDataWiper(fileData);
     std::string binary = Base64::Decode(fileData);
+    StringWiper binaryWiper(binary);
 
     const uint8_t* p = reinterpret_cast<const uint8_t*>(binary.data());
     size_t len = binary.size();
@@ -177,10 +206,10 @@ void KeyPair::FromFile(std::istream& input)
     p += 4;
     require(pub_len); 
 
-    if (pub_len != 32)
+    if (pub_len != PUBLIC_KEY_SIZE)
         throw std::runtime_error("Expected 32-byte public key blob");
 
-    m_publicKey = std::vector<uint8_t>(p, p + 32);
+    std::memcpy(m_publicKey.data(), p, PUBLIC_KEY_SIZE);
 
     p += pub_len;
 
@@ -190,10 +219,15 @@ void KeyPair::FromFile(std::istream& input)
     p += 4;
     require(priv_len);
 
-    if (priv_len != 64)
+    if (priv_len != PRIVATE_KEY_SIZE)
         throw std::runtime_error("Expected 64-byte private key blob");
 
-    m_privateKey = std::vector<uint8_t>(p, p + 64);
+    std::memcpy(m_privateKey.Get().data(), p, PRIVATE_KEY_SIZE);
+}
+
+uint32_t KeyPair::GetKeyId() const
+{
+    return CRC32_Calculate(m_publicKey.data(), m_publicKey.size());
 }
 
 /* EoF openSSH_key.cpp */
@@ -0,0 +1,127 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * handoff.c
+ *
+ * @brief Verified state handoff between boot stages over soft reset
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "niram/handoff.h"
+#include "crc/crc32.h"
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) (ptr == NULL)
+
+#define CRC_COVERED_SIZE (sizeof(NoInitRamHandoff_t) - sizeof(uint32_t))
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+NoInitRamHandoff_t NO_INIT_RAM_handoff __attribute__((section (".no_init_ram.handoff")));
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static uint32_t CalculateCrc(const NoInitRamHandoff_t* handoff)
+{
+    return CRC32_Calculate((const uint8_t*)handoff, CRC_COVERED_SIZE);
+}
+
+static bool IsValid(const NoInitRamHandoff_t* handoff)
+{
+    return (handoff->magic == NO_INIT_RAM_HANDOFF_MAGIC) &&
+           (handoff->version == NO_INIT_RAM_HANDOFF_VERSION) &&
+           (handoff->size == sizeof(NoInitRamHandoff_t)) &&
+           (handoff->areaCount <= NO_INIT_RAM_HANDOFF_AREAS) &&
+           (handoff->crc == CalculateCrc(handoff));
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool NO_INIT_RAM_PublishHandoff(const NoInitRamHandoff_t* handoff)
+{
+    if (IS_NULL(handoff) ||
+        (handoff->areaCount > NO_INIT_RAM_HANDOFF_AREAS))
+    {
+        return false;
+    }
+
+    /* Counter continues from the previous record, also over taken ones */
+    const uint32_t freshness = (NO_INIT_RAM_handoff.size == sizeof(NoInitRamHandoff_t)) 
+                             ? (NO_INIT_RAM_handoff.freshness + 1U) 
+                             : 1U;
+
+    if (handoff != &NO_INIT_RAM_handoff)
+    {
+        memcpy(&NO_INIT_RAM_handoff, handoff, sizeof(NoInitRamHandoff_t));
+    }
+
+    NO_INIT_RAM_handoff.magic = NO_INIT_RAM_HANDOFF_MAGIC;
+    NO_INIT_RAM_handoff.version = NO_INIT_RAM_HANDOFF_VERSION;
+    NO_INIT_RAM_handoff.size = sizeof(NoInitRamHandoff_t);
+    NO_INIT_RAM_handoff.freshness = freshness;
+    NO_INIT_RAM_handoff.crc = CalculateCrc(&NO_INIT_RAM_handoff);
+
+    return true;
+}
+
+bool NO_INIT_RAM_TakeHandoff(NoInitRamHandoff_t* handoff)
+{
+    if (IS_NULL(handoff))
+    {
+        return false;
+    }
+
+    const bool valid = IsValid(&NO_INIT_RAM_handoff);
+
+    if (valid)
+    {
+        memcpy(handoff, &NO_INIT_RAM_handoff, sizeof(NoInitRamHandoff_t));
+    }
+
+    NO_INIT_RAM_InvalidateHandoff();
+
+    return valid;
+}
+
+void NO_INIT_RAM_InvalidateHandoff(void)
+{
+    /* Freshness and size are kept for the next publish */
+    NO_INIT_RAM_handoff.magic = 0U;
+    NO_INIT_RAM_handoff.crc = ~CalculateCrc(&NO_INIT_RAM_handoff);
+}
+
+/* EoF handoff.c */
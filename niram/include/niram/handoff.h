@@ -0,0 +1,124 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * handoff.h
+ *
+ * @brief Verified state handoff between boot stages over soft reset
+ * 
+ * The stage that has verified an image publishes the result before a soft
+ * reset. The next stage takes the record once: a valid record lets it skip
+ * fragment area rescans and signature verification, and taking it invalidates
+ * it so the record never outlives one reset.
+ * 
+ * The record lives in section .no_init_ram.handoff, see no_init_ram.h for the
+ * linker script placement every boot stage must share.
+*/
+
+#ifndef HANDOFF_H_
+#define HANDOFF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+#define NO_INIT_RAM_HANDOFF_MAGIC       (0x4E48414EU)   /* "NAHN" */
+#define NO_INIT_RAM_HANDOFF_VERSION     (1U)
+
+/* Fragment areas tracked in the record */
+#ifndef NO_INIT_RAM_HANDOFF_AREAS
+#define NO_INIT_RAM_HANDOFF_AREAS       (4U)
+#endif
+
+#define NO_INIT_RAM_HANDOFF_NO_INDEX    (0xFFFFFFFFU)
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    /* Header, filled by NO_INIT_RAM_PublishHandoff */
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                  /* sizeof(NoInitRamHandoff_t) */
+    uint32_t freshness;             /* Incremented on every publish */
+
+    /* Verified image */
+    uint32_t firmwareId;            /* Metadata_t firmwareId */
+    uint32_t imageAddress;          /* Metadata_t startAddress */
+    uint32_t imageSize;             /* Metadata_t firmwareSize */
+    uint8_t  imageDigest[64];       /* SHA-512 or signature of the image */
+
+    /* Fragment store state */
+    uint32_t areaCount;
+    uint32_t lastFragmentIndex[NO_INIT_RAM_HANDOFF_AREAS];
+
+    uint32_t crc;
+} NoInitRamHandoff_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC VARIABLE DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+extern NoInitRamHandoff_t NO_INIT_RAM_handoff;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Publish handoff record for the next stage
+ * 
+ * @param handoff Verified image and area state, header and CRC are filled in
+ * @return false if areaCount exceeds NO_INIT_RAM_HANDOFF_AREAS
+ */
+extern bool NO_INIT_RAM_PublishHandoff(const NoInitRamHandoff_t* handoff);
+
+/** Take and invalidate the handoff record
+ * 
+ * @param handoff Output for the record
+ * @return true when the record was valid (magic, version, size and CRC)
+ */
+extern bool NO_INIT_RAM_TakeHandoff(NoInitRamHandoff_t* handoff);
+
+/** Invalidate handoff record, e.g. after a fragment area was modified */
+extern void NO_INIT_RAM_InvalidateHandoff(void);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF handoff.h */
+
+#endif /* HANDOFF_H_ */
@@ -25,6 +25,23 @@
  * no_init_ram.h
  *
  * @brief Shared RAM content
+ * 
+ * No init RAM is shared by images that are built and linked separately, e.g.
+ * a bootloader and an application. Each niram module keeps its data in its
+ * own input section so the linker script, not link order, fixes the layout.
+ * All images must place the sections in this order at the same address:
+ * 
+ *   .no_init_ram (NOLOAD) :
+ *   {
+ *       KEEP(*(.no_init_ram))
+ *       . = ALIGN(8);
+ *       KEEP(*(.no_init_ram.handoff))
+ *       . = ALIGN(8);
+ *       KEEP(*(.no_init_ram.records))
+ *   } > NOINIT_RAM
+ * 
+ * An image that does not use a module must still reserve its space, e.g. by
+ * linking libs::niram with --whole-archive.
 */
 
 #ifndef NO_INIT_RAM_H_
@@ -72,9 +89,14 @@ extern NoInitRamContent_t NO_INIT_RAM_content;
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
 
-
+/** Validate content after reset, clearing it on CRC mismatch */
 extern void NO_INIT_RAM_Init(void);
 
+/** Set member of NO_INIT_RAM_content and recalculate the CRC
+ * 
+ * @param member Member of NO_INIT_RAM_content
+ * @param value New value
+ */
 extern void NO_INIT_RAM_SetMember(uint32_t* member, uint32_t value);
 
 #ifdef __cplusplus
@@ -0,0 +1,136 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * records.h
+ *
+ * @brief Independently CRC-protected typed records in no init RAM
+ * 
+ * Records are stored back to back in a fixed size area of the .no_init_ram
+ * section. Each record has a type ID, payload length and a CRC32 covering
+ * both and the payload, so a corrupted record only loses itself and the
+ * records after it. Writes through NO_INIT_RAM_WriteRecord recalculate the
+ * CRC of that record only.
+ * 
+ * CRCs are checked only by NO_INIT_RAM_RecordsInit, which must be called
+ * after reset before any other function. Other functions trust the list.
+ * 
+ * The area lives in section .no_init_ram.records, see no_init_ram.h for the
+ * linker script placement every boot stage must share.
+*/
+
+#ifndef RECORDS_H_
+#define RECORDS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+/* Size of the record area in bytes, multiple of 4 */
+#ifndef NO_INIT_RAM_RECORDS_SIZE
+#define NO_INIT_RAM_RECORDS_SIZE    (256U)
+#endif
+
+/* Type ID terminating the record list, not usable by applications */
+#define NO_INIT_RAM_RECORD_END      (0U)
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    uint32_t crc;       /* CRC32 of typeId, length and payload */
+    uint16_t typeId;
+    uint16_t length;    /* Payload length in bytes, stored padded to 4 */
+} NoInitRamRecordHeader_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Validate records after reset
+ * 
+ * The list is truncated at the first record failing its CRC. Call once after
+ * reset before using the other functions.
+ * 
+ * @return Number of valid records
+ */
+extern size_t NO_INIT_RAM_RecordsInit(void);
+
+/** Remove all records */
+extern void NO_INIT_RAM_ClearRecords(void);
+
+/** Find existing record
+ * 
+ * @param typeId Record type
+ * @param length Output for payload length, may be NULL
+ * @return Payload or NULL if not found
+ */
+extern const void* NO_INIT_RAM_FindRecord(uint16_t typeId, uint16_t* length);
+
+/** Get record, allocating a zeroed one if it does not exist
+ * 
+ * @param typeId Record type
+ * @param length Payload length
+ * @return Payload or NULL if the area is full or an existing record of the
+ *         type has a different length
+ */
+extern void* NO_INIT_RAM_GetRecord(uint16_t typeId, uint16_t length);
+
+/** Write to record payload and recalculate its CRC
+ * 
+ * @param record Payload from NO_INIT_RAM_GetRecord
+ * @param offset Offset within the payload
+ * @param data Data to write
+ * @param size Bytes to write
+ * @return false if the record or range is invalid
+ */
+extern bool NO_INIT_RAM_WriteRecord(void* record, size_t offset, const void* data, size_t size);
+
+/** Recalculate CRC after modifying the payload directly
+ * 
+ * @param record Payload from NO_INIT_RAM_GetRecord
+ * @return false if the record is invalid
+ */
+extern bool NO_INIT_RAM_CommitRecord(void* record);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF records.h */
+
+#endif /* RECORDS_H_ */
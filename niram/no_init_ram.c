@@ -66,6 +66,7 @@ void NO_INIT_RAM_Init(void)
     if (NO_INIT_RAM_content.crc != actCrc)
     {
         memset(&NO_INIT_RAM_content, 0, sizeof(NO_INIT_RAM_content));
+        NO_INIT_RAM_content.crc = CRC32_Calculate(mem, size);
     }
 }
 
@@ -0,0 +1,277 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * records.c
+ *
+ * @brief Independently CRC-protected typed records in no init RAM
+ * 
+ * A write recalculates the CRC of the changed record only. Records are at
+ * most a few hundred bytes, so this costs no more than updating the CRC from
+ * the changed bytes would.
+ * 
+ * The whole list is CRC checked once in NO_INIT_RAM_RecordsInit. After that
+ * the list only changes through this module, so lookups walk the headers by
+ * their lengths with bounds checks alone.
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "niram/records.h"
+#include "crc/crc32.h"
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) (ptr == NULL)
+
+#define HEADER_SIZE     (sizeof(NoInitRamRecordHeader_t))
+#define CRC_OFFSET      (sizeof(uint32_t))  /* CRC covers header after crc */
+#define PADDED(len)     (((size_t)(len) + 3U) & ~(size_t)3U)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static uint32_t f_records[NO_INIT_RAM_RECORDS_SIZE / sizeof(uint32_t)] __attribute__((section (".no_init_ram.records")));
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static uint8_t* AreaBegin(void)
+{
+    return (uint8_t*)f_records;
+}
+
+static uint8_t* AreaEnd(void)
+{
+    return (uint8_t*)f_records + sizeof(f_records);
+}
+
+static uint32_t CalculateCrc(const NoInitRamRecordHeader_t* header)
+{
+    const uint8_t* covered = (const uint8_t*)header + CRC_OFFSET;
+    return CRC32_Calculate(covered, HEADER_SIZE - CRC_OFFSET + header->length);
+}
+
+static uint8_t* NextRecord(const NoInitRamRecordHeader_t* header)
+{
+    return (uint8_t*)header + HEADER_SIZE + PADDED(header->length);
+}
+
+/* Header of a record within the area, NULL if the list ends here */
+static NoInitRamRecordHeader_t* HeaderAt(uint8_t* pos)
+{
+    if ((AreaEnd() - pos) < (ptrdiff_t)HEADER_SIZE)
+    {
+        return NULL;
+    }
+
+    NoInitRamRecordHeader_t* header = (NoInitRamRecordHeader_t*)pos;
+
+    if ((header->typeId == NO_INIT_RAM_RECORD_END) ||
+        ((AreaEnd() - pos) < (ptrdiff_t)(HEADER_SIZE + PADDED(header->length))))
+    {
+        return NULL;
+    }
+
+    return header;
+}
+
+/* Header of a record with valid CRC, NULL if the list ends here */
+static NoInitRamRecordHeader_t* ValidHeader(uint8_t* pos)
+{
+    NoInitRamRecordHeader_t* header = HeaderAt(pos);
+
+    if (IS_NULL(header) || (header->crc != CalculateCrc(header)))
+    {
+        return NULL;
+    }
+
+    return header;
+}
+
+static void Terminate(uint8_t* pos)
+{
+    if ((AreaEnd() - pos) >= (ptrdiff_t)HEADER_SIZE)
+    {
+        NoInitRamRecordHeader_t* header = (NoInitRamRecordHeader_t*)pos;
+        header->typeId = NO_INIT_RAM_RECORD_END;
+        header->length = 0U;
+        header->crc = 0U;
+    }
+}
+
+/* Header of a payload returned to the user, NULL if not a record */
+static NoInitRamRecordHeader_t* RecordHeader(void* record)
+{
+    uint8_t* pos = AreaBegin();
+    NoInitRamRecordHeader_t* header = HeaderAt(pos);
+
+    while (!IS_NULL(header))
+    {
+        if ((void*)(header + 1) == record)
+        {
+            return header;
+        }
+        pos = NextRecord(header);
+        header = HeaderAt(pos);
+    }
+
+    return NULL;
+}
+
+static NoInitRamRecordHeader_t* FindHeader(uint16_t typeId, uint8_t** end)
+{
+    uint8_t* pos = AreaBegin();
+    NoInitRamRecordHeader_t* header = HeaderAt(pos);
+
+    while (!IS_NULL(header))
+    {
+        if (header->typeId == typeId)
+        {
+            return header;
+        }
+        pos = NextRecord(header);
+        header = HeaderAt(pos);
+    }
+
+    if (!IS_NULL(end))
+    {
+        *end = pos;
+    }
+
+    return NULL;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+size_t NO_INIT_RAM_RecordsInit(void)
+{
+    uint8_t* pos = AreaBegin();
+    NoInitRamRecordHeader_t* header = ValidHeader(pos);
+    size_t count = 0U;
+
+    while (!IS_NULL(header))
+    {
+        pos = NextRecord(header);
+        header = ValidHeader(pos);
+        count++;
+    }
+
+    Terminate(pos);
+
+    return count;
+}
+
+void NO_INIT_RAM_ClearRecords(void)
+{
+    Terminate(AreaBegin());
+}
+
+const void* NO_INIT_RAM_FindRecord(uint16_t typeId, uint16_t* length)
+{
+    const NoInitRamRecordHeader_t* header = FindHeader(typeId, NULL);
+
+    if (IS_NULL(header))
+    {
+        return NULL;
+    }
+
+    if (!IS_NULL(length))
+    {
+        *length = header->length;
+    }
+
+    return header + 1;
+}
+
+void* NO_INIT_RAM_GetRecord(uint16_t typeId, uint16_t length)
+{
+    if (typeId == NO_INIT_RAM_RECORD_END)
+    {
+        return NULL;
+    }
+
+    uint8_t* end = NULL;
+    NoInitRamRecordHeader_t* header = FindHeader(typeId, &end);
+
+    if (!IS_NULL(header))
+    {
+        return (header->length == length) ? (header + 1) : NULL;
+    }
+
+    if ((AreaEnd() - end) < (ptrdiff_t)(HEADER_SIZE + PADDED(length)))
+    {
+        return NULL;
+    }
+
+    header = (NoInitRamRecordHeader_t*)end;
+    header->typeId = typeId;
+    header->length = length;
+    memset(header + 1, 0, PADDED(length));
+    header->crc = CalculateCrc(header);
+
+    Terminate(NextRecord(header));
+
+    return header + 1;
+}
+
+bool NO_INIT_RAM_WriteRecord(void* record, size_t offset, const void* data, size_t size)
+{
+    NoInitRamRecordHeader_t* header = RecordHeader(record);
+
+    if (IS_NULL(header) || IS_NULL(data) ||
+        (offset > header->length) || (size > (header->length - offset)))
+    {
+        return false;
+    }
+
+    memcpy((uint8_t*)record + offset, data, size);
+    header->crc = CalculateCrc(header);
+
+    return true;
+}
+
+bool NO_INIT_RAM_CommitRecord(void* record)
+{
+    NoInitRamRecordHeader_t* header = RecordHeader(record);
+
+    if (IS_NULL(header))
+    {
+        return false;
+    }
+
+    header->crc = CalculateCrc(header);
+
+    return true;
+}
+
+/* EoF records.c */
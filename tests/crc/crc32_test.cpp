@@ -0,0 +1,232 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// crc32_test.cpp
+//
+// Unit tests for the CRC32 engine and its kernels
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <vector>
+
+#include "crc/crc32_parallel.hpp"
+
+extern "C" {
+#include "crc/crc32.h"
+#include "crc/crc32_kernels.h"
+}
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define CHECK_STRING "123456789"
+#define CHECK_VALUE (0xCBF43926U)
+
+// -----------------------------------------------------------------------------
+// VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static size_t test_customKernelCalls;
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static std::vector<uint8_t> MakeRandomBuffer(size_t size)
+{
+    std::vector<uint8_t> buf(size);
+    for (auto& b: buf)
+    {
+        b = (uint8_t)rand();
+    }
+    return buf;
+}
+
+static uint32_t RunKernel(Crc32Kernel_t kernel, const uint8_t* data, size_t len)
+{
+    return ~kernel(~0U, data, len);
+}
+
+// -----------------------------------------------------------------------------
+// MOCK FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static uint32_t TestCustomKernel(uint32_t crc, const uint8_t* data, size_t len)
+{
+    test_customKernelCalls++;
+    return CRC32_KernelBitwise(crc, data, len);
+}
+
+// -----------------------------------------------------------------------------
+// TEST SUITE DEFINITION
+// -----------------------------------------------------------------------------
+
+static void InitTestSuite()
+{
+    CRC32_SetKernel(NULL);
+    test_customKernelCalls = 0U;
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Check value")
+{
+    InitTestSuite();
+
+    const uint8_t* data = (const uint8_t*)CHECK_STRING;
+    const size_t len = strlen(CHECK_STRING);
+
+    REQUIRE(CRC32_Calculate(data, len) == CHECK_VALUE);
+    REQUIRE(RunKernel(&CRC32_KernelBitwise, data, len) == CHECK_VALUE);
+    REQUIRE(RunKernel(&CRC32_KernelTable, data, len) == CHECK_VALUE);
+    REQUIRE(RunKernel(&CRC32_KernelPclmul, data, len) == CHECK_VALUE);
+    REQUIRE(RunKernel(&CRC32_KernelArmv8, data, len) == CHECK_VALUE);
+}
+
+TEST_CASE("Empty input")
+{
+    InitTestSuite();
+
+    REQUIRE(CRC32_Calculate(nullptr, 0U) == 0U);
+    REQUIRE(CRC32_Calculate(nullptr, 10U) == 0U);
+    REQUIRE(CRC32_Update(CHECK_VALUE, nullptr, 0U) == CHECK_VALUE);
+}
+
+TEST_CASE("All kernels are equal")
+{
+    InitTestSuite();
+
+    const auto buf = MakeRandomBuffer(4096U + 64U);
+    const Crc32Kernel_t kernels[] = {
+        &CRC32_KernelTable,
+        &CRC32_KernelPclmul,
+        &CRC32_KernelArmv8
+    };
+
+    for (size_t offset = 0U; offset < 16U; offset++)
+    {
+        for (size_t len = 0U; len <= 4096U; len += ((len < 300U) ? 1U : 61U))
+        {
+            const uint8_t* data = &buf[offset];
+            const uint32_t expected = RunKernel(&CRC32_KernelBitwise, data, len);
+
+            for (const auto kernel: kernels)
+            {
+                REQUIRE(RunKernel(kernel, data, len) == expected);
+            }
+            REQUIRE(CRC32_Calculate(data, len) == expected);
+        }
+    }
+}
+
+TEST_CASE("Update in parts")
+{
+    InitTestSuite();
+
+    const auto buf = MakeRandomBuffer(10000U);
+    const uint32_t expected = CRC32_Calculate(buf.data(), buf.size());
+
+    for (size_t split = 0U; split <= buf.size(); split += 777U)
+    {
+        uint32_t crc = CRC32_Update(0U, buf.data(), split);
+        crc = CRC32_Update(crc, &buf[split], buf.size() - split);
+        REQUIRE(crc == expected);
+    }
+}
+
+TEST_CASE("Custom kernel")
+{
+    InitTestSuite();
+
+    const uint8_t* data = (const uint8_t*)CHECK_STRING;
+    const size_t len = strlen(CHECK_STRING);
+
+    CRC32_SetKernel(&TestCustomKernel);
+    REQUIRE(0 == strcmp(CRC32_GetKernelName(), "custom"));
+    REQUIRE(CRC32_Calculate(data, len) == CHECK_VALUE);
+    REQUIRE(test_customKernelCalls == 1U);
+
+    CRC32_SetKernel(NULL);
+    REQUIRE(0 != strcmp(CRC32_GetKernelName(), "custom"));
+    REQUIRE(CRC32_Calculate(data, len) == CHECK_VALUE);
+    REQUIRE(test_customKernelCalls == 1U);
+}
+
+TEST_CASE("Combine")
+{
+    InitTestSuite();
+
+    const auto buf = MakeRandomBuffer(5000U);
+    const uint32_t expected = CRC32_Calculate(buf.data(), buf.size());
+
+    for (size_t split = 0U; split <= buf.size(); split += 333U)
+    {
+        const size_t lenB = buf.size() - split;
+        const uint32_t crcA = CRC32_Calculate(buf.data(), split);
+        const uint32_t crcB = CRC32_Calculate(&buf[split], lenB);
+
+        REQUIRE(CRC32_Combine(crcA, crcB, lenB) == expected);
+        REQUIRE(CRC32_CombineOp(crcA, crcB, CRC32_CombineGen(lenB)) == expected);
+    }
+
+    WHEN("Combining equal sized blocks")
+    {
+        const size_t blockSize = 500U;
+        const uint32_t op = CRC32_CombineGen(blockSize);
+        uint32_t crc = 0U;
+
+        for (size_t pos = 0U; pos < buf.size(); pos += blockSize)
+        {
+            crc = CRC32_CombineOp(crc, CRC32_Calculate(&buf[pos], blockSize), op);
+        }
+
+        REQUIRE(crc == expected);
+    }
+}
+
+TEST_CASE("Parallel calculation")
+{
+    InitTestSuite();
+
+    const auto buf = MakeRandomBuffer((8U * Crc32::PARALLEL_MIN_CHUNK) + 12345U);
+    const uint32_t expected = CRC32_Calculate(buf.data(), buf.size());
+
+    for (size_t threads = 0U; threads <= 5U; threads++)
+    {
+        REQUIRE(Crc32::CalculateParallel(buf.data(), buf.size(), threads) == expected);
+    }
+
+    REQUIRE(Crc32::CalculateParallel(buf.data(), 100U, 4U) == CRC32_Calculate(buf.data(), 100U));
+}
+
+// EoF crc32_test.cpp
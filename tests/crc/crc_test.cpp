@@ -0,0 +1,163 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// crc_test.cpp
+//
+// Unit tests for the header-only CRC engine
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+#include "crc/crc.hpp"
+
+extern "C" {
+#include "crc/crc32.h"
+}
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define CHECK_STRING "123456789"
+
+/* Check values from the CRC RevEng catalogue */
+static_assert(Crc::Crc32::Calculate(CHECK_STRING) == 0xCBF43926U);
+static_assert(Crc::Crc32C::Calculate(CHECK_STRING) == 0xE3069283U);
+static_assert(Crc::Crc32Mpeg2::Calculate(CHECK_STRING) == 0x0376E6E7U);
+static_assert(Crc::Crc16Ccitt::Calculate(CHECK_STRING) == 0x29B1U);
+static_assert(Crc::Crc8::Calculate(CHECK_STRING) == 0xF4U);
+static_assert(Crc::Crc64::Calculate(CHECK_STRING) == 0x995DC9BBDF1939FAU);
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static std::vector<uint8_t> MakeRandomBuffer(size_t size)
+{
+    std::vector<uint8_t> buf(size);
+    for (auto& b: buf)
+    {
+        b = (uint8_t)rand();
+    }
+    return buf;
+}
+
+/* Compare slice-by-N against the byte-wise variant of the same model */
+template <typename Sliced, typename Bytewise>
+static void CheckSlicing(const std::vector<uint8_t>& buf)
+{
+    for (size_t offset = 0U; offset < 8U; offset++)
+    {
+        for (size_t len = 0U; len < 64U; len++)
+        {
+            REQUIRE(Sliced::Calculate(&buf[offset], len) == Bytewise::Calculate(&buf[offset], len));
+        }
+    }
+
+    REQUIRE(Sliced::Calculate(buf.data(), buf.size()) == Bytewise::Calculate(buf.data(), buf.size()));
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Check values")
+{
+    REQUIRE(Crc::Crc32::Calculate(CHECK_STRING) == 0xCBF43926U);
+    REQUIRE(Crc::Crc32C::Calculate(CHECK_STRING) == 0xE3069283U);
+    REQUIRE(Crc::Crc32Mpeg2::Calculate(CHECK_STRING) == 0x0376E6E7U);
+    REQUIRE(Crc::Crc16Ccitt::Calculate(CHECK_STRING) == 0x29B1U);
+    REQUIRE(Crc::Crc8::Calculate(CHECK_STRING) == 0xF4U);
+    REQUIRE(Crc::Crc64::Calculate(CHECK_STRING) == 0x995DC9BBDF1939FAU);
+
+    /* CRC-16/ARC and CRC-16/MODBUS, reflected 16-bit models */
+    REQUIRE((Crc::Engine<uint16_t, 16U, 0x8005U, 0x0000U, true, 0x0000U>::Calculate(CHECK_STRING)) == 0xBB3DU);
+    REQUIRE((Crc::Engine<uint16_t, 16U, 0x8005U, 0xFFFFU, true, 0x0000U>::Calculate(CHECK_STRING)) == 0x4B37U);
+
+    /* CRC-24/OPENPGP, width narrower than the register type */
+    REQUIRE((Crc::Engine<uint32_t, 24U, 0x864CFBU, 0xB704CEU, false, 0x000000U>::Calculate(CHECK_STRING)) == 0x21CF02U);
+}
+
+TEST_CASE("Table is classic byte-wise table")
+{
+    const uint8_t byte = 0x80U;
+    REQUIRE(Crc::Crc32::TABLE[0][1] == 0x77073096U);
+    REQUIRE(Crc::Crc32::TABLE[0][255] == 0x2D02EF8DU);
+    REQUIRE(Crc::Crc32::Calculate(&byte, 1U) == CRC32_Calculate(&byte, 1U));
+}
+
+TEST_CASE("Matches CRC32 engine")
+{
+    const auto buf = MakeRandomBuffer(4096U + 16U);
+
+    for (size_t offset = 0U; offset < 16U; offset++)
+    {
+        for (size_t len = 0U; len <= 4096U; len += 1U + (len / 8U))
+        {
+            REQUIRE(Crc::Crc32::Calculate(&buf[offset], len) == CRC32_Calculate(&buf[offset], len));
+        }
+    }
+}
+
+TEST_CASE("Slice count does not change result")
+{
+    const auto buf = MakeRandomBuffer(1000U);
+
+    CheckSlicing<Crc::Crc32, Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, true, 0xFFFFFFFFU, 1U>>(buf);
+    CheckSlicing<
+        Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, true, 0xFFFFFFFFU, 2U>, 
+        Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, true, 0xFFFFFFFFU, 1U>>(buf);
+    CheckSlicing<Crc::Crc32Mpeg2, Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, false, 0x00000000U, 1U>>(buf);
+    CheckSlicing<
+        Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, false, 0x00000000U, 3U>, 
+        Crc::Engine<uint32_t, 32U, 0x04C11DB7U, 0xFFFFFFFFU, false, 0x00000000U, 1U>>(buf);
+    CheckSlicing<Crc::Crc16Ccitt, Crc::Engine<uint16_t, 16U, 0x1021U, 0xFFFFU, false, 0x0000U, 1U>>(buf);
+    CheckSlicing<Crc::Crc64, Crc::Engine<uint64_t, 64U, 0x42F0E1EBA9EA3693U, ~0ULL, true, ~0ULL, 1U>>(buf);
+    CheckSlicing<
+        Crc::Engine<uint64_t, 64U, 0x42F0E1EBA9EA3693U, ~0ULL, true, ~0ULL, 4U>, 
+        Crc::Engine<uint64_t, 64U, 0x42F0E1EBA9EA3693U, ~0ULL, true, ~0ULL, 1U>>(buf);
+}
+
+TEST_CASE("Update in parts")
+{
+    const auto buf = MakeRandomBuffer(777U);
+
+    for (size_t split = 0U; split <= buf.size(); split += 37U)
+    {
+        const uint32_t crc = Crc::Crc32C::Calculate(buf.data(), split);
+        REQUIRE(Crc::Crc32C::Update(crc, &buf[split], buf.size() - split) == Crc::Crc32C::Calculate(buf.data(), buf.size()));
+
+        const uint16_t crc16 = Crc::Crc16Ccitt::Calculate(buf.data(), split);
+        REQUIRE(Crc::Crc16Ccitt::Update(crc16, &buf[split], buf.size() - split) == Crc::Crc16Ccitt::Calculate(buf.data(), buf.size()));
+    }
+
+    /* Same seed convention as CRC32_Update() */
+    REQUIRE(Crc::Crc32::Update(0U, buf.data(), buf.size()) == CRC32_Update(0U, buf.data(), buf.size()));
+}
@@ -33,10 +33,12 @@
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
+#include <cstring>
 
 extern "C" {
 #include "ed25519.h"
 #include "ed25519_extra.h"
+#include "ed25519_keyring.h"
 }
 
 // -----------------------------------------------------------------------------
@@ -110,4 +112,112 @@ TEST_CASE("ed25519")
     }
 }
 
+TEST_CASE("ed25519 precomputed key")
+{
+    InitTestSuite();
+
+    uint8_t buf[1024];
+    FillRandomBytes(buf, sizeof(buf));
+
+    uint8_t signature[64];
+    ed25519_sign(signature, buf, sizeof(buf), PUBLIC_KEY, PRIVATE_KEY);
+
+    ed25519_precomputed_key_t key;
+    REQUIRE(1 == ed25519_precompute_key(&key, PUBLIC_KEY));
+
+    SECTION("Single call")
+    {
+        REQUIRE(1 == ed25519_verify_precomputed(signature, buf, sizeof(buf), &key));
+
+        buf[100] ^= 1U;
+        REQUIRE(0 == ed25519_verify_precomputed(signature, buf, sizeof(buf), &key));
+    }
+    SECTION("Multi part")
+    {
+        ed25519_multipart_t ctx;
+        REQUIRE(1 == ed25519_multipart_init_precomputed(&ctx, signature, &key));
+        REQUIRE(1 == ed25519_multipart_continue(&ctx, buf, 100U));
+        REQUIRE(1 == ed25519_multipart_continue(&ctx, &buf[100], sizeof(buf) - 100U));
+        REQUIRE(1 == ed25519_multipart_end(&ctx));
+    }
+}
+
+TEST_CASE("ed25519 keyring")
+{
+    uint8_t pubA[32], privA[64], pubB[32], privB[64], seed[32];
+
+    REQUIRE(ed25519_create_seed(seed) == 0);
+    ed25519_create_keypair(pubA, privA, seed);
+    REQUIRE(ed25519_create_seed(seed) == 0);
+    ed25519_create_keypair(pubB, privB, seed);
+
+    /* IDs 10 and 21 map to slots 1 and 0 of a 3 entry table */
+    ed25519_keyring_entry_t entries[3];
+    memset(entries, 0, sizeof(entries));
+    entries[1].key_id = 10U;
+    entries[1].in_use = 1U;
+    REQUIRE(1 == ed25519_precompute_key(&entries[1].key, pubA));
+    entries[0].key_id = 21U;
+    entries[0].in_use = 1U;
+    REQUIRE(1 == ed25519_precompute_key(&entries[0].key, pubB));
+
+    const ed25519_keyring_t ring = {entries, 3U};
+
+    uint8_t buf[256];
+    FillRandomBytes(buf, sizeof(buf));
+
+    uint8_t sigA[64], sigB[64];
+    ed25519_sign(sigA, buf, sizeof(buf), pubA, privA);
+    ed25519_sign(sigB, buf, sizeof(buf), pubB, privB);
+
+    REQUIRE(ed25519_keyring_find(&ring, 10U) == &entries[1].key);
+    REQUIRE(ed25519_keyring_find(&ring, 21U) == &entries[0].key);
+    REQUIRE(ed25519_keyring_find(&ring, 2U) == NULL);   /* Empty slot */
+    REQUIRE(ed25519_keyring_find(&ring, 13U) == NULL);  /* Occupied by other ID */
+
+    REQUIRE(1 == ed25519_keyring_verify(&ring, 10U, sigA, buf, sizeof(buf)));
+    REQUIRE(1 == ed25519_keyring_verify(&ring, 21U, sigB, buf, sizeof(buf)));
+    REQUIRE(0 == ed25519_keyring_verify(&ring, 21U, sigA, buf, sizeof(buf)));
+    REQUIRE(0 == ed25519_keyring_verify(&ring, 2U, sigA, buf, sizeof(buf)));
+}
+
+TEST_CASE("ed25519 keyring build")
+{
+    uint8_t pub[32], priv[64], seed[32];
+
+    REQUIRE(ed25519_create_seed(seed) == 0);
+    ed25519_create_keypair(pub, priv, seed);
+
+    ed25519_keyring_entry_t keys[3];
+    memset(keys, 0, sizeof(keys));
+    REQUIRE(1 == ed25519_precompute_key(&keys[1].key, pub));
+
+    /* 6 and 3 share an index in a table of 3 */
+    keys[0].key_id = 6U;
+    keys[1].key_id = 8U;
+    keys[2].key_id = 3U;
+
+    const size_t size = ed25519_keyring_table_size(keys, 3U);
+    REQUIRE(size == 4U);
+
+    ed25519_keyring_entry_t table[8];
+    ed25519_keyring_t ring = {NULL, 0U};
+
+    REQUIRE(1 == ed25519_keyring_build(&ring, table, size, keys, 3U));
+    REQUIRE(ring.entries == table);
+    REQUIRE(ring.size == size);
+    REQUIRE(ed25519_keyring_find(&ring, 8U) == &table[0].key);
+    REQUIRE(ed25519_keyring_find(&ring, 6U) == &table[2].key);
+    REQUIRE(ed25519_keyring_find(&ring, 3U) == &table[3].key);
+    REQUIRE(ed25519_keyring_find(&ring, 5U) == NULL);
+    REQUIRE(0 == memcmp(table[0].key.public_key, pub, sizeof(pub)));
+    REQUIRE(table[1].in_use == 0U);
+
+    /* Too small a table or a duplicate ID fails */
+    REQUIRE(0 == ed25519_keyring_build(&ring, table, 2U, keys, 3U));
+    keys[2].key_id = 6U;
+    REQUIRE(ed25519_keyring_table_size(keys, 3U) == 0U);
+    REQUIRE(ed25519_keyring_table_size(keys, 0U) == 0U);
+}
+
 // EoF ed25519_tests.cpp
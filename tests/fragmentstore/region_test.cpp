@@ -0,0 +1,199 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// region_test.cpp
+//
+// Unit tests for streaming region checksums
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+extern "C" {
+#include "imitation_flash.h"
+#include "fragmentstore/region.h"
+#include "crc/crc32.h"
+}
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define KB (1024)
+#define SECTOR_SIZE (4 * KB)
+#define BASE_ADDRESS (0x1000U)
+
+// -----------------------------------------------------------------------------
+// VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+uint8_t TEST_FLASH_MEMORY[64 * KB];
+
+static size_t test_readCalls;
+static size_t test_maxReadSize;
+
+// -----------------------------------------------------------------------------
+// MOCK FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static bool CountingRead(Address_t address, size_t size, uint8_t* out)
+{
+    test_readCalls++;
+    test_maxReadSize = (size > test_maxReadSize) ? size : test_maxReadSize;
+    return FLASH_Read(address - BASE_ADDRESS, size, out);
+}
+
+static bool AbortAfterFirst(void* ctx, const uint8_t* data, size_t len)
+{
+    (void)data;
+    (void)len;
+    size_t* calls = (size_t*)ctx;
+    (*calls)++;
+    return *calls < 2U;
+}
+
+// -----------------------------------------------------------------------------
+// TEST SUITE DEFINITION
+// -----------------------------------------------------------------------------
+
+static void InitTestSuite(MemoryConfig_t& memConf)
+{
+    FLASH_SetMemory(TEST_FLASH_MEMORY, sizeof(TEST_FLASH_MEMORY), SECTOR_SIZE);
+
+    for (size_t i = 0; i < sizeof(TEST_FLASH_MEMORY); i++)
+    {
+        TEST_FLASH_MEMORY[i] = (uint8_t)rand();
+    }
+
+    memConf.baseAddress = BASE_ADDRESS;
+    memConf.sectorSize = SECTOR_SIZE;
+    memConf.memorySize = sizeof(TEST_FLASH_MEMORY);
+    memConf.eraseValue = 0xFFU;
+    memConf.Reader = &CountingRead;
+    memConf.Writer = NULL;
+    memConf.Eraser = NULL;
+
+    test_readCalls = 0U;
+    test_maxReadSize = 0U;
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Region CRC32 equals RAM CRC32")
+{
+    MemoryConfig_t memConf;
+    InitTestSuite(memConf);
+
+    const size_t chunkSizes[] = {1U, 7U, 256U, 4096U, 64U * KB};
+    const size_t offsets[] = {0U, 1U, 100U, 4095U};
+    const size_t sizes[] = {0U, 1U, 255U, 256U, 10000U};
+    static uint8_t chunk[64 * KB];
+
+    for (size_t chunkSize: chunkSizes)
+    {
+        for (size_t offset: offsets)
+        {
+            for (size_t size: sizes)
+            {
+                uint32_t crc = 0U;
+                test_maxReadSize = 0U;
+                REQUIRE(REGION_Crc32(&memConf, BASE_ADDRESS + offset, size, chunk, chunkSize, &CRC32_Update, &crc));
+                REQUIRE(crc == CRC32_Calculate(&TEST_FLASH_MEMORY[offset], size));
+                REQUIRE(test_maxReadSize <= chunkSize);
+            }
+        }
+    }
+}
+
+TEST_CASE("Region CRC32 continues over regions")
+{
+    MemoryConfig_t memConf;
+    InitTestSuite(memConf);
+
+    uint8_t chunk[256];
+    uint32_t crc = 0U;
+
+    REQUIRE(REGION_Crc32(&memConf, BASE_ADDRESS, 1000U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE(REGION_Crc32(&memConf, BASE_ADDRESS + 1000U, 3000U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE(crc == CRC32_Calculate(TEST_FLASH_MEMORY, 4000U));
+    REQUIRE(test_readCalls == (4U + 12U));
+}
+
+TEST_CASE("Region whole memory")
+{
+    MemoryConfig_t memConf;
+    InitTestSuite(memConf);
+
+    uint8_t chunk[SECTOR_SIZE];
+    uint32_t crc = 0U;
+
+    REQUIRE(REGION_Crc32(&memConf, BASE_ADDRESS, sizeof(TEST_FLASH_MEMORY), chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE(crc == CRC32_Calculate(TEST_FLASH_MEMORY, sizeof(TEST_FLASH_MEMORY)));
+    REQUIRE(test_readCalls == (sizeof(TEST_FLASH_MEMORY) / SECTOR_SIZE));
+}
+
+TEST_CASE("Region invalid parameters")
+{
+    MemoryConfig_t memConf;
+    InitTestSuite(memConf);
+
+    uint8_t chunk[256];
+    uint32_t crc = 0U;
+    const Address_t end = BASE_ADDRESS + sizeof(TEST_FLASH_MEMORY);
+
+    REQUIRE_FALSE(REGION_Crc32(NULL, BASE_ADDRESS, 1U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS, 1U, NULL, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS, 1U, chunk, 0U, &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS, 1U, chunk, sizeof(chunk), NULL, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS, 1U, chunk, sizeof(chunk), &CRC32_Update, NULL));
+
+    /* Outside memory */
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS - 1U, 1U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, end - 1U, 2U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, end + 1U, 0U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE_FALSE(REGION_Crc32(&memConf, BASE_ADDRESS + 1U, SIZE_MAX, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE(test_readCalls == 0U);
+
+    REQUIRE(REGION_Crc32(&memConf, end - 1U, 1U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+    REQUIRE(REGION_Crc32(&memConf, end, 0U, chunk, sizeof(chunk), &CRC32_Update, &crc));
+}
+
+TEST_CASE("Region consumer abort")
+{
+    MemoryConfig_t memConf;
+    InitTestSuite(memConf);
+
+    uint8_t chunk[256];
+    size_t calls = 0U;
+
+    REQUIRE_FALSE(REGION_Stream(&memConf, BASE_ADDRESS, 4096U, chunk, sizeof(chunk), &AbortAfterFirst, &calls));
+    REQUIRE(calls == 2U);
+    REQUIRE(test_readCalls == 2U);
+}
@@ -0,0 +1,155 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// wire_test.cpp
+//
+// Unit tests for the compact fragment transfer encoding
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "fragmentstore/wire.h"
+}
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define CONTENT_SIZE (sizeof(((Fragment_t*)NULL)->content))
+#define OVERHEAD (sizeof(Fragment_t) - CONTENT_SIZE)
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static Fragment_t MakeFragment(uint32_t size)
+{
+    Fragment_t frag;
+    memset(&frag, 0, sizeof(frag));
+
+    frag.firmwareId = 0x12345678U;
+    frag.number = 7U;
+    frag.startAddress = 0x08010000U;
+    frag.size = size;
+    frag.verifyMethod = 1U;
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        frag.content[i] = (uint8_t)(i * 5U + 1U);
+    }
+    for (size_t i = 0; i < sizeof(frag.signature); i++)
+    {
+        frag.signature[i] = (uint8_t)(0xA0U + i);
+    }
+
+    return frag;
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Wire: round trip")
+{
+    const uint32_t size = GENERATE(0U, 1U, 100U, (uint32_t)CONTENT_SIZE - 1U, (uint32_t)CONTENT_SIZE);
+    const Fragment_t frag = MakeFragment(size);
+
+    std::vector<uint8_t> wire(sizeof(Fragment_t));
+    const size_t len = WIRE_EncodeFragment(&frag, wire.data(), wire.size());
+
+    REQUIRE(len == OVERHEAD + size);
+    REQUIRE(len == WIRE_FragmentSize(&frag));
+
+    Fragment_t decoded;
+    memset(&decoded, 0xCC, sizeof(decoded));
+    REQUIRE(WIRE_DecodeFragment(wire.data(), len, &decoded));
+    REQUIRE(memcmp(&decoded, &frag, sizeof(Fragment_t)) == 0);
+}
+
+TEST_CASE("Wire: decode in place")
+{
+    const uint32_t size = GENERATE(0U, 1U, 100U, (uint32_t)CONTENT_SIZE - 1U, (uint32_t)CONTENT_SIZE);
+    const Fragment_t frag = MakeFragment(size);
+
+    // Receive buffer with stale data in the padding area
+    Fragment_t buffer;
+    memset(&buffer, 0xCC, sizeof(buffer));
+    uint8_t* data = (uint8_t*)&buffer;
+
+    const size_t len = WIRE_EncodeFragment(&frag, data, sizeof(buffer));
+    REQUIRE(len == OVERHEAD + size);
+
+    REQUIRE(WIRE_DecodeFragmentInPlace(data, len, sizeof(buffer) - 1U) == NULL);
+    REQUIRE(WIRE_DecodeFragmentInPlace(data, len - 1U, sizeof(buffer)) == NULL);
+
+    const Fragment_t* decoded = WIRE_DecodeFragmentInPlace(data, len, sizeof(buffer));
+    REQUIRE(decoded == &buffer);
+    REQUIRE(memcmp(decoded, &frag, sizeof(Fragment_t)) == 0);
+}
+
+TEST_CASE("Wire: full size fragment accepted")
+{
+    const Fragment_t frag = MakeFragment(10U);
+
+    Fragment_t decoded;
+    REQUIRE(WIRE_DecodeFragment((const uint8_t*)&frag, sizeof(frag), &decoded));
+    REQUIRE(memcmp(&decoded, &frag, sizeof(Fragment_t)) == 0);
+}
+
+TEST_CASE("Wire: invalid input")
+{
+    Fragment_t frag = MakeFragment(100U);
+    std::vector<uint8_t> wire(sizeof(Fragment_t));
+    Fragment_t decoded;
+
+    SECTION("Too small buffer")
+    {
+        REQUIRE(WIRE_EncodeFragment(&frag, wire.data(), OVERHEAD + 99U) == 0U);
+    }
+    SECTION("Size over content")
+    {
+        frag.size = CONTENT_SIZE + 1U;
+        REQUIRE(WIRE_FragmentSize(&frag) == 0U);
+        REQUIRE(WIRE_EncodeFragment(&frag, wire.data(), wire.size()) == 0U);
+        REQUIRE_FALSE(WIRE_DecodeFragment((const uint8_t*)&frag, sizeof(frag), &decoded));
+    }
+    SECTION("Length mismatch")
+    {
+        const size_t len = WIRE_EncodeFragment(&frag, wire.data(), wire.size());
+        REQUIRE(len != 0U);
+        REQUIRE_FALSE(WIRE_DecodeFragment(wire.data(), len - 1U, &decoded));
+        REQUIRE_FALSE(WIRE_DecodeFragment(wire.data(), len + 1U, &decoded));
+        REQUIRE_FALSE(WIRE_DecodeFragment(wire.data(), OVERHEAD - 1U, &decoded));
+    }
+}
+
+// EoF wire_test.cpp
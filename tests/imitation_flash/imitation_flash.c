@@ -24,110 +24,476 @@
  *
  * imitation_flash.c
  *
- * @brief {Short description of the source file}
+ * @brief Imitation NOR flash devices on host memory
 */
 
 /*----------------------------------------------------------------------------*/
 /* INCLUDE DIRECTIVES                                                         */
 /*----------------------------------------------------------------------------*/
 
+#if !defined(_WIN32)
+/* mmap, fallocate and 64 bit file offsets */
+#define _GNU_SOURCE
+#define _FILE_OFFSET_BITS 64
+#endif
+
 #include "imitation_flash.h"
 #include <string.h>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define ERASE_VALUE (0xFFU)
+
 /*----------------------------------------------------------------------------*/
 /* VARIABLE DEFINITIONS                                                       */
 /*----------------------------------------------------------------------------*/
 
-static uint8_t* f_mem = NULL;
-static size_t f_size = 0U;
-static size_t f_sectorSize = 0U;
-static bool f_lock = false;
+static ImitationFlash_t f_instance;
+
+const ImitationFlashModel_t IMITATION_FLASH_MODEL_SPI_NOR = {
+    .pageSize = 256U,
+    .programUsPerPage = 400U,
+    .eraseUsPerSector = 45000U,
+    .readNsPerByte = 20U,
+    .endurance = 100000U,
+    .programErrorInterval = 0U,
+    .realTime = false,
+};
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /*----------------------------------------------------------------------------*/
 
-static inline bool CheckAccess(uint32_t address, size_t size)
+/* Busy flag, MSVC has no __atomic builtins */
+static bool TryLock(volatile long* flag)
+{
+#if !defined(_WIN32)
+    return 0L == __atomic_exchange_n(flag, 1L, __ATOMIC_ACQUIRE);
+#else
+    return 0L == InterlockedExchange(flag, 1L);
+#endif
+}
+
+static void ClearLock(volatile long* flag)
+{
+#if !defined(_WIN32)
+    __atomic_store_n(flag, 0L, __ATOMIC_RELEASE);
+#else
+    (void)InterlockedExchange(flag, 0L);
+#endif
+}
+
+static inline bool CheckAccess(const ImitationFlash_t* inst, uint32_t address, size_t size)
+{
+    return (address < inst->size) && (size <= (inst->size - address));
+}
+
+static inline uint8_t GetByte(const ImitationFlash_t* inst, size_t address)
+{
+    return inst->inverted ? (uint8_t)~inst->mem[address] : inst->mem[address];
+}
+
+static inline void SetByte(ImitationFlash_t* inst, size_t address, uint8_t value)
 {
-    return (address < f_size) && ((address + size) <= f_size);
+    inst->mem[address] = inst->inverted ? (uint8_t)~value : value;
+}
+
+/* Advance the virtual clock */
+static void Spend(ImitationFlash_t* inst, uint64_t ns)
+{
+    inst->stats.timeNs += ns;
+
+    if (!inst->model->realTime || (ns == 0U))
+    {
+        return;
+    }
+
+#if !defined(_WIN32)
+    struct timespec ts;
+    ts.tv_sec = (time_t)(ns / 1000000000U);
+    ts.tv_nsec = (long)(ns % 1000000000U);
+    while ((0 != nanosleep(&ts, &ts)))
+    {
+        /* Interrupted, sleep the rest */
+    }
+#else
+    Sleep((DWORD)((ns + 999999U) / 1000000U));
+#endif
+}
+
+/* Set range to erased, releasing whole pages of a backing file */
+static void EraseRange(ImitationFlash_t* inst, size_t address, size_t size)
+{
+    if (!inst->inverted)
+    {
+        memset(&inst->mem[address], ERASE_VALUE, size);
+        return;
+    }
+
+#if defined(__linux__)
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t first = ((address + page - 1U) / page) * page;
+    const size_t last = ((address + size) / page) * page;
+
+    if ((first < last) &&
+        (0 == fallocate(inst->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, (off_t)first, (off_t)(last - first))))
+    {
+        memset(&inst->mem[address], 0, first - address);
+        memset(&inst->mem[last], 0, (address + size) - last);
+        return;
+    }
+#endif
+
+    memset(&inst->mem[address], 0, size);
 }
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /*----------------------------------------------------------------------------*/
 
-void FLASH_SetMemory(uint8_t* mem, size_t memorySize, size_t sectorSize)
+void FLASH_INSTANCE_Init(
+    ImitationFlash_t* inst,
+    uint8_t* mem,
+    size_t memorySize,
+    size_t sectorSize
+)
 {
-    f_mem = mem;
-    f_size = memorySize;
-    f_sectorSize = sectorSize;
+    inst->mem = mem;
+    inst->size = memorySize;
+    inst->sectorSize = sectorSize;
+    inst->inverted = false;
+    inst->fd = -1;
+    inst->model = NULL;
+    inst->eraseCounts = NULL;
+    inst->eraseCountsSize = 0U;
+    memset(&inst->stats, 0, sizeof(inst->stats));
+    ClearLock(&inst->busy);
 }
 
-void FLASH_Fill(uint8_t value)
+bool FLASH_INSTANCE_SetModel(
+    ImitationFlash_t* inst,
+    const ImitationFlashModel_t* model,
+    uint32_t* eraseCounts,
+    size_t eraseCountsSize
+)
 {
-    memset(f_mem, value, f_size);
+    if ((NULL != eraseCounts) &&
+        ((inst->sectorSize == 0U) || (eraseCountsSize < (inst->size / inst->sectorSize))))
+    {
+        return false;
+    }
+
+    inst->model = model;
+    inst->eraseCounts = eraseCounts;
+    inst->eraseCountsSize = (NULL != eraseCounts) ? eraseCountsSize : 0U;
+    memset(&inst->stats, 0, sizeof(inst->stats));
+
+    if (NULL != eraseCounts)
+    {
+        memset(eraseCounts, 0, eraseCountsSize * sizeof(uint32_t));
+    }
+
+    return true;
 }
 
-bool FLASH_Lock(void)
+uint32_t FLASH_INSTANCE_EraseCount(const ImitationFlash_t* inst, uint32_t address)
 {
-    if (f_lock)
+    if ((NULL == inst->eraseCounts) ||
+        (inst->sectorSize == 0U) ||
+        ((address / inst->sectorSize) >= inst->eraseCountsSize))
     {
+        return 0U;
+    }
+
+    return inst->eraseCounts[address / inst->sectorSize];
+}
+
+bool FLASH_INSTANCE_InjectBitError(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    uint8_t mask
+)
+{
+    if (CheckAccess(inst, address, 1U) && FLASH_INSTANCE_Lock(inst))
+    {
+        SetByte(inst, address, GetByte(inst, address) ^ mask);
+        FLASH_INSTANCE_Unlock(inst);
+        return true;
+    }
+
+    return false;
+}
+
+bool FLASH_INSTANCE_OpenFile(
+    ImitationFlash_t* inst,
+    const char* path,
+    size_t memorySize,
+    size_t sectorSize
+)
+{
+#if !defined(_WIN32)
+    struct stat st;
+    const int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    /* Extending leaves a hole, which reads erased */
+    if ((0 != fstat(fd, &st)) ||
+        (((uint64_t)st.st_size < memorySize) && (0 != ftruncate(fd, (off_t)memorySize))))
+    {
+        close(fd);
         return false;
     }
 
-    f_lock = true;
+    void* mem = mmap(NULL, memorySize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == mem)
+    {
+        close(fd);
+        return false;
+    }
+
+    FLASH_INSTANCE_Init(inst, (uint8_t*)mem, memorySize, sectorSize);
+    inst->inverted = true;
+    inst->fd = fd;
     return true;
+#else
+    (void)inst;
+    (void)path;
+    (void)memorySize;
+    (void)sectorSize;
+    return false;
+#endif
 }
 
-void FLASH_Unlock(void)
+void FLASH_INSTANCE_Close(ImitationFlash_t* inst)
 {
-    f_lock = false;
+#if !defined(_WIN32)
+    if (inst->fd >= 0)
+    {
+        msync(inst->mem, inst->size, MS_SYNC);
+        munmap(inst->mem, inst->size);
+        close(inst->fd);
+        FLASH_INSTANCE_Init(inst, NULL, 0U, inst->sectorSize);
+    }
+#else
+    (void)inst;
+#endif
 }
 
-bool FLASH_Read(uint32_t address, size_t size, uint8_t* out)
+uint64_t FLASH_INSTANCE_StoredBytes(const ImitationFlash_t* inst)
+{
+#if !defined(_WIN32)
+    struct stat st;
+    if ((inst->fd >= 0) && (0 == fstat(inst->fd, &st)))
+    {
+        return (uint64_t)st.st_blocks * 512U;
+    }
+#endif
+    return inst->size;
+}
+
+void FLASH_INSTANCE_Fill(ImitationFlash_t* inst, uint8_t value)
 {
-    if (CheckAccess(address, size) && FLASH_Lock())
+    if (inst->inverted && (value == ERASE_VALUE))
+    {
+        EraseRange(inst, 0U, inst->size);
+    }
+    else
     {
-        memcpy(out, &f_mem[address], size);
-        FLASH_Unlock();
+        memset(inst->mem, inst->inverted ? (uint8_t)~value : value, inst->size);
+    }
+}
+
+bool FLASH_INSTANCE_Lock(ImitationFlash_t* inst)
+{
+    return TryLock(&inst->busy);
+}
+
+void FLASH_INSTANCE_Unlock(ImitationFlash_t* inst)
+{
+    ClearLock(&inst->busy);
+}
+
+bool FLASH_INSTANCE_Read(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size,
+    uint8_t* out
+)
+{
+    if (CheckAccess(inst, address, size) && FLASH_INSTANCE_Lock(inst))
+    {
+        if (inst->inverted)
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                out[i] = GetByte(inst, address + i);
+            }
+        }
+        else
+        {
+            memcpy(out, &inst->mem[address], size);
+        }
+
+        inst->stats.bytesRead += size;
+        if (NULL != inst->model)
+        {
+            Spend(inst, (uint64_t)size * inst->model->readNsPerByte);
+        }
+
+        FLASH_INSTANCE_Unlock(inst);
         return true;
     }
 
     return false;
 }
 
-bool FLASH_Write(uint32_t address, size_t size, const uint8_t* in)
+bool FLASH_INSTANCE_Write(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size,
+    const uint8_t* in
+)
 {
-    if (CheckAccess(address, size) && FLASH_Lock())
+    if (CheckAccess(inst, address, size) && FLASH_INSTANCE_Lock(inst))
     {
+        const ImitationFlashModel_t* model = inst->model;
+        const uint32_t errorInterval = (NULL != model) ? model->programErrorInterval : 0U;
+
         /* NOR flash turns 1s to 0s only*/
         for (size_t i = 0; i < size; i++)
         {
-            f_mem[address + i] &= in[i];
+            const uint8_t current = GetByte(inst, address + i);
+            uint8_t value = current & in[i];
+
+            if ((errorInterval != 0U) &&
+                (((inst->stats.bytesWritten + i + 1U) % errorInterval) == 0U) &&
+                (value != current))
+            {
+                /* Lowest bit to program stays 1 */
+                const uint8_t toProgram = current & (uint8_t)~in[i];
+                value |= toProgram & (uint8_t)(0U - toProgram);
+                inst->stats.bitErrors++;
+            }
+
+            SetByte(inst, address + i, value);
         }
-        FLASH_Unlock();
+
+        inst->stats.bytesWritten += size;
+        if ((NULL != model) && (model->pageSize != 0U) && (size != 0U))
+        {
+            const uint64_t pages = ((address + size - 1U) / model->pageSize) - (address / model->pageSize) + 1U;
+            inst->stats.pagesProgrammed += pages;
+            Spend(inst, pages * model->programUsPerPage * 1000U);
+        }
+
+        FLASH_INSTANCE_Unlock(inst);
         return true;
     }
 
     return false;
 }
 
-bool FLASH_Erase(uint32_t address, size_t size)
+bool FLASH_INSTANCE_Erase(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size
+)
 {
-    if (((address % f_sectorSize) != 0U) ||
-        ((size % f_sectorSize) != 0U))
+    if ((inst->sectorSize == 0U) ||
+        ((address % inst->sectorSize) != 0U) ||
+        ((size % inst->sectorSize) != 0U))
     {
         return false;
     }
 
-    if (CheckAccess(address, size) && FLASH_Lock())
+    if (CheckAccess(inst, address, size) && FLASH_INSTANCE_Lock(inst))
     {
-        memset(&f_mem[address], 0xFF, size);
-        FLASH_Unlock();
-        return true;
+        bool ok = true;
+
+        for (size_t pos = address; pos < ((size_t)address + size); pos += inst->sectorSize)
+        {
+            const size_t sector = pos / inst->sectorSize;
+
+            if ((NULL != inst->eraseCounts) &&
+                (NULL != inst->model) &&
+                (inst->model->endurance != 0U) &&
+                (inst->eraseCounts[sector] >= inst->model->endurance))
+            {
+                /* Worn out sector fails, later sectors are not erased */
+                inst->stats.failedErases++;
+                ok = false;
+                break;
+            }
+
+            EraseRange(inst, pos, inst->sectorSize);
+            inst->stats.sectorsErased++;
+
+            if (NULL != inst->eraseCounts)
+            {
+                inst->eraseCounts[sector]++;
+            }
+            if (NULL != inst->model)
+            {
+                Spend(inst, (uint64_t)inst->model->eraseUsPerSector * 1000U);
+            }
+        }
+
+        FLASH_INSTANCE_Unlock(inst);
+        return ok;
     }
 
     return false;
 }
 
+void FLASH_SetMemory(uint8_t* mem, size_t memorySize, size_t sectorSize)
+{
+    FLASH_INSTANCE_Init(&f_instance, mem, memorySize, sectorSize);
+}
+
+void FLASH_Fill(uint8_t value)
+{
+    FLASH_INSTANCE_Fill(&f_instance, value);
+}
+
+bool FLASH_Lock(void)
+{
+    return FLASH_INSTANCE_Lock(&f_instance);
+}
+
+void FLASH_Unlock(void)
+{
+    FLASH_INSTANCE_Unlock(&f_instance);
+}
+
+bool FLASH_Read(uint32_t address, size_t size, uint8_t* out)
+{
+    return FLASH_INSTANCE_Read(&f_instance, address, size, out);
+}
+
+bool FLASH_Write(uint32_t address, size_t size, const uint8_t* in)
+{
+    return FLASH_INSTANCE_Write(&f_instance, address, size, in);
+}
+
+bool FLASH_Erase(uint32_t address, size_t size)
+{
+    return FLASH_INSTANCE_Erase(&f_instance, address, size);
+}
+
 /* EoF imitation_flash.c */
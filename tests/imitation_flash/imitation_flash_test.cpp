@@ -33,6 +33,11 @@
 
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_all.hpp>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
 
 extern "C" {
 #include "imitation_flash.h"
@@ -65,6 +70,9 @@ static bool ContainsString(const uint8_t* buf, const char* str)
     return memcmp(buf, str, strlen(str)) == 0;
 }
 
+static ImitationFlash_t s_adapted;
+IMITATION_FLASH_ADAPTERS(Adapted, s_adapted)
+
 // -----------------------------------------------------------------------------
 // MOCK FUNCTION DEFINITIONS
 // -----------------------------------------------------------------------------
@@ -255,4 +263,280 @@ TEST_CASE("Flash lock")
     }
 }
 
+TEST_CASE("Instances")
+{
+    uint8_t memoryA[1024];
+    uint8_t memoryB[512];
+    ImitationFlash_t a;
+    ImitationFlash_t b;
+
+    FLASH_INSTANCE_Init(&a, memoryA, sizeof(memoryA), 128U);
+    FLASH_INSTANCE_Init(&b, memoryB, sizeof(memoryB), 256U);
+    FLASH_INSTANCE_Fill(&a, 0xFF);
+    FLASH_INSTANCE_Fill(&b, 0xFF);
+
+    const uint8_t data[] = {1, 2, 3, 4};
+    uint8_t out[4] = {0};
+
+    REQUIRE(FLASH_INSTANCE_Write(&a, 0x100U, sizeof(data), data));
+    REQUIRE(IsAll(memoryB, sizeof(memoryB), 0xFF));
+    REQUIRE_FALSE(FLASH_INSTANCE_Write(&b, 0x200U, sizeof(data), data));
+    REQUIRE_FALSE(FLASH_INSTANCE_Erase(&b, 128U, 128U));
+
+    // Lock is per instance
+    REQUIRE(FLASH_INSTANCE_Lock(&a));
+    REQUIRE_FALSE(FLASH_INSTANCE_Read(&a, 0x100U, sizeof(out), out));
+    REQUIRE(FLASH_INSTANCE_Read(&b, 0x100U, sizeof(out), out));
+    REQUIRE(IsAll(out, sizeof(out), 0xFF));
+    FLASH_INSTANCE_Unlock(&a);
+
+    REQUIRE(FLASH_INSTANCE_Read(&a, 0x100U, sizeof(out), out));
+    REQUIRE(memcmp(out, data, sizeof(data)) == 0);
+
+    SECTION("Adapters")
+    {
+        FLASH_INSTANCE_Init(&s_adapted, memoryA, sizeof(memoryA), 128U);
+        REQUIRE(Adapted_Read(0x100U, sizeof(out), out));
+        REQUIRE(memcmp(out, data, sizeof(data)) == 0);
+        REQUIRE(Adapted_Erase(0x100U, 128U));
+        REQUIRE(IsAll(&memoryA[0x100], 128U, 0xFF));
+        REQUIRE(Adapted_Write(0x100U, sizeof(data), data));
+        REQUIRE(memoryA[0x103] == 4U);
+    }
+}
+
+TEST_CASE("Concurrent access")
+{
+    const size_t threads = 4U;
+    const size_t sector = 256U;
+
+    SECTION("Instance per thread")
+    {
+        std::vector<std::vector<uint8_t>> memories(threads, std::vector<uint8_t>(16U * sector));
+        std::vector<ImitationFlash_t> flashes(threads);
+        std::vector<size_t> failures(threads, 0U);
+        std::vector<std::thread> workers;
+
+        for (size_t t = 0; t < threads; t++)
+        {
+            FLASH_INSTANCE_Init(&flashes[t], memories[t].data(), memories[t].size(), sector);
+            workers.emplace_back([&, t]() {
+                uint8_t value = (uint8_t)t;
+                uint8_t out = 0U;
+                for (uint32_t i = 0; i < 10000U; i++)
+                {
+                    const uint32_t address = (i % 16U) * sector;
+                    if (!FLASH_INSTANCE_Erase(&flashes[t], address, sector) ||
+                        !FLASH_INSTANCE_Write(&flashes[t], address, 1U, &value) ||
+                        !FLASH_INSTANCE_Read(&flashes[t], address, 1U, &out) ||
+                        (out != value))
+                    {
+                        failures[t]++;
+                    }
+                }
+            });
+        }
+
+        for (auto& w: workers)
+        {
+            w.join();
+        }
+
+        for (size_t t = 0; t < threads; t++)
+        {
+            REQUIRE(failures[t] == 0U);
+            REQUIRE(memories[t][0] == (uint8_t)t);
+        }
+    }
+    SECTION("Shared instance")
+    {
+        std::vector<uint8_t> memory(threads * sector);
+        ImitationFlash_t flash;
+        FLASH_INSTANCE_Init(&flash, memory.data(), memory.size(), sector);
+        FLASH_INSTANCE_Fill(&flash, 0xFF);
+
+        std::vector<std::thread> workers;
+
+        // Busy device refuses the access, callers retry
+        for (size_t t = 0; t < threads; t++)
+        {
+            workers.emplace_back([&, t]() {
+                for (uint32_t i = 0; i < sector; i++)
+                {
+                    const uint8_t value = (uint8_t)(t ^ i);
+                    while (!FLASH_INSTANCE_Write(&flash, (uint32_t)(t * sector) + i, 1U, &value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (auto& w: workers)
+        {
+            w.join();
+        }
+
+        for (size_t t = 0; t < threads; t++)
+        {
+            for (size_t i = 0; i < sector; i++)
+            {
+                REQUIRE(memory[t * sector + i] == (uint8_t)(t ^ i));
+            }
+        }
+        REQUIRE(FLASH_INSTANCE_Lock(&flash));
+    }
+}
+
+TEST_CASE("Timing, wear and fault model")
+{
+    std::vector<uint8_t> memory(16U * 4096U);
+    uint32_t eraseCounts[16];
+    ImitationFlash_t flash;
+    FLASH_INSTANCE_Init(&flash, memory.data(), memory.size(), 4096U);
+    FLASH_INSTANCE_Fill(&flash, 0xFF);
+
+    REQUIRE_FALSE(FLASH_INSTANCE_SetModel(&flash, &IMITATION_FLASH_MODEL_SPI_NOR, eraseCounts, 15U));
+
+    std::vector<uint8_t> data(1024U, 0x00U);
+    std::vector<uint8_t> out(data.size());
+
+    SECTION("Timing")
+    {
+        REQUIRE(FLASH_INSTANCE_SetModel(&flash, &IMITATION_FLASH_MODEL_SPI_NOR, NULL, 0U));
+
+        // Unaligned 1 KB touches 5 pages
+        REQUIRE(FLASH_INSTANCE_Write(&flash, 0x80U, data.size(), data.data()));
+        REQUIRE(flash.stats.pagesProgrammed == 5U);
+        REQUIRE(flash.stats.timeNs == 5U * 400000U);
+
+        REQUIRE(FLASH_INSTANCE_Read(&flash, 0x80U, out.size(), out.data()));
+        REQUIRE(flash.stats.timeNs == 5U * 400000U + 1024U * 20U);
+
+        REQUIRE(FLASH_INSTANCE_Erase(&flash, 0U, 2U * 4096U));
+        REQUIRE(flash.stats.timeNs == 5U * 400000U + 1024U * 20U + 2U * 45000000U);
+        REQUIRE(flash.stats.sectorsErased == 2U);
+        REQUIRE(flash.stats.bytesWritten == 1024U);
+        REQUIRE(flash.stats.bytesRead == 1024U);
+    }
+    SECTION("Real time")
+    {
+        ImitationFlashModel_t model = IMITATION_FLASH_MODEL_SPI_NOR;
+        model.eraseUsPerSector = 20000U;
+        model.realTime = true;
+        REQUIRE(FLASH_INSTANCE_SetModel(&flash, &model, NULL, 0U));
+
+        const auto start = std::chrono::steady_clock::now();
+        REQUIRE(FLASH_INSTANCE_Erase(&flash, 0U, 4096U));
+        REQUIRE((std::chrono::steady_clock::now() - start) >= std::chrono::milliseconds(20));
+    }
+    SECTION("Wear")
+    {
+        ImitationFlashModel_t model = IMITATION_FLASH_MODEL_SPI_NOR;
+        model.endurance = 3U;
+        REQUIRE(FLASH_INSTANCE_SetModel(&flash, &model, eraseCounts, 16U));
+
+        for (int i = 0; i < 3; i++)
+        {
+            REQUIRE(FLASH_INSTANCE_Erase(&flash, 0U, 4096U));
+        }
+        REQUIRE(FLASH_INSTANCE_EraseCount(&flash, 0x123U) == 3U);
+        REQUIRE(FLASH_INSTANCE_EraseCount(&flash, 0x1000U) == 0U);
+
+        // Worn out sector keeps its contents
+        REQUIRE(FLASH_INSTANCE_Write(&flash, 0U, 16U, data.data()));
+        REQUIRE_FALSE(FLASH_INSTANCE_Erase(&flash, 0U, 2U * 4096U));
+        REQUIRE(IsAll(memory.data(), 16U, 0x00));
+        REQUIRE(FLASH_INSTANCE_EraseCount(&flash, 0x1000U) == 0U);
+        REQUIRE(flash.stats.failedErases == 1U);
+    }
+    SECTION("Program errors")
+    {
+        ImitationFlashModel_t model = IMITATION_FLASH_MODEL_SPI_NOR;
+        model.programErrorInterval = 256U;
+        REQUIRE(FLASH_INSTANCE_SetModel(&flash, &model, NULL, 0U));
+
+        REQUIRE(FLASH_INSTANCE_Write(&flash, 0U, data.size(), data.data()));
+        REQUIRE(flash.stats.bitErrors == 4U);
+        REQUIRE(memory[255] == 0x01U);
+        REQUIRE(memory[256] == 0x00U);
+
+        // Reprogramming fixes the missing bits
+        REQUIRE(FLASH_INSTANCE_Write(&flash, 255U, 1U, data.data()));
+        REQUIRE(memory[255] == 0x00U);
+    }
+    SECTION("Injected errors")
+    {
+        REQUIRE(FLASH_INSTANCE_InjectBitError(&flash, 0x10U, 0x81U));
+        REQUIRE(memory[0x10] == 0x7EU);
+        REQUIRE_FALSE(FLASH_INSTANCE_InjectBitError(&flash, (uint32_t)memory.size(), 0x01U));
+    }
+}
+
+#if !defined(_WIN32)
+TEST_CASE("File backed device")
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "imitation_flash_test.bin").string();
+    const size_t size = (size_t)4U * 1024U * 1024U * 1024U;
+    const size_t sector = 4096U;
+    const uint32_t address = 0xF0000000U;
+
+    std::filesystem::remove(path);
+
+    ImitationFlash_t flash;
+    REQUIRE(FLASH_INSTANCE_OpenFile(&flash, path.c_str(), size, sector));
+    REQUIRE(FLASH_INSTANCE_StoredBytes(&flash) < 64U * 1024U);
+
+    std::vector<uint8_t> data(sector);
+    std::vector<uint8_t> out(sector);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (uint8_t)(i * 3U);
+    }
+
+    // Unwritten space reads erased
+    REQUIRE(FLASH_INSTANCE_Read(&flash, address, out.size(), out.data()));
+    REQUIRE(IsAll(out.data(), out.size(), 0xFF));
+    REQUIRE(FLASH_INSTANCE_Read(&flash, 0xFFFFFFF0U, 16U, out.data()));
+    REQUIRE(IsAll(out.data(), 16U, 0xFF));
+
+    REQUIRE(FLASH_INSTANCE_Write(&flash, address, data.size(), data.data()));
+    REQUIRE(FLASH_INSTANCE_Read(&flash, address, out.size(), out.data()));
+    REQUIRE(out == data);
+
+    const uint8_t oddBits = 0x55U;
+    const uint8_t evenBits = 0xAAU;
+    REQUIRE(FLASH_INSTANCE_Write(&flash, address + sector, 1U, &oddBits));
+    REQUIRE(FLASH_INSTANCE_Write(&flash, address + sector, 1U, &evenBits));
+    REQUIRE(FLASH_INSTANCE_Read(&flash, address + sector, 1U, out.data()));
+    REQUIRE(out[0] == 0U);
+
+    const uint64_t written = FLASH_INSTANCE_StoredBytes(&flash);
+    REQUIRE(written >= 2U * sector);
+    REQUIRE(written < 1024U * 1024U);
+
+    // Contents persist
+    FLASH_INSTANCE_Close(&flash);
+    REQUIRE(FLASH_INSTANCE_OpenFile(&flash, path.c_str(), size, sector));
+    std::fill(out.begin(), out.end(), 0U);
+    REQUIRE(FLASH_INSTANCE_Read(&flash, address, out.size(), out.data()));
+    REQUIRE(out == data);
+
+    // Erase releases the storage
+    REQUIRE(FLASH_INSTANCE_Erase(&flash, address, 2U * sector));
+    REQUIRE(FLASH_INSTANCE_Read(&flash, address, out.size(), out.data()));
+    REQUIRE(IsAll(out.data(), out.size(), 0xFF));
+    REQUIRE(FLASH_INSTANCE_StoredBytes(&flash) < written);
+
+    REQUIRE(FLASH_INSTANCE_Write(&flash, 0x1000U, 16U, data.data()));
+    FLASH_INSTANCE_Fill(&flash, 0xFFU);
+    REQUIRE(FLASH_INSTANCE_Read(&flash, 0x1000U, 16U, out.data()));
+    REQUIRE(IsAll(out.data(), 16U, 0xFF));
+    REQUIRE(FLASH_INSTANCE_StoredBytes(&flash) < 64U * 1024U);
+
+    FLASH_INSTANCE_Close(&flash);
+    std::filesystem::remove(path);
+}
+#endif
+
 // EoF imitation_flash_test.cpp
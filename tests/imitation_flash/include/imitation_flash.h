@@ -25,6 +25,20 @@
  * imitation_flash.h
  *
  * @brief Imitation flash imitates standard NOR flash memory
+ * 
+ * Each ImitationFlash_t is an independent device. The busy flag is atomic, so
+ * an instance may be shared between threads: an access while another one is
+ * in progress fails like on a locked device instead of racing. The FLASH_*
+ * functions without an instance use one default device.
+ * 
+ * FLASH_INSTANCE_OpenFile backs a device with a memory mapped sparse file
+ * (POSIX hosts only). Bytes are stored complemented so that file holes read
+ * as erased, and erasing punches holes: multi-GB devices only use disk for
+ * the data written, and contents persist between runs.
+ * 
+ * FLASH_INSTANCE_SetModel adds program, erase and read times on a virtual
+ * clock (optionally slept in real time), per sector erase counters with an
+ * endurance limit, and program failures leaving bits unprogrammed.
 */
 
 #ifndef IMITATION_FLASH_H_
@@ -40,11 +54,172 @@ extern "C" {
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    uint32_t    pageSize;               /* Program time is charged per page touched */
+    uint32_t    programUsPerPage;
+    uint32_t    eraseUsPerSector;
+    uint32_t    readNsPerByte;
+    uint32_t    endurance;              /* Erase cycles per sector, 0 unlimited */
+    uint32_t    programErrorInterval;   /* One bit left unprogrammed every N bytes, 0 none */
+    bool        realTime;               /* Sleep the modeled time */
+} ImitationFlashModel_t;
+
+typedef struct
+{
+    uint64_t    timeNs;                 /* Virtual clock */
+    uint64_t    bytesRead;
+    uint64_t    bytesWritten;
+    uint64_t    pagesProgrammed;
+    uint64_t    sectorsErased;
+    uint64_t    bitErrors;
+    uint64_t    failedErases;           /* Erases refused on worn out sectors */
+} ImitationFlashStats_t;
+
+typedef struct
+{
+    uint8_t*    mem;
+    size_t      size;
+    size_t      sectorSize;
+    long        busy;       /* Accessed with atomic operations only */
+    bool        inverted;   /* mem holds the complement of the contents */
+    int         fd;         /* Backing file, -1 for caller memory */
+
+    /* Timing, wear and fault model */
+    const ImitationFlashModel_t*    model;
+    uint32_t*                       eraseCounts;
+    size_t                          eraseCountsSize;
+    ImitationFlashStats_t           stats;
+} ImitationFlash_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+/** Define memory callbacks prefix_Read, prefix_Write and prefix_Erase bound
+ *  to an instance, e.g. for MemoryConfig_t
+ * 
+ * @param prefix    Function name prefix
+ * @param instance  ImitationFlash_t variable
+ */
+#define IMITATION_FLASH_ADAPTERS(prefix, instance) \
+    __attribute__((unused)) static bool prefix##_Read(uint32_t address, size_t size, uint8_t* out) \
+    { \
+        return FLASH_INSTANCE_Read(&(instance), address, size, out); \
+    } \
+    __attribute__((unused)) static bool prefix##_Write(uint32_t address, size_t size, const uint8_t* in) \
+    { \
+        return FLASH_INSTANCE_Write(&(instance), address, size, in); \
+    } \
+    __attribute__((unused)) static bool prefix##_Erase(uint32_t address, size_t size) \
+    { \
+        return FLASH_INSTANCE_Erase(&(instance), address, size); \
+    }
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC VARIABLE DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+/** Typical SPI NOR: 256 B pages in 0.4 ms, 4 KB sectors in 45 ms, quad reads
+ *  at 50 MB/s and 100k erase cycles */
+extern const ImitationFlashModel_t IMITATION_FLASH_MODEL_SPI_NOR;
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
 
+/** Initialize device on caller memory, contents are left as is */
+extern void FLASH_INSTANCE_Init(
+    ImitationFlash_t* inst,
+    uint8_t* mem,
+    size_t memorySize,
+    size_t sectorSize
+);
+
+/** Initialize device on a memory mapped file
+ * 
+ * The file is created or extended to memorySize, new space reads erased.
+ * Existing contents are kept.
+ * 
+ * @return false on file or mapping errors and on hosts without mmap
+ */
+extern bool FLASH_INSTANCE_OpenFile(
+    ImitationFlash_t* inst,
+    const char* path,
+    size_t memorySize,
+    size_t sectorSize
+);
+
+/** Flush and unmap file backed device, no-op for caller memory */
+extern void FLASH_INSTANCE_Close(ImitationFlash_t* inst);
+
+/** Bytes of storage in use, memory size for caller memory */
+extern uint64_t FLASH_INSTANCE_StoredBytes(const ImitationFlash_t* inst);
+
+/** Attach timing, wear and fault model and clear statistics
+ * 
+ * @param inst              Instance
+ * @param model             Model, must stay valid, NULL for instant operations
+ * @param eraseCounts       Per sector erase counters, NULL disables wear
+ * @param eraseCountsSize   Entries in eraseCounts, at least size / sectorSize
+ * @return false if eraseCounts is too small
+ */
+extern bool FLASH_INSTANCE_SetModel(
+    ImitationFlash_t* inst,
+    const ImitationFlashModel_t* model,
+    uint32_t* eraseCounts,
+    size_t eraseCountsSize
+);
+
+/** Erase cycles of the sector containing address, 0 without wear tracking */
+extern uint32_t FLASH_INSTANCE_EraseCount(const ImitationFlash_t* inst, uint32_t address);
+
+/** Flip stored bits, e.g. to model retention or disturb errors
+ * 
+ * @param mask Bits to flip
+ * @return false for an invalid address or a busy device
+ */
+extern bool FLASH_INSTANCE_InjectBitError(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    uint8_t mask
+);
+
+extern void FLASH_INSTANCE_Fill(ImitationFlash_t* inst, uint8_t value);
+
+/** Take the busy flag, false if an access is in progress */
+extern bool FLASH_INSTANCE_Lock(ImitationFlash_t* inst);
+
+extern void FLASH_INSTANCE_Unlock(ImitationFlash_t* inst);
+
+extern bool FLASH_INSTANCE_Read(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size,
+    uint8_t* out
+);
+
+extern bool FLASH_INSTANCE_Write(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size,
+    const uint8_t* in
+);
+
+extern bool FLASH_INSTANCE_Erase(
+    ImitationFlash_t* inst,
+    uint32_t address,
+    size_t size
+);
+
+/* Default device */
+
 extern void FLASH_SetMemory(uint8_t* mem, size_t memorySize, size_t sectorSize);
 
 extern void FLASH_Fill(uint8_t value);
@@ -0,0 +1,203 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// base64_test.cpp
+//
+// Unit tests for the base64 encoder and decoder
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base64.hpp"
+
+// -----------------------------------------------------------------------------
+// VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static const char* const ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static std::vector<uint8_t> MakeRandomBuffer(size_t size)
+{
+    std::vector<uint8_t> buf(size);
+    for (auto& b: buf)
+    {
+        b = (uint8_t)rand();
+    }
+    return buf;
+}
+
+static std::string MakeRandomEncoded(size_t size)
+{
+    std::string str(size, 'A');
+    for (auto& c: str)
+    {
+        c = ALPHABET[rand() % 64];
+    }
+    return str;
+}
+
+/* Bit accumulator decoder, stops at first invalid character */
+static std::string ReferenceDecode(const std::string& encoded)
+{
+    const std::string chars = ALPHABET;
+    std::string decoded;
+    int val = 0;
+    int valb = -8;
+
+    for (char c : encoded)
+    {
+        const size_t pos = chars.find(c);
+        if ((c == '\0') || (pos == std::string::npos))
+        {
+            break;
+        }
+
+        val = (val << 6) + (int)pos;
+        valb += 6;
+
+        if (valb >= 0)
+        {
+            decoded.push_back(char((val >> valb) & 0xFF));
+            valb -= 8;
+        }
+    }
+
+    return decoded;
+}
+
+// -----------------------------------------------------------------------------
+// TEST SUITE DEFINITION
+// -----------------------------------------------------------------------------
+
+static void InitTestSuite(bool simd)
+{
+    Base64::SetSimdEnabled(simd);
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("RFC 4648 test vectors")
+{
+    const bool simd = GENERATE(false, true);
+    InitTestSuite(simd);
+
+    const std::vector<std::pair<std::string, std::string>> vectors = {
+        {"", ""},
+        {"f", "Zg=="},
+        {"fo", "Zm8="},
+        {"foo", "Zm9v"},
+        {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="},
+        {"foobar", "Zm9vYmFy"},
+    };
+
+    for (const auto& v: vectors)
+    {
+        REQUIRE(Base64::Encode((const uint8_t*)v.first.data(), v.first.size()) == v.second);
+        REQUIRE(Base64::Decode(v.second) == v.first);
+    }
+}
+
+TEST_CASE("Round trip")
+{
+    const bool simd = GENERATE(false, true);
+    InitTestSuite(simd);
+
+    const auto buf = MakeRandomBuffer(4096U);
+
+    for (size_t len = 0U; len < buf.size(); len += 1U + (len / 16U))
+    {
+        const std::string encoded = Base64::Encode(buf.data(), len);
+        REQUIRE(encoded.size() == Base64::EncodedSize(len));
+
+        const std::string decoded = Base64::Decode(encoded);
+        REQUIRE(decoded.size() == len);
+        REQUIRE(0 == memcmp(decoded.data(), buf.data(), len));
+    }
+}
+
+TEST_CASE("Vectorized paths match scalar")
+{
+    const auto buf = MakeRandomBuffer(1000U);
+
+    for (size_t len = 0U; len < buf.size(); len++)
+    {
+        InitTestSuite(false);
+        const std::string scalar = Base64::Encode(buf.data(), len);
+        InitTestSuite(true);
+        REQUIRE(Base64::Encode(buf.data(), len) == scalar);
+    }
+}
+
+TEST_CASE("Decode matches reference on unpadded input")
+{
+    const bool simd = GENERATE(false, true);
+    InitTestSuite(simd);
+
+    for (size_t len = 0U; len < 600U; len++)
+    {
+        const std::string encoded = MakeRandomEncoded(len);
+        REQUIRE(Base64::Decode(encoded) == ReferenceDecode(encoded));
+    }
+}
+
+TEST_CASE("Decode stops at first invalid character")
+{
+    const bool simd = GENERATE(false, true);
+    InitTestSuite(simd);
+
+    const char invalid[] = {'=', '\n', ' ', '-', '_', '.', '*', '\0', (char)0x80, (char)0xFF, '@', '[', '`', '{'};
+
+    for (size_t pos = 0U; pos < 200U; pos += 7U)
+    {
+        for (char c: invalid)
+        {
+            std::string encoded = MakeRandomEncoded(256U);
+            encoded[pos] = c;
+            REQUIRE(Base64::Decode(encoded) == ReferenceDecode(encoded));
+        }
+    }
+}
+
+TEST_CASE("Kernel name")
+{
+    InitTestSuite(false);
+    REQUIRE(std::string(Base64::GetKernelName()) == "scalar");
+    InitTestSuite(true);
+    REQUIRE(!std::string(Base64::GetKernelName()).empty());
+}
@@ -0,0 +1,124 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+//
+// handoff_test.cpp
+//
+// Unit tests for the boot stage handoff record
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+
+#include "niram/handoff.h"
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static NoInitRamHandoff_t MakeHandoff()
+{
+    NoInitRamHandoff_t h;
+    memset(&h, 0, sizeof(h));
+
+    h.firmwareId = 0x1234U;
+    h.imageAddress = 0x08020000U;
+    h.imageSize = 4096U;
+    for (size_t i = 0; i < sizeof(h.imageDigest); i++)
+    {
+        h.imageDigest[i] = (uint8_t)i;
+    }
+    h.areaCount = 2U;
+    h.lastFragmentIndex[0] = 17U;
+    h.lastFragmentIndex[1] = NO_INIT_RAM_HANDOFF_NO_INDEX;
+
+    return h;
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASES
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Handoff: publish and take")
+{
+    memset(&NO_INIT_RAM_handoff, 0xA5, sizeof(NO_INIT_RAM_handoff));
+
+    NoInitRamHandoff_t out;
+    REQUIRE_FALSE(NO_INIT_RAM_TakeHandoff(&out));
+
+    const NoInitRamHandoff_t in = MakeHandoff();
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    REQUIRE(NO_INIT_RAM_TakeHandoff(&out));
+
+    REQUIRE(out.version == NO_INIT_RAM_HANDOFF_VERSION);
+    REQUIRE(out.freshness == 1U);
+    REQUIRE(out.firmwareId == in.firmwareId);
+    REQUIRE(out.imageSize == in.imageSize);
+    REQUIRE(memcmp(out.imageDigest, in.imageDigest, sizeof(in.imageDigest)) == 0);
+    REQUIRE(out.areaCount == 2U);
+    REQUIRE(out.lastFragmentIndex[0] == 17U);
+    REQUIRE(out.lastFragmentIndex[1] == NO_INIT_RAM_HANDOFF_NO_INDEX);
+
+    // Taking consumes the record
+    REQUIRE_FALSE(NO_INIT_RAM_TakeHandoff(&out));
+}
+
+TEST_CASE("Handoff: freshness increments over publishes")
+{
+    const NoInitRamHandoff_t in = MakeHandoff();
+    NoInitRamHandoff_t out;
+
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    REQUIRE(NO_INIT_RAM_TakeHandoff(&out));
+    const uint32_t first = out.freshness;
+
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    REQUIRE(NO_INIT_RAM_TakeHandoff(&out));
+    REQUIRE(out.freshness == first + 2U);
+}
+
+TEST_CASE("Handoff: corruption and invalidation")
+{
+    NoInitRamHandoff_t in = MakeHandoff();
+    NoInitRamHandoff_t out;
+
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    NO_INIT_RAM_handoff.lastFragmentIndex[0] ^= 1U;
+    REQUIRE_FALSE(NO_INIT_RAM_TakeHandoff(&out));
+
+    REQUIRE(NO_INIT_RAM_PublishHandoff(&in));
+    NO_INIT_RAM_InvalidateHandoff();
+    REQUIRE_FALSE(NO_INIT_RAM_TakeHandoff(&out));
+
+    in.areaCount = NO_INIT_RAM_HANDOFF_AREAS + 1U;
+    REQUIRE_FALSE(NO_INIT_RAM_PublishHandoff(&in));
+    REQUIRE_FALSE(NO_INIT_RAM_PublishHandoff(NULL));
+}
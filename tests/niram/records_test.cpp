@@ -0,0 +1,219 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+//
+// records_test.cpp
+//
+// Unit tests for the no init RAM record manager and content
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+
+#include "crc/crc32.h"
+#include "crc/crc32_kernels.h"
+#include "niram/no_init_ram.h"
+#include "niram/records.h"
+
+// -----------------------------------------------------------------------------
+// PRIVATE TYPE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+typedef struct
+{
+    uint32_t bootCount;
+    uint32_t lastError;
+    uint8_t  state[6];
+} AppState_t;
+
+// -----------------------------------------------------------------------------
+// PRIVATE VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static size_t f_crcBytes = 0U;
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static uint32_t CountingKernel(uint32_t crc, const uint8_t* data, size_t len)
+{
+    f_crcBytes += len;
+    return CRC32_KernelTable(crc, data, len);
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASES
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Records: allocate, find and survive reset")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    REQUIRE(NO_INIT_RAM_FindRecord(1U, NULL) == NULL);
+    REQUIRE(NO_INIT_RAM_GetRecord(NO_INIT_RAM_RECORD_END, 4U) == NULL);
+
+    AppState_t* app = (AppState_t*)NO_INIT_RAM_GetRecord(1U, sizeof(AppState_t));
+    uint32_t* other = (uint32_t*)NO_INIT_RAM_GetRecord(2U, sizeof(uint32_t));
+    REQUIRE(app != NULL);
+    REQUIRE(other != NULL);
+    REQUIRE(app->bootCount == 0U);
+
+    // Same type and length returns the same record, other length fails
+    REQUIRE(NO_INIT_RAM_GetRecord(1U, sizeof(AppState_t)) == app);
+    REQUIRE(NO_INIT_RAM_GetRecord(1U, sizeof(uint32_t)) == NULL);
+
+    const uint32_t bootCount = 5U;
+    REQUIRE(NO_INIT_RAM_WriteRecord(app, offsetof(AppState_t, bootCount), &bootCount, sizeof(bootCount)));
+
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 2U);
+
+    uint16_t length = 0U;
+    const AppState_t* found = (const AppState_t*)NO_INIT_RAM_FindRecord(1U, &length);
+    REQUIRE(found == app);
+    REQUIRE(length == sizeof(AppState_t));
+    REQUIRE(found->bootCount == 5U);
+}
+
+TEST_CASE("Records: write keeps the CRC valid")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    uint8_t* rec = (uint8_t*)NO_INIT_RAM_GetRecord(7U, 37U);
+    REQUIRE(rec != NULL);
+
+    for (size_t offset = 0U; offset < 37U; offset += 3U)
+    {
+        const uint8_t data[4] = {(uint8_t)offset, 0x5AU, 0xC3U, (uint8_t)~offset};
+        const size_t size = (offset + sizeof(data) <= 37U) ? sizeof(data) : (37U - offset);
+        REQUIRE(NO_INIT_RAM_WriteRecord(rec, offset, data, size));
+
+        const NoInitRamRecordHeader_t* header = (const NoInitRamRecordHeader_t*)rec - 1;
+        const uint32_t expected = CRC32_Calculate((const uint8_t*)&header->typeId, 4U + 37U);
+        REQUIRE(header->crc == expected);
+    }
+
+    REQUIRE_FALSE(NO_INIT_RAM_WriteRecord(rec, 36U, rec, 2U));
+    REQUIRE_FALSE(NO_INIT_RAM_WriteRecord(rec + 1, 0U, rec, 1U));
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 1U);
+}
+
+TEST_CASE("Records: write CRCs only the changed record")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    uint8_t* first = (uint8_t*)NO_INIT_RAM_GetRecord(1U, 100U);
+    uint8_t* second = (uint8_t*)NO_INIT_RAM_GetRecord(2U, 100U);
+    REQUIRE((first != NULL && second != NULL));
+
+    CRC32_SetKernel(CountingKernel);
+    f_crcBytes = 0U;
+
+    const uint32_t value = 0xDEADBEEFU;
+    const bool written = NO_INIT_RAM_WriteRecord(second, 40U, &value, sizeof(value));
+    const bool found = (NO_INIT_RAM_FindRecord(2U, NULL) == second);
+    const size_t crcBytes = f_crcBytes;
+
+    CRC32_SetKernel(NULL);
+
+    REQUIRE(written);
+    REQUIRE(found);
+    // Header after the CRC and the payload of the written record only
+    REQUIRE(crcBytes == (sizeof(NoInitRamRecordHeader_t) - sizeof(uint32_t) + 100U));
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 2U);
+}
+
+TEST_CASE("Records: corruption truncates list")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    uint32_t* a = (uint32_t*)NO_INIT_RAM_GetRecord(1U, 4U);
+    uint32_t* b = (uint32_t*)NO_INIT_RAM_GetRecord(2U, 4U);
+    uint32_t* c = (uint32_t*)NO_INIT_RAM_GetRecord(3U, 4U);
+    REQUIRE((a != NULL && b != NULL && c != NULL));
+
+    *b = 0x12345678U;
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 1U);
+    REQUIRE(NO_INIT_RAM_FindRecord(1U, NULL) == a);
+    REQUIRE(NO_INIT_RAM_FindRecord(3U, NULL) == NULL);
+
+    // Direct modification followed by commit
+    b = (uint32_t*)NO_INIT_RAM_GetRecord(2U, 4U);
+    *b = 0xCAFEU;
+    REQUIRE(NO_INIT_RAM_CommitRecord(b));
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 2U);
+}
+
+TEST_CASE("Records: commit only accepts records")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    uint32_t* a = (uint32_t*)NO_INIT_RAM_GetRecord(1U, 16U);
+    uint32_t* b = (uint32_t*)NO_INIT_RAM_GetRecord(2U, 4U);
+    REQUIRE((a != NULL && b != NULL));
+
+    // Aligned pointer into a payload is not a record
+    a[3] = 0x12345678U;
+    REQUIRE_FALSE(NO_INIT_RAM_CommitRecord(&a[2]));
+    REQUIRE_FALSE(NO_INIT_RAM_CommitRecord(NULL));
+    REQUIRE(a[3] == 0x12345678U);
+
+    REQUIRE(NO_INIT_RAM_CommitRecord(a));
+    REQUIRE(NO_INIT_RAM_RecordsInit() == 2U);
+    REQUIRE(NO_INIT_RAM_FindRecord(2U, NULL) == b);
+}
+
+TEST_CASE("Records: area full")
+{
+    NO_INIT_RAM_ClearRecords();
+
+    const uint16_t length = NO_INIT_RAM_RECORDS_SIZE / 2U;
+    REQUIRE(NO_INIT_RAM_GetRecord(1U, length) != NULL);
+    REQUIRE(NO_INIT_RAM_GetRecord(2U, length) == NULL);
+    REQUIRE(NO_INIT_RAM_GetRecord(2U, 8U) != NULL);
+}
+
+TEST_CASE("Content: set member keeps CRC valid")
+{
+    memset(&NO_INIT_RAM_content, 0xA5, sizeof(NO_INIT_RAM_content));
+    NO_INIT_RAM_Init();
+    REQUIRE(NO_INIT_RAM_content.resetCount == 0U);
+
+    NO_INIT_RAM_SetMember(&NO_INIT_RAM_content.resetCount, 3U);
+    NO_INIT_RAM_SetMember(&NO_INIT_RAM_content.appTag, APP_TAG_GOOD);
+    NO_INIT_RAM_SetMember(&NO_INIT_RAM_content._reserved[10], 1U);
+
+    const uint32_t expected = CRC32_Calculate((const uint8_t*)&NO_INIT_RAM_content, sizeof(NO_INIT_RAM_content) - sizeof(uint32_t));
+    REQUIRE(NO_INIT_RAM_content.crc == expected);
+
+    NO_INIT_RAM_Init();
+    REQUIRE(NO_INIT_RAM_content.resetCount == 3U);
+    REQUIRE(NO_INIT_RAM_content.appTag == APP_TAG_GOOD);
+}
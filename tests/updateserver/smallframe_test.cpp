@@ -0,0 +1,384 @@
+// MIT License
+// 
+// Copyright (c) 2025 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// smallframe_test.cpp
+//
+// Unit tests for small frame transfer layer
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <vector>
+
+extern "C" {
+#include "updateserver/smallframe.h"
+
+// Mock this
+#include "updateserver/server.h"
+}
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define FRAME_SIZE (64U)
+
+// -----------------------------------------------------------------------------
+// VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static size_t test_ProcessReqCallCount;
+static std::vector<uint8_t> test_request;
+static uint8_t test_buffer[1024];
+static uint8_t test_frame[FRAME_SIZE];
+static UpdateServer_t test_server;
+
+// -----------------------------------------------------------------------------
+// MOCK FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+size_t US_ProcessRequest(
+    const UpdateServer_t* server,
+    uint8_t* request,
+    size_t requestLength,
+    size_t,
+    uint8_t* response,
+    size_t maxResponseLength)
+{
+    (void)server;
+    (void)maxResponseLength;
+
+    test_request.assign(&request[0], &request[requestLength]);
+    test_ProcessReqCallCount++;
+
+    response[0] = request[0];
+    response[1] = PROTOCOL_ACK_OK;
+    return 2U;
+}
+
+// -----------------------------------------------------------------------------
+// TEST SUITE DEFINITION
+// -----------------------------------------------------------------------------
+
+static void InitTestSuite(SmallFrameTransfer_t* sf, uint8_t blockSize)
+{
+    test_ProcessReqCallCount = 0;
+    test_request.clear();
+    memset(test_buffer, 0, sizeof(test_buffer));
+    memset(test_frame, 0, sizeof(test_frame));
+
+    REQUIRE(SMALLFRAME_Init(sf, &test_server, test_buffer, sizeof(test_buffer), 1U, blockSize));
+}
+
+static size_t Send(SmallFrameTransfer_t* sf, const std::vector<uint8_t>& frame)
+{
+    memcpy(test_frame, frame.data(), frame.size());
+    return SMALLFRAME_Process(sf, test_frame, frame.size(), sizeof(test_frame));
+}
+
+// Frame as delivered by CAN-FD, padded up to the next data length
+static size_t SendPadded(SmallFrameTransfer_t* sf, const std::vector<uint8_t>& frame)
+{
+    static const size_t lengths[] = {8U, 12U, 16U, 20U, 24U, 32U, 48U, 64U};
+
+    std::vector<uint8_t> padded = frame;
+    for (size_t len: lengths)
+    {
+        if (frame.size() <= len)
+        {
+            padded.resize(len, 0xCCU);
+            break;
+        }
+    }
+    return Send(sf, padded);
+}
+
+static std::vector<uint8_t> FirstFrame(const std::vector<uint8_t>& request, size_t dataSize)
+{
+    const uint32_t size = (uint32_t)request.size();
+    std::vector<uint8_t> frame = {
+        SMALLFRAME_FIRST, 
+        (uint8_t)(size >> 24U), (uint8_t)(size >> 16U), (uint8_t)(size >> 8U), (uint8_t)size
+    };
+    frame.insert(frame.end(), request.begin(), request.begin() + dataSize);
+    return frame;
+}
+
+static std::vector<uint8_t> ConsecutiveFrame(const std::vector<uint8_t>& request, size_t offset, size_t dataSize, uint8_t sequence)
+{
+    std::vector<uint8_t> frame = {(uint8_t)(SMALLFRAME_CONSECUTIVE | (sequence & SMALLFRAME_SEQUENCE_MASK))};
+    frame.insert(frame.end(), request.begin() + offset, request.begin() + offset + dataSize);
+    return frame;
+}
+
+static bool ExpectResponse(uint8_t code)
+{
+    return (test_frame[0] == (SMALLFRAME_SINGLE | 2U)) && (test_frame[1] == 0) && (test_frame[2] == code);
+}
+
+static bool ExpectFlowControl(uint8_t blockSize)
+{
+    return (test_frame[0] == SMALLFRAME_FLOW_CONTROL) && (test_frame[1] == blockSize);
+}
+
+static std::vector<uint8_t> TestRequest(size_t size)
+{
+    std::vector<uint8_t> request(size);
+    request[0] = PROTOCOL_SID_PUT_FRAGMENT;
+    for (size_t i = 1; i < size; i++)
+    {
+        request[i] = (uint8_t)(i * 7U);
+    }
+    return request;
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Small frame init")
+{
+    SmallFrameTransfer_t sf;
+
+    REQUIRE_FALSE(SMALLFRAME_Init(nullptr, &test_server, test_buffer, sizeof(test_buffer), 1U, 0U));
+    REQUIRE_FALSE(SMALLFRAME_Init(&sf, nullptr, test_buffer, sizeof(test_buffer), 1U, 0U));
+    REQUIRE_FALSE(SMALLFRAME_Init(&sf, &test_server, nullptr, sizeof(test_buffer), 1U, 0U));
+    REQUIRE_FALSE(SMALLFRAME_Init(&sf, &test_server, test_buffer, sizeof(test_buffer), 3U, 0U));
+
+    REQUIRE(SMALLFRAME_Init(&sf, &test_server, test_buffer, sizeof(test_buffer), 8U, 4U));
+    REQUIRE((((uintptr_t)sf.tb.buf + 1U) % 8U) == 0U);
+    REQUIRE(sf.blockSize == 4U);
+}
+
+TEST_CASE("Small frame invalid calls")
+{
+    SmallFrameTransfer_t sf;
+    InitTestSuite(&sf, 0U);
+
+    REQUIRE(SMALLFRAME_Process(nullptr, test_frame, 2U, sizeof(test_frame)) == 0U);
+    REQUIRE(SMALLFRAME_Process(&sf, nullptr, 2U, sizeof(test_frame)) == 0U);
+    REQUIRE(SMALLFRAME_Process(&sf, test_frame, 0U, sizeof(test_frame)) == 0U);
+    REQUIRE(SMALLFRAME_Process(&sf, test_frame, 9U, 8U) == 0U);
+    REQUIRE(SMALLFRAME_Process(&sf, test_frame, 2U, SMALLFRAME_MIN_FRAME_SIZE - 1U) == 0U);
+
+    // Flow control is never sent to the server
+    REQUIRE(Send(&sf, {SMALLFRAME_FLOW_CONTROL, 0U}) == 0U);
+
+    // Unexpected consecutive frame is ignored
+    REQUIRE(Send(&sf, {SMALLFRAME_CONSECUTIVE | 1U, 0xAA}) == 0U);
+
+    REQUIRE(Send(&sf, {SMALLFRAME_SINGLE}) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_INVALID_REQUEST));
+
+    REQUIRE(Send(&sf, {SMALLFRAME_SINGLE, PROTOCOL_SID_PING}) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_INVALID_REQUEST));
+
+    REQUIRE(Send(&sf, {SMALLFRAME_SINGLE | 2U, PROTOCOL_SID_PING}) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_INVALID_REQUEST));
+
+    REQUIRE(Send(&sf, {SMALLFRAME_FIRST, 0U, 0U, 1U}) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_INVALID_REQUEST));
+
+    REQUIRE(Send(&sf, {SMALLFRAME_FIRST, 0U, 0U, 0U, 0U}) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_REQUEST_OUT_OF_RANGE));
+
+    REQUIRE(Send(&sf, FirstFrame(TestRequest(sizeof(test_buffer) + 1U), 8U)) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_NACK_REQUEST_OUT_OF_RANGE));
+
+    REQUIRE(test_ProcessReqCallCount == 0U);
+}
+
+TEST_CASE("Small frame single request")
+{
+    SmallFrameTransfer_t sf;
+    InitTestSuite(&sf, 0U);
+
+    REQUIRE(Send(&sf, {SMALLFRAME_SINGLE | 1U, PROTOCOL_SID_PING}) == 3U);
+    REQUIRE(test_frame[0] == (SMALLFRAME_SINGLE | 2U));
+    REQUIRE(test_frame[1] == PROTOCOL_SID_PING);
+    REQUIRE(test_frame[2] == PROTOCOL_ACK_OK);
+    REQUIRE(test_ProcessReqCallCount == 1U);
+    REQUIRE(test_request == std::vector<uint8_t>{PROTOCOL_SID_PING});
+
+    // Padding after the single frame length is ignored
+    const auto single = TestRequest(10U);
+    std::vector<uint8_t> frame = {(uint8_t)(SMALLFRAME_SINGLE | single.size())};
+    frame.insert(frame.end(), single.begin(), single.end());
+    REQUIRE(SendPadded(&sf, frame) == 3U);
+    REQUIRE(test_ProcessReqCallCount == 2U);
+    REQUIRE(test_request == single);
+
+    // Request fitting in the first frame, with or without padding
+    const auto request = TestRequest(10U);
+    REQUIRE(Send(&sf, FirstFrame(request, request.size())) == 3U);
+    REQUIRE(test_frame[1] == PROTOCOL_SID_PUT_FRAGMENT);
+    REQUIRE(test_ProcessReqCallCount == 3U);
+    REQUIRE(test_request == request);
+
+    REQUIRE(SendPadded(&sf, FirstFrame(request, request.size())) == 3U);
+    REQUIRE(test_frame[1] == PROTOCOL_SID_PUT_FRAGMENT);
+    REQUIRE(test_ProcessReqCallCount == 4U);
+    REQUIRE(test_request == request);
+}
+
+TEST_CASE("Small frame multi frame request")
+{
+    SmallFrameTransfer_t sf;
+    const uint8_t blockSize = GENERATE(0U, 1U, 4U, 16U);
+    const bool padded = GENERATE(false, true);
+    const auto send = padded ? SendPadded : Send;
+    InitTestSuite(&sf, blockSize);
+
+    const auto request = TestRequest(1000U);
+    const size_t firstData = FRAME_SIZE - 5U;
+    const size_t dataPerFrame = FRAME_SIZE - 1U;
+
+    REQUIRE(send(&sf, FirstFrame(request, firstData)) == 2U);
+    REQUIRE(ExpectFlowControl(blockSize));
+
+    size_t offset = firstData;
+    size_t frames = 0U;
+    size_t flowControls = 0U;
+    uint8_t sequence = 1U;
+
+    while (offset < request.size())
+    {
+        const size_t dataSize = std::min(dataPerFrame, request.size() - offset);
+        const size_t res = send(&sf, ConsecutiveFrame(request, offset, dataSize, sequence));
+
+        offset += dataSize;
+        sequence++;
+        frames++;
+
+        if (offset == request.size())
+        {
+            REQUIRE(res == 3U);
+            REQUIRE(test_frame[0] == (SMALLFRAME_SINGLE | 2U));
+            REQUIRE(test_frame[1] == PROTOCOL_SID_PUT_FRAGMENT);
+            REQUIRE(test_frame[2] == PROTOCOL_ACK_OK);
+        }
+        else if ((blockSize != 0U) && ((frames % blockSize) == 0U))
+        {
+            REQUIRE(res == 2U);
+            REQUIRE(ExpectFlowControl(blockSize));
+            flowControls++;
+        }
+        else
+        {
+            REQUIRE(res == 0U);
+        }
+    }
+
+    REQUIRE(test_ProcessReqCallCount == 1U);
+    REQUIRE(test_request == request);
+
+    if (blockSize != 0U)
+    {
+        REQUIRE(flowControls == ((frames - 1U) / blockSize));
+    }
+}
+
+TEST_CASE("Small frame sequence wraps")
+{
+    SmallFrameTransfer_t sf;
+    InitTestSuite(&sf, 0U);
+
+    // 100 consecutive frames of 8 bytes
+    const auto request = TestRequest(3U + (100U * 7U));
+
+    REQUIRE(Send(&sf, FirstFrame(request, 3U)) == 2U);
+
+    size_t offset = 3U;
+    for (size_t i = 1U; i <= 100U; i++)
+    {
+        const size_t res = Send(&sf, ConsecutiveFrame(request, offset, 7U, (uint8_t)i));
+        offset += 7U;
+        REQUIRE(res == ((i == 100U) ? 3U : 0U));
+    }
+
+    REQUIRE(test_ProcessReqCallCount == 1U);
+    REQUIRE(test_request == request);
+}
+
+TEST_CASE("Small frame errors")
+{
+    SmallFrameTransfer_t sf;
+    InitTestSuite(&sf, 0U);
+
+    const auto request = TestRequest(200U);
+
+    REQUIRE(Send(&sf, FirstFrame(request, 59U)) == 2U);
+    REQUIRE(Send(&sf, ConsecutiveFrame(request, 59U, 63U, 1U)) == 0U);
+
+    SECTION("Lost frame")
+    {
+        REQUIRE(Send(&sf, ConsecutiveFrame(request, 122U + 63U, 15U, 3U)) == 3U);
+        REQUIRE(ExpectResponse(PROTOCOL_NACK_REQUEST_FAILED));
+
+        // Rest of the failed request is ignored
+        REQUIRE(Send(&sf, ConsecutiveFrame(request, 122U, 63U, 4U)) == 0U);
+    }
+    SECTION("Repeated frame")
+    {
+        REQUIRE(Send(&sf, ConsecutiveFrame(request, 59U, 63U, 1U)) == 3U);
+        REQUIRE(ExpectResponse(PROTOCOL_NACK_REQUEST_FAILED));
+    }
+    SECTION("Data past the request is padding")
+    {
+        REQUIRE(Send(&sf, ConsecutiveFrame(request, 122U, 63U, 2U)) == 0U);
+        std::vector<uint8_t> frame = ConsecutiveFrame(request, 185U, 15U, 3U);
+        frame.push_back(0xFF);
+        REQUIRE(Send(&sf, frame) == 3U);
+        REQUIRE(test_frame[2] == PROTOCOL_ACK_OK);
+        REQUIRE(test_request == request);
+    }
+    SECTION("Empty consecutive frame")
+    {
+        REQUIRE(Send(&sf, {SMALLFRAME_CONSECUTIVE | 2U}) == 3U);
+        REQUIRE(ExpectResponse(PROTOCOL_NACK_INVALID_REQUEST));
+    }
+    SECTION("New request aborts the transfer")
+    {
+        REQUIRE(Send(&sf, {SMALLFRAME_SINGLE | 1U, PROTOCOL_SID_PING}) == 3U);
+        REQUIRE(test_request == std::vector<uint8_t>{PROTOCOL_SID_PING});
+        REQUIRE(Send(&sf, ConsecutiveFrame(request, 122U, 63U, 2U)) == 0U);
+        REQUIRE(test_ProcessReqCallCount == 1U);
+    }
+
+    REQUIRE(sf.tb.state == TRANSFER_IDLE);
+
+    // Client starts the request again
+    REQUIRE(Send(&sf, FirstFrame(request, 59U)) == 2U);
+    REQUIRE(Send(&sf, ConsecutiveFrame(request, 59U, 63U, 1U)) == 0U);
+    REQUIRE(Send(&sf, ConsecutiveFrame(request, 122U, 63U, 2U)) == 0U);
+    REQUIRE(Send(&sf, ConsecutiveFrame(request, 185U, 15U, 3U)) == 3U);
+    REQUIRE(test_request == request);
+}
+
+// EoF smallframe_test.cpp
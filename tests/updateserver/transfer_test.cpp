@@ -65,8 +65,9 @@ static UpdateServer_t test_server;
 
 size_t US_ProcessRequest(
     const UpdateServer_t* server,
-    const uint8_t* request,
+    uint8_t* request,
     size_t requestLength,
+    size_t,
     uint8_t* response,
     size_t)
 {
@@ -120,6 +121,46 @@ TEST_CASE("Init structure")
     REQUIRE_FALSE(TRANSFER_Init(&tb, nullptr, test_buffer, sizeof(test_buffer)));
     REQUIRE_FALSE(TRANSFER_Init(&tb, &test_server, nullptr, sizeof(test_buffer)));
     REQUIRE_FALSE(TRANSFER_Init(&tb, &test_server, test_buffer, 0U));
+    REQUIRE_FALSE(TRANSFER_InitAligned(&tb, &test_server, test_buffer, sizeof(test_buffer), 0U));
+    REQUIRE_FALSE(TRANSFER_InitAligned(&tb, &test_server, test_buffer, sizeof(test_buffer), 3U));
+    REQUIRE_FALSE(TRANSFER_InitAligned(&tb, &test_server, &test_buffer[1], 2U, 8U));
+}
+
+TEST_CASE("Aligned payload")
+{
+    InitTestSuite();
+
+    TransferBuffer_t tb;
+    const size_t alignment = GENERATE(1U, 2U, 4U, 8U, 32U);
+    const size_t offset = GENERATE(0U, 1U, 3U);
+
+    REQUIRE(TRANSFER_InitAligned(&tb, &test_server, &test_buffer[offset], sizeof(test_buffer) - offset, alignment));
+    REQUIRE((((uintptr_t)tb.buf + 1U) % alignment) == 0U);
+    REQUIRE(tb.buf >= &test_buffer[offset]);
+    REQUIRE(tb.buf < &test_buffer[offset + alignment]);
+    REQUIRE((tb.buf + tb.bufSize) == &test_buffer[sizeof(test_buffer)]);
+
+    // Multi packet request lands behind the SID byte
+    test_packet[0] = TRANSFER_MULTI_PACKET_INIT;
+    test_packet[1] = 0U;
+    test_packet[2] = 0U;
+    test_packet[3] = 0U;
+    test_packet[4] = 5U;
+    REQUIRE(TRANSFER_Process(&tb, test_packet, 5U, sizeof(test_packet)) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_ACK_OK));
+
+    const uint8_t data[] = {TRANSFER_MULTI_PACKET_TRANSFER, 0x11, 0xA0, 0xA1, 0xA2, 0xA3};
+    memcpy(test_packet, data, sizeof(data));
+    REQUIRE(TRANSFER_Process(&tb, test_packet, sizeof(data), sizeof(test_packet)) == 3U);
+    REQUIRE(ExpectResponse(PROTOCOL_ACK_OK));
+
+    REQUIRE(tb.buf[0] == 0x11);
+    REQUIRE(tb.buf[1] == 0xA0);
+
+    test_packet[0] = TRANSFER_MULTI_PACKET_END;
+    REQUIRE(TRANSFER_Process(&tb, test_packet, 1U, sizeof(test_packet)) == 6U);
+    REQUIRE(test_ProcessReqCallCount == 1U);
+    REQUIRE(test_packet[1] == (uint8_t)~0x11);
 }
 
 TEST_CASE("Single packet transfer")
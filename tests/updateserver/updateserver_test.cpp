@@ -75,6 +75,8 @@ static uint8_t TestReadDataById(
 
 static std::vector<uint8_t> f_writeData;
 static uint8_t f_testReturnCode;
+static size_t f_putCalls;
+static size_t f_putCapacity;
 
 static uint8_t TestWriteDataById(
     uint8_t id, 
@@ -91,21 +93,45 @@ static uint8_t TestWriteDataById(
 }
 
 static uint8_t TestPutMetadata(
-    const uint8_t* data, 
-    size_t size)
+    uint8_t* data, 
+    size_t size,
+    size_t capacity)
 {
+    f_putCalls++;
+    f_putCapacity = capacity;
     f_writeData = std::vector<uint8_t>(&data[0], &data[size]);
     return f_testReturnCode;
 }
 
 static uint8_t TestPutFragment(
-    const uint8_t* data, 
-    size_t size)
+    uint8_t* data, 
+    size_t size,
+    size_t capacity)
 {
+    f_putCalls++;
+    f_putCapacity = capacity;
     f_writeData = std::vector<uint8_t>(&data[0], &data[size]);
     return f_testReturnCode;
 }
 
+static void TestHash(
+    const uint8_t* data, 
+    size_t size,
+    uint8_t* digest)
+{
+    /* FNV-1a spread over the digest, enough for the short test requests */
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0U; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+    for (size_t i = 0U; i < US_REQUEST_DIGEST_SIZE; ++i)
+    {
+        hash = (hash ^ (uint8_t)i) * 16777619U;
+        digest[i] = (uint8_t)(hash >> 24U);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // TEST SUITE DEFINITION
 // -----------------------------------------------------------------------------
@@ -114,6 +140,8 @@ static void InitTestSuite(UpdateServer_t& server)
 {
     f_testReturnCode = PROTOCOL_ACK_OK;
     f_writeData.clear();
+    f_putCalls = 0U;
+    f_putCapacity = 0U;
     REQUIRE(US_InitServer(&server, &TestReadDataById, &TestWriteDataById, &TestPutMetadata, &TestPutFragment));
 }
 
@@ -140,35 +168,38 @@ TEST_CASE("Invalid Calls")
     }
     SECTION("Null arguments")
     {
-        len = US_ProcessRequest(nullptr, nullptr, 0U, nullptr, 0U);
+        len = US_ProcessRequest(nullptr, nullptr, 0U, 0U, nullptr, 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(nullptr, req.data(), 0U, res.data(), 0U);
+        len = US_ProcessRequest(nullptr, req.data(), 0U, 0U, res.data(), 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(&server, nullptr, 0U, nullptr, 0U);
+        len = US_ProcessRequest(&server, nullptr, 0U, 0U, nullptr, 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(&server, req.data(), 0U, nullptr, 0U);
+        len = US_ProcessRequest(&server, req.data(), 0U, 0U, nullptr, 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(&server, nullptr, 0U, res.data(), 0U);
+        len = US_ProcessRequest(&server, nullptr, 0U, 0U, res.data(), 0U);
         REQUIRE(len == 0U);
     }
     SECTION("Incorrect buffers")
     {
-        len = US_ProcessRequest(&server, req.data(), 0U, res.data(), 0U);
+        len = US_ProcessRequest(&server, req.data(), 0U, 0U, res.data(), 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), 0U);
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), 0U);
         REQUIRE(len == 0U);
 
-        len = US_ProcessRequest(&server, req.data(), 0U, res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), 0U, 0U, res.data(), res.size());
+        REQUIRE(len == 0U);
+
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size() - 1U, res.data(), res.size());
         REQUIRE(len == 0U);
     }
     SECTION("Unknown request")
     {
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2U);
         REQUIRE(res.at(0) == 0x00);
         REQUIRE(res.at(1) == PROTOCOL_NACK_REQUEST_OUT_OF_RANGE);
@@ -187,14 +218,14 @@ TEST_CASE("Ping")
     SECTION("Incorrect request")
     {
         req = {PROTOCOL_SID_PING, 0x20};
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_PING);
         REQUIRE(res.at(1) == PROTOCOL_NACK_INVALID_REQUEST);
     }
     SECTION("Correct request")
     {
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_PING);
         REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
@@ -221,14 +252,14 @@ TEST_CASE("Read Data by ID")
             req = {PROTOCOL_SID_READ_DATA_BY_ID, PROTOCOL_DATA_ID_FIRMWARE_VERSION, 0x00};
         }
 
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_READ_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_NACK_INVALID_REQUEST);
     }
     SECTION("Invalid Identifier")
     {
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_READ_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_NACK_REQUEST_OUT_OF_RANGE);
@@ -236,7 +267,7 @@ TEST_CASE("Read Data by ID")
     SECTION("Read Function Busy")
     {
         req = {PROTOCOL_SID_READ_DATA_BY_ID, PROTOCOL_DATA_ID_FIRMWARE_TYPE};
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_READ_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_NACK_BUSY_REPEAT_REQUEST);
@@ -244,7 +275,7 @@ TEST_CASE("Read Data by ID")
     SECTION("Read ok")
     {
         req = {PROTOCOL_SID_READ_DATA_BY_ID, PROTOCOL_DATA_ID_FIRMWARE_VERSION};
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 6);
         REQUIRE(res.at(0) == PROTOCOL_SID_READ_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
@@ -275,7 +306,7 @@ TEST_CASE("Write Data by ID")
             req = {PROTOCOL_SID_WRITE_DATA_BY_ID, 0x00};
         }
 
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_WRITE_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_NACK_INVALID_REQUEST);
@@ -283,7 +314,7 @@ TEST_CASE("Write Data by ID")
     SECTION("Invalid Identifier")
     {
         req = {PROTOCOL_SID_WRITE_DATA_BY_ID, 0x00, 0x11};
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_WRITE_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_NACK_REQUEST_OUT_OF_RANGE);
@@ -291,7 +322,7 @@ TEST_CASE("Write Data by ID")
     SECTION("Valid identifier")
     {
         req = {PROTOCOL_SID_WRITE_DATA_BY_ID, PROTOCOL_DATA_ID_FIRMWARE_UPDATE, 0xAA, 0xBB, 0xCC};
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_WRITE_DATA_BY_ID);
         REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
@@ -319,7 +350,7 @@ TEST_CASE("Put Metadata")
             req = {PROTOCOL_SID_PUT_METADATA};
         }
 
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_PUT_METADATA);
         REQUIRE(res.at(1) == PROTOCOL_NACK_INVALID_REQUEST);
@@ -332,14 +363,14 @@ TEST_CASE("Put Metadata")
         {
             f_testReturnCode = PROTOCOL_NACK_REQUEST_FAILED;
 
-            len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+            len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
             REQUIRE(len == 2);
             REQUIRE(res.at(0) == PROTOCOL_SID_PUT_METADATA);
             REQUIRE(res.at(1) == PROTOCOL_NACK_REQUEST_FAILED);
         }
         WHEN("Operation succeeds")
         {
-            len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+            len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
             REQUIRE(len == 2);
             REQUIRE(res.at(0) == PROTOCOL_SID_PUT_METADATA);
             REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
@@ -368,7 +399,7 @@ TEST_CASE("Put Fragment")
             req = {PROTOCOL_SID_PUT_FRAGMENT};
         }
 
-        len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
         REQUIRE(len == 2);
         REQUIRE(res.at(0) == PROTOCOL_SID_PUT_FRAGMENT);
         REQUIRE(res.at(1) == PROTOCOL_NACK_INVALID_REQUEST);
@@ -381,14 +412,14 @@ TEST_CASE("Put Fragment")
         {
             f_testReturnCode = PROTOCOL_NACK_REQUEST_FAILED;
 
-            len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+            len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
             REQUIRE(len == 2);
             REQUIRE(res.at(0) == PROTOCOL_SID_PUT_FRAGMENT);
             REQUIRE(res.at(1) == PROTOCOL_NACK_REQUEST_FAILED);
         }
         WHEN("Operation succeeds")
         {
-            len = US_ProcessRequest(&server, req.data(), req.size(), res.data(), res.size());
+            len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
             REQUIRE(len == 2);
             REQUIRE(res.at(0) == PROTOCOL_SID_PUT_FRAGMENT);
             REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
@@ -397,6 +428,133 @@ TEST_CASE("Put Fragment")
             REQUIRE(f_writeData.at(0) == 0xAA);
             REQUIRE(f_writeData.at(1) == 0xBB);
             REQUIRE(f_writeData.at(2) == 0xCC);
+            REQUIRE(f_putCapacity == 3U);
+        }
+        WHEN("Request buffer has spare room")
+        {
+            req.resize(64U);
+            len = US_ProcessRequest(&server, req.data(), 4U, req.size(), res.data(), res.size());
+            REQUIRE(len == 2);
+            REQUIRE(res.at(1) == PROTOCOL_ACK_OK);
+
+            REQUIRE(f_writeData.size() == 3U);
+            REQUIRE(f_putCapacity == 63U);
+        }
+    }
+}
+
+TEST_CASE("Response Cache")
+{
+    UpdateServer_t server;
+    InitTestSuite(server);
+
+    ResponseCache_t cache;
+    ResponseCacheEntry_t entries[2];
+
+    size_t len = 0U;
+    std::vector<uint8_t> res(128);
+
+    const std::vector<uint8_t> meta = {PROTOCOL_SID_PUT_METADATA, 0xAA, 0xBB};
+    const std::vector<uint8_t> frag1 = {PROTOCOL_SID_PUT_FRAGMENT, 0x01, 0x02};
+    const std::vector<uint8_t> frag2 = {PROTOCOL_SID_PUT_FRAGMENT, 0x03, 0x04};
+    const std::vector<uint8_t> frag3 = {PROTOCOL_SID_PUT_FRAGMENT, 0x05, 0x06};
+
+    auto process = [&](std::vector<uint8_t> req) {
+        len = US_ProcessRequest(&server, req.data(), req.size(), req.size(), res.data(), res.size());
+        REQUIRE(len == 2);
+        REQUIRE(res.at(0) == req.at(0));
+        return res.at(1);
+    };
+
+    SECTION("Invalid parameters")
+    {
+        REQUIRE_FALSE(US_SetResponseCache(nullptr, &cache, entries, 2, &TestHash));
+        REQUIRE_FALSE(US_SetResponseCache(&server, &cache, nullptr, 2, &TestHash));
+        REQUIRE_FALSE(US_SetResponseCache(&server, &cache, entries, 0, &TestHash));
+        REQUIRE_FALSE(US_SetResponseCache(&server, &cache, entries, 2, nullptr));
+        REQUIRE(server.cache == nullptr);
+        US_ClearResponseCache(nullptr);
+        US_ClearResponseCache(&server);
+    }
+    SECTION("No cache")
+    {
+        REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+        REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+        REQUIRE(f_putCalls == 2U);
+    }
+    SECTION("Retransmission is answered from cache")
+    {
+        REQUIRE(US_SetResponseCache(&server, &cache, entries, 2, &TestHash));
+
+        REQUIRE(process(meta) == PROTOCOL_ACK_OK);
+        REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+        REQUIRE(f_putCalls == 2U);
+
+        REQUIRE(process(meta) == PROTOCOL_ACK_OK);
+        REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+        REQUIRE(f_putCalls == 2U);
+
+        WHEN("Oldest entry is replaced")
+        {
+            REQUIRE(process(frag2) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+
+            REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+            REQUIRE(process(frag2) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+
+            REQUIRE(process(meta) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 4U);
+        }
+        WHEN("Failed requests are not cached")
+        {
+            f_testReturnCode = PROTOCOL_NACK_BUSY_REPEAT_REQUEST;
+            REQUIRE(process(frag3) == PROTOCOL_NACK_BUSY_REPEAT_REQUEST);
+            f_testReturnCode = PROTOCOL_ACK_OK;
+            REQUIRE(process(frag3) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 4U);
+        }
+        WHEN("Write data by ID clears the cache")
+        {
+            const std::vector<uint8_t> write = {PROTOCOL_SID_WRITE_DATA_BY_ID, PROTOCOL_DATA_ID_FIRMWARE_UPDATE, 0x00};
+            REQUIRE(process(write) == PROTOCOL_ACK_OK);
+
+            REQUIRE(process(meta) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+            REQUIRE(f_writeData.size() == 2U);
+        }
+        WHEN("Accepted metadata clears the cache")
+        {
+            const std::vector<uint8_t> meta2 = {PROTOCOL_SID_PUT_METADATA, 0xCC, 0xDD};
+            REQUIRE(process(meta2) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+
+            REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 4U);
+            REQUIRE(process(meta2) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 4U);
+        }
+        WHEN("Rejected metadata keeps the cache")
+        {
+            const std::vector<uint8_t> meta2 = {PROTOCOL_SID_PUT_METADATA, 0xCC, 0xDD};
+            f_testReturnCode = PROTOCOL_NACK_INVALID_REQUEST;
+            REQUIRE(process(meta2) == PROTOCOL_NACK_INVALID_REQUEST);
+            f_testReturnCode = PROTOCOL_ACK_OK;
+
+            REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+        }
+        WHEN("Cache is cleared")
+        {
+            US_ClearResponseCache(&server);
+            REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
+        }
+        WHEN("Cache is detached")
+        {
+            REQUIRE(US_SetResponseCache(&server, nullptr, nullptr, 0, nullptr));
+            REQUIRE(process(frag1) == PROTOCOL_ACK_OK);
+            REQUIRE(f_putCalls == 3U);
         }
     }
 }
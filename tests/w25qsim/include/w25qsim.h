@@ -0,0 +1,208 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * w25qsim.h
+ *
+ * @brief SPI level W25Qxx device model with datasheet timing
+ * 
+ * The model executes W25Q commands as seen on the bus and advances a virtual
+ * clock by the bus time of every transaction and by the delays requested by
+ * the driver. Programs, erases and status register writes keep the device
+ * busy for their datasheet time, so interface logic can be benchmarked on
+ * the host in virtual time.
+ * 
+ * W25QSIM_SpiQspiWriteRead, W25QSIM_DelayMs and W25QSIM_DelayUs match the
+ * libdriver w25qxx handle callbacks and use the device set with
+ * W25QSIM_Select. W25QSIM_TransferBytes takes raw single line SPI bytes,
+ * e.g. for W25QxxAsyncPort_t.
+*/
+
+#ifndef W25QSIM_H_
+#define W25QSIM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    uint32_t clockHz;               /* SPI clock */
+    uint32_t transactionNs;         /* Chip select and host overhead per command */
+    uint32_t pageProgramUs;         /* tPP */
+    uint32_t sectorEraseUs;         /* tSE */
+    uint32_t blockErase32Us;        /* tBE1 */
+    uint32_t blockErase64Us;        /* tBE2 */
+    uint32_t chipEraseUs;           /* tCE */
+    uint32_t statusWriteUs;         /* tW */
+    uint32_t suspendUs;             /* tSUS */
+    uint32_t resetUs;               /* tRST */
+} W25QSimTiming_t;
+
+typedef struct
+{
+    uint32_t commands;
+    uint32_t statusPolls;
+    uint32_t pagePrograms;
+    uint32_t erases;
+    uint32_t suspends;
+    uint32_t violations;            /* Commands the device would ignore or corrupt */
+    uint64_t bytesRead;
+    uint64_t bytesProgrammed;
+    uint64_t busNs;                 /* Time spent in transactions */
+} W25QSimStats_t;
+
+typedef struct
+{
+    uint8_t*        memory;
+    size_t          size;
+    W25QSimTiming_t timing;
+    W25QSimStats_t  stats;
+
+    uint64_t        nowNs;
+    uint64_t        busyUntilNs;
+    uint64_t        suspendedNs;    /* Remaining busy time of the suspended command */
+    uint32_t        opAddress;      /* Range of the program or erase in progress */
+    uint32_t        opSize;
+    uint8_t         status[3];
+    bool            suspended;
+    bool            continuous;     /* Continuous read mode, no instruction */
+    bool            qpi;            /* QPI mode (38h), instructions on 4 lines */
+    bool            address4;       /* 4 byte address mode */
+    bool            poweredDown;
+    bool            resetEnabled;
+    bool            volatileStatus; /* 50h before a status register write */
+} W25QSim_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC VARIABLE DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+/* Typical W25Q128JV timing at 50 MHz */
+extern const W25QSimTiming_t W25QSIM_TIMING_W25Q128JV;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Initialize device in erased state
+ * 
+ * @param sim Device
+ * @param memory Device memory
+ * @param size Memory size, power of two from 64 KB
+ * @param timing Timing, NULL for W25QSIM_TIMING_W25Q128JV
+ */
+extern void W25QSIM_Init(
+    W25QSim_t* sim,
+    uint8_t* memory,
+    size_t size,
+    const W25QSimTiming_t* timing
+);
+
+/** JEDEC ID (9Fh) and the libdriver type (manufacturer and device ID, 90h) */
+extern uint32_t W25QSIM_JedecId(const W25QSim_t* sim);
+extern uint16_t W25QSIM_Type(const W25QSim_t* sim);
+
+/** Device is programming or erasing */
+extern bool W25QSIM_IsBusy(const W25QSim_t* sim);
+
+/** Advance virtual time */
+extern void W25QSIM_Advance(W25QSim_t* sim, uint64_t ns);
+
+/** Advance virtual time until the device is ready */
+extern void W25QSIM_WaitReady(W25QSim_t* sim);
+
+/** Execute one transaction in libdriver w25qxx callback form
+ * 
+ * Line counts of 0 omit the phase, dummy is given in clock cycles. An
+ * instruction line count of 0 outside continuous read mode is a libdriver
+ * SPI handle transaction: inBuf starts with the instruction and address,
+ * followed by dummy bytes or data. In QPI mode, entered with 38h and left
+ * with FFh, instructions must use 4 lines and other transactions count as
+ * violations.
+ * 
+ * @return 0 on success
+ */
+extern uint8_t W25QSIM_Transfer(
+    W25QSim_t* sim,
+    uint8_t instruction, uint8_t instructionLine,
+    uint32_t address, uint8_t addressLine, uint8_t addressLen,
+    uint32_t alternate, uint8_t alternateLine, uint8_t alternateLen,
+    uint8_t dummy,
+    const uint8_t* inBuf, uint32_t inLen,
+    uint8_t* outBuf, uint32_t outLen,
+    uint8_t dataLine
+);
+
+/** Execute one single line SPI transaction from raw bytes
+ * 
+ * @param cmd Instruction followed by address and dummy bytes
+ * @param tx Data to device or NULL
+ * @param rx Data from device or NULL
+ */
+extern bool W25QSIM_TransferBytes(
+    W25QSim_t* sim,
+    const uint8_t* cmd,
+    size_t cmdLen,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t dataLen
+);
+
+/** Select device for the libdriver callbacks below */
+extern void W25QSIM_Select(W25QSim_t* sim);
+
+extern uint8_t W25QSIM_SpiQspiInit(void);
+extern uint8_t W25QSIM_SpiQspiDeinit(void);
+extern uint8_t W25QSIM_SpiQspiWriteRead(
+    uint8_t instruction, uint8_t instruction_line,
+    uint32_t address, uint8_t address_line, uint8_t address_len,
+    uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+    uint8_t dummy,
+    uint8_t* in_buf, uint32_t in_len,
+    uint8_t* out_buf, uint32_t out_len,
+    uint8_t data_line
+);
+extern void W25QSIM_DelayMs(uint32_t ms);
+extern void W25QSIM_DelayUs(uint32_t us);
+extern void W25QSIM_DebugPrint(const char* const fmt, ...);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF w25qsim.h */
+
+#endif /* W25QSIM_H_ */
@@ -0,0 +1,666 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * w25qsim.c
+ *
+ * @brief SPI level W25Qxx device model with datasheet timing
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "w25qsim.h"
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define MANUFACTURER_ID     (0xEFU)
+#define MEMORY_TYPE         (0x40U)
+
+#define PAGE_SIZE           (256U)
+#define SECTOR_SIZE         (4096U)
+
+#define SR1_BUSY            (0x01U)
+#define SR1_WEL             (0x02U)
+#define SR2_QE              (0x02U)
+#define SR2_SUS             (0x80U)
+#define SR3_ADS             (0x01U)
+
+#define NS_PER_US           (1000ULL)
+#define NS_PER_S            (1000000000ULL)
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+const W25QSimTiming_t W25QSIM_TIMING_W25Q128JV = {
+    .clockHz = 50000000U,
+    .transactionNs = 200U,
+    .pageProgramUs = 400U,
+    .sectorEraseUs = 45000U,
+    .blockErase32Us = 120000U,
+    .blockErase64Us = 150000U,
+    .chipEraseUs = 40000000U,
+    .statusWriteUs = 10000U,
+    .suspendUs = 20U,
+    .resetUs = 30U,
+};
+
+static W25QSim_t* f_selected;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static uint8_t CapacityCode(const W25QSim_t* sim)
+{
+    uint8_t code = 0U;
+    while (((size_t)1U << code) < sim->size)
+    {
+        code++;
+    }
+    return code;
+}
+
+static uint64_t Cycles(uint32_t bytes, uint8_t lines)
+{
+    return ((uint64_t)bytes * 8U) / ((lines != 0U) ? lines : 1U);
+}
+
+static uint8_t Status(const W25QSim_t* sim, size_t index)
+{
+    uint8_t status = sim->status[index];
+
+    if (index == 0U)
+    {
+        status = (uint8_t)((status & ~SR1_BUSY) | (W25QSIM_IsBusy(sim) ? SR1_BUSY : 0U));
+    }
+    else if (index == 1U)
+    {
+        status = (uint8_t)((status & ~SR2_SUS) | (sim->suspended ? SR2_SUS : 0U));
+    }
+    else
+    {
+        status = (uint8_t)((status & ~SR3_ADS) | (sim->address4 ? SR3_ADS : 0U));
+    }
+
+    return status;
+}
+
+static bool InOperation(const W25QSim_t* sim, uint32_t address, uint32_t size)
+{
+    return ((uint64_t)address < ((uint64_t)sim->opAddress + sim->opSize)) &&
+           ((uint64_t)sim->opAddress < ((uint64_t)address + size));
+}
+
+/* Program or erase accepted only with WEL set and the device ready */
+static bool StartModify(W25QSim_t* sim, uint32_t address, uint32_t size)
+{
+    if (((sim->status[0] & SR1_WEL) == 0U) ||
+        W25QSIM_IsBusy(sim) ||
+        (sim->suspended && InOperation(sim, address, size)))
+    {
+        sim->stats.violations++;
+        return false;
+    }
+
+    sim->status[0] &= (uint8_t)~SR1_WEL;
+    return true;
+}
+
+static void StartBusy(W25QSim_t* sim, uint32_t us, uint32_t address, uint32_t size)
+{
+    sim->busyUntilNs = sim->nowNs + (uint64_t)us * NS_PER_US;
+    if (!sim->suspended)
+    {
+        sim->opAddress = address;
+        sim->opSize = size;
+    }
+}
+
+static void Read(W25QSim_t* sim, uint32_t address, uint8_t* out, uint32_t len)
+{
+    if ((W25QSIM_IsBusy(sim) && !sim->suspended) ||
+        (sim->suspended && InOperation(sim, address, len)))
+    {
+        sim->stats.violations++;
+    }
+
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        out[i] = sim->memory[(address + i) % sim->size];
+    }
+
+    sim->stats.bytesRead += len;
+}
+
+static void Program(W25QSim_t* sim, uint32_t address, const uint8_t* in, uint32_t len)
+{
+    address %= (uint32_t)sim->size;
+
+    const uint32_t page = address - (address % PAGE_SIZE);
+
+    if (!StartModify(sim, page, PAGE_SIZE))
+    {
+        return;
+    }
+
+    /* Data past the page end wraps to the page start */
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        sim->memory[page + ((address - page + i) % PAGE_SIZE)] &= in[i];
+    }
+
+    StartBusy(sim, sim->timing.pageProgramUs, page, PAGE_SIZE);
+    sim->stats.pagePrograms++;
+    sim->stats.bytesProgrammed += len;
+}
+
+static void Erase(W25QSim_t* sim, uint32_t address, uint32_t size, uint32_t us)
+{
+    address %= (uint32_t)sim->size;
+    address -= address % size;
+
+    if (!StartModify(sim, address, size))
+    {
+        return;
+    }
+
+    memset(&sim->memory[address], 0xFF, size);
+
+    StartBusy(sim, us, address, size);
+    sim->stats.erases++;
+}
+
+static void WriteStatus(W25QSim_t* sim, size_t index, const uint8_t* in, uint32_t len)
+{
+    if (!sim->volatileStatus && !StartModify(sim, 0U, 0U))
+    {
+        return;
+    }
+
+    for (uint32_t i = 0U; (i < len) && ((index + i) < sizeof(sim->status)); i++)
+    {
+        sim->status[index + i] = in[i];
+    }
+
+    /* Volatile writes take effect without the write cycle */
+    if (!sim->volatileStatus)
+    {
+        StartBusy(sim, sim->timing.statusWriteUs, 0U, 0U);
+    }
+    sim->volatileStatus = false;
+}
+
+static void Suspend(W25QSim_t* sim)
+{
+    sim->stats.suspends++;
+
+    if (!W25QSIM_IsBusy(sim) || sim->suspended || (sim->opSize == 0U) || (sim->opSize >= sim->size))
+    {
+        /* Nothing to suspend, status write or chip erase */
+        return;
+    }
+
+    sim->suspendedNs = sim->busyUntilNs - sim->nowNs;
+    sim->suspended = true;
+    sim->busyUntilNs = sim->nowNs + (uint64_t)sim->timing.suspendUs * NS_PER_US;
+}
+
+static void Resume(W25QSim_t* sim)
+{
+    if (sim->suspended)
+    {
+        sim->suspended = false;
+        sim->busyUntilNs = sim->nowNs + sim->suspendedNs;
+        sim->suspendedNs = 0U;
+    }
+}
+
+static void Reset(W25QSim_t* sim)
+{
+    sim->status[0] &= (uint8_t)~SR1_WEL;
+    sim->suspended = false;
+    sim->suspendedNs = 0U;
+    sim->continuous = false;
+    sim->qpi = false;
+    sim->address4 = false;
+    sim->busyUntilNs = sim->nowNs + (uint64_t)sim->timing.resetUs * NS_PER_US;
+    sim->opSize = 0U;
+}
+
+static void Fill(uint8_t* out, uint32_t len, const uint8_t* data, uint32_t dataLen)
+{
+    for (uint32_t i = 0U; i < len; i++)
+    {
+        out[i] = (i < dataLen) ? data[i] : 0xFFU;
+    }
+}
+
+static bool HasAddress(uint8_t instruction)
+{
+    switch (instruction)
+    {
+    case 0x03U: case 0x0BU: case 0x3BU: case 0x6BU: case 0xBBU: case 0xEBU:
+    case 0x02U: case 0x32U: case 0x20U: case 0x52U: case 0xD8U: case 0x90U:
+    case 0x5AU: case 0x48U: case 0x42U: case 0x44U:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+void W25QSIM_Init(
+    W25QSim_t* sim,
+    uint8_t* memory,
+    size_t size,
+    const W25QSimTiming_t* timing
+)
+{
+    memset(sim, 0, sizeof(W25QSim_t));
+    sim->memory = memory;
+    sim->size = size;
+    sim->timing = (timing != NULL) ? *timing : W25QSIM_TIMING_W25Q128JV;
+    memset(memory, 0xFF, size);
+
+    /* IQ parts ship with the quad enable bit set */
+    sim->status[1] = SR2_QE;
+}
+
+uint32_t W25QSIM_JedecId(const W25QSim_t* sim)
+{
+    return (MANUFACTURER_ID << 16U) | (MEMORY_TYPE << 8U) | CapacityCode(sim);
+}
+
+uint16_t W25QSIM_Type(const W25QSim_t* sim)
+{
+    return (uint16_t)((MANUFACTURER_ID << 8U) | (uint8_t)(CapacityCode(sim) - 1U));
+}
+
+bool W25QSIM_IsBusy(const W25QSim_t* sim)
+{
+    return sim->nowNs < sim->busyUntilNs;
+}
+
+void W25QSIM_Advance(W25QSim_t* sim, uint64_t ns)
+{
+    sim->nowNs += ns;
+}
+
+void W25QSIM_WaitReady(W25QSim_t* sim)
+{
+    if (sim->nowNs < sim->busyUntilNs)
+    {
+        sim->nowNs = sim->busyUntilNs;
+    }
+}
+
+uint8_t W25QSIM_Transfer(
+    W25QSim_t* sim,
+    uint8_t instruction, uint8_t instructionLine,
+    uint32_t address, uint8_t addressLine, uint8_t addressLen,
+    uint32_t alternate, uint8_t alternateLine, uint8_t alternateLen,
+    uint8_t dummy,
+    const uint8_t* inBuf, uint32_t inLen,
+    uint8_t* outBuf, uint32_t outLen,
+    uint8_t dataLine
+)
+{
+    if (NULL == sim)
+    {
+        return 1U;
+    }
+
+    /* Bus time of the transaction */
+    uint64_t cycles = dummy;
+    cycles += (instructionLine != 0U) ? Cycles(1U, instructionLine) : 0U;
+    cycles += (addressLine != 0U) ? Cycles(addressLen, addressLine) : 0U;
+    cycles += (alternateLine != 0U) ? Cycles(alternateLen, alternateLine) : 0U;
+    cycles += Cycles(inLen + outLen, dataLine);
+
+    const uint64_t busNs = ((cycles * NS_PER_S) / sim->timing.clockHz) + sim->timing.transactionNs;
+    sim->nowNs += busNs;
+    sim->stats.busNs += busNs;
+    sim->stats.commands++;
+
+    if (sim->continuous)
+    {
+        if (instructionLine == 0U)
+        {
+            instruction = 0xEBU;
+        }
+        else
+        {
+            /* The instruction would be taken as an address, FFh resets the mode */
+            sim->continuous = false;
+            if (instruction != 0xFFU)
+            {
+                sim->stats.violations++;
+            }
+            return 0U;
+        }
+    }
+    else
+    {
+        if (instructionLine == 0U)
+        {
+            /* SPI handle, instruction and address lead the bytes sent */
+            const uint8_t commandLen = (uint8_t)(1U + (((inLen != 0U) && HasAddress(inBuf[0])) ? (sim->address4 ? 4U : 3U) : 0U));
+            if (inLen < commandLen)
+            {
+                sim->stats.violations++;
+                return 0U;
+            }
+
+            instruction = inBuf[0];
+            address = 0U;
+            for (uint8_t i = 1U; i < commandLen; i++)
+            {
+                address = (address << 8U) | inBuf[i];
+            }
+
+            /* Dummy bytes for reads, data for writes */
+            inBuf += commandLen;
+            inLen -= commandLen;
+            instructionLine = 1U;
+        }
+
+        /* The instruction is not decoded on the wrong number of lines */
+        if (instructionLine != (sim->qpi ? 4U : 1U))
+        {
+            sim->stats.violations++;
+            return 0U;
+        }
+    }
+
+    if (sim->poweredDown && (instruction != 0xABU))
+    {
+        sim->stats.violations++;
+        return 0U;
+    }
+
+    if (sim->resetEnabled && (instruction == 0x99U))
+    {
+        sim->resetEnabled = false;
+        Reset(sim);
+        return 0U;
+    }
+    sim->resetEnabled = (instruction == 0x66U);
+
+    switch (instruction)
+    {
+    /* Status and configuration */
+    case 0x05U:
+    case 0x35U:
+    case 0x15U:
+    {
+        const size_t index = (instruction == 0x05U) ? 0U : ((instruction == 0x35U) ? 1U : 2U);
+        for (uint32_t i = 0U; i < outLen; i++)
+        {
+            outBuf[i] = Status(sim, index);
+        }
+        sim->stats.statusPolls++;
+        break;
+    }
+    case 0x01U:
+        WriteStatus(sim, 0U, inBuf, inLen);
+        break;
+    case 0x31U:
+        WriteStatus(sim, 1U, inBuf, inLen);
+        break;
+    case 0x11U:
+        WriteStatus(sim, 2U, inBuf, inLen);
+        break;
+    case 0x50U:
+        sim->volatileStatus = true;
+        break;
+    case 0x06U:
+        sim->status[0] |= SR1_WEL;
+        break;
+    case 0x04U:
+        sim->status[0] &= (uint8_t)~SR1_WEL;
+        break;
+    case 0xB7U:
+        sim->address4 = true;
+        break;
+    case 0xE9U:
+        sim->address4 = false;
+        break;
+    case 0x38U:
+        if (sim->qpi || ((sim->status[1] & SR2_QE) == 0U))
+        {
+            sim->stats.violations++;
+        }
+        else
+        {
+            sim->qpi = true;
+        }
+        break;
+    case 0xFFU:
+        /* Exits QPI mode, no effect in SPI mode */
+        sim->qpi = false;
+        break;
+
+    /* Reads */
+    case 0x03U:
+    case 0x0BU:
+    case 0x3BU:
+    case 0x6BU:
+    case 0xBBU:
+    case 0xEBU:
+        if (((instruction == 0x6BU) || (instruction == 0xEBU)) && ((sim->status[1] & SR2_QE) == 0U))
+        {
+            sim->stats.violations++;
+        }
+        /* QPI mode supports only fast read and fast read quad I/O */
+        if (sim->qpi && (instruction != 0x0BU) && (instruction != 0xEBU))
+        {
+            sim->stats.violations++;
+        }
+        Read(sim, address, outBuf, outLen);
+        if (((instruction == 0xEBU) || (instruction == 0xBBU)) && (alternateLen != 0U))
+        {
+            sim->continuous = ((alternate & 0x30U) == 0x20U);
+        }
+        break;
+
+    /* Program and erase */
+    case 0x02U:
+    case 0x32U:
+        Program(sim, address, inBuf, inLen);
+        break;
+    case 0x20U:
+        Erase(sim, address, SECTOR_SIZE, sim->timing.sectorEraseUs);
+        break;
+    case 0x52U:
+        Erase(sim, address, 32U * 1024U, sim->timing.blockErase32Us);
+        break;
+    case 0xD8U:
+        Erase(sim, address, 64U * 1024U, sim->timing.blockErase64Us);
+        break;
+    case 0xC7U:
+    case 0x60U:
+        Erase(sim, 0U, (uint32_t)sim->size, sim->timing.chipEraseUs);
+        break;
+    case 0x75U:
+        Suspend(sim);
+        break;
+    case 0x7AU:
+        Resume(sim);
+        break;
+
+    /* Identification */
+    case 0x9FU:
+    {
+        const uint32_t id = W25QSIM_JedecId(sim);
+        const uint8_t data[] = {(uint8_t)(id >> 16U), (uint8_t)(id >> 8U), (uint8_t)id};
+        Fill(outBuf, outLen, data, sizeof(data));
+        break;
+    }
+    case 0x90U:
+    case 0x92U:
+    case 0x94U:
+    {
+        const uint16_t type = W25QSIM_Type(sim);
+        const uint8_t data[] = {(uint8_t)(type >> 8U), (uint8_t)type};
+        Fill(outBuf, outLen, data, sizeof(data));
+        break;
+    }
+    case 0xABU:
+    {
+        const uint8_t data[] = {(uint8_t)W25QSIM_Type(sim)};
+        sim->poweredDown = false;
+        Fill(outBuf, outLen, data, sizeof(data));
+        break;
+    }
+    case 0xB9U:
+        sim->poweredDown = true;
+        break;
+    case 0x4BU:
+    {
+        const uint8_t data[] = {0x57U, 0x53U, 0x49U, 0x4DU, 0x00U, 0x00U, 0x00U, 0x01U};
+        Fill(outBuf, outLen, data, sizeof(data));
+        break;
+    }
+
+    default:
+        /* SFDP, security registers, locks and others read erased */
+        Fill(outBuf, outLen, NULL, 0U);
+        break;
+    }
+
+    return 0U;
+}
+
+bool W25QSIM_TransferBytes(
+    W25QSim_t* sim,
+    const uint8_t* cmd,
+    size_t cmdLen,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t dataLen
+)
+{
+    if ((NULL == sim) || (NULL == cmd) || (cmdLen == 0U))
+    {
+        return false;
+    }
+
+    const uint8_t instruction = cmd[0];
+    uint8_t addressLen = 0U;
+    uint32_t address = 0U;
+
+    if (HasAddress(instruction))
+    {
+        addressLen = sim->address4 ? 4U : 3U;
+        if (cmdLen < (1U + (size_t)addressLen))
+        {
+            return false;
+        }
+        for (uint8_t i = 0U; i < addressLen; i++)
+        {
+            address = (address << 8U) | cmd[1U + i];
+        }
+    }
+
+    const uint8_t dummy = (uint8_t)((cmdLen - 1U - addressLen) * 8U);
+
+    return 0U == W25QSIM_Transfer(
+        sim,
+        instruction, 1U,
+        address, (addressLen != 0U) ? 1U : 0U, addressLen,
+        0U, 0U, 0U,
+        dummy,
+        tx, (NULL != tx) ? (uint32_t)dataLen : 0U,
+        rx, (NULL != rx) ? (uint32_t)dataLen : 0U,
+        1U
+    );
+}
+
+void W25QSIM_Select(W25QSim_t* sim)
+{
+    f_selected = sim;
+}
+
+uint8_t W25QSIM_SpiQspiInit(void)
+{
+    return (NULL != f_selected) ? 0U : 1U;
+}
+
+uint8_t W25QSIM_SpiQspiDeinit(void)
+{
+    return 0U;
+}
+
+uint8_t W25QSIM_SpiQspiWriteRead(
+    uint8_t instruction, uint8_t instruction_line,
+    uint32_t address, uint8_t address_line, uint8_t address_len,
+    uint32_t alternate, uint8_t alternate_line, uint8_t alternate_len,
+    uint8_t dummy,
+    uint8_t* in_buf, uint32_t in_len,
+    uint8_t* out_buf, uint32_t out_len,
+    uint8_t data_line
+)
+{
+    return W25QSIM_Transfer(
+        f_selected,
+        instruction, instruction_line,
+        address, address_line, address_len,
+        alternate, alternate_line, alternate_len,
+        dummy,
+        in_buf, in_len,
+        out_buf, out_len,
+        data_line
+    );
+}
+
+void W25QSIM_DelayMs(uint32_t ms)
+{
+    if (NULL != f_selected)
+    {
+        W25QSIM_Advance(f_selected, (uint64_t)ms * 1000U * NS_PER_US);
+    }
+}
+
+void W25QSIM_DelayUs(uint32_t us)
+{
+    if (NULL != f_selected)
+    {
+        W25QSIM_Advance(f_selected, (uint64_t)us * NS_PER_US);
+    }
+}
+
+void W25QSIM_DebugPrint(const char* const fmt, ...)
+{
+    (void)fmt;
+}
+
+/* EoF w25qsim.c */
@@ -0,0 +1,375 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+//
+// w25qsim_test.cpp
+//
+// Unit tests for the W25Qxx SPI level simulator
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <vector>
+
+#include "w25qsim.h"
+#include "w25qxx/async_interface.h"
+
+// -----------------------------------------------------------------------------
+// PRIVATE TYPE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+// Simulated device with an asynchronous port completing on the next step
+class SimFlash
+{
+public:
+    explicit SimFlash(size_t size) : memory(size)
+    {
+        W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+    }
+
+    static bool Transfer(void* port, const uint8_t* cmd, size_t cmdLen, const uint8_t* tx, uint8_t* rx, size_t dataLen)
+    {
+        SimFlash* self = (SimFlash*)port;
+        self->pending = W25QSIM_TransferBytes(&self->sim, cmd, cmdLen, tx, rx, dataLen);
+        return self->pending;
+    }
+
+    static void Idle(void* port)
+    {
+        SimFlash* self = (SimFlash*)port;
+        if (self->pending)
+        {
+            self->pending = false;
+            W25Qxx_ASYNC_OnTransferDone(self->handle, true);
+        }
+        else
+        {
+            W25QSIM_Advance(&self->sim, TICK_NS);
+            W25Qxx_ASYNC_OnTick(self->handle);
+        }
+    }
+
+    W25QxxAsyncPort_t Port()
+    {
+        W25QxxAsyncPort_t port = {};
+        port.Transfer = Transfer;
+        port.Idle = Idle;
+        port.port = this;
+        return port;
+    }
+
+    static constexpr uint64_t TICK_NS = 100000U;
+
+    std::vector<uint8_t> memory;
+    W25QSim_t sim;
+    W25QxxAsync_t* handle = nullptr;
+    bool pending = false;
+};
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static void Command(W25QSim_t* sim, uint8_t instruction)
+{
+    REQUIRE(W25QSIM_Transfer(sim, instruction, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, NULL, 0U, NULL, 0U, 0U) == 0U);
+}
+
+static uint8_t Status1(W25QSim_t* sim)
+{
+    uint8_t status = 0U;
+    REQUIRE(W25QSIM_Transfer(sim, 0x05U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, NULL, 0U, &status, 1U, 1U) == 0U);
+    return status;
+}
+
+static void Program(W25QSim_t* sim, uint32_t address, const uint8_t* data, uint32_t len)
+{
+    Command(sim, 0x06U);
+    REQUIRE(W25QSIM_Transfer(sim, 0x02U, 1U, address, 1U, 3U, 0U, 0U, 0U, 0U, (uint8_t*)data, len, NULL, 0U, 1U) == 0U);
+}
+
+static void Read(W25QSim_t* sim, uint32_t address, uint8_t* out, uint32_t len)
+{
+    REQUIRE(W25QSIM_Transfer(sim, 0x03U, 1U, address, 1U, 3U, 0U, 0U, 0U, 0U, NULL, 0U, out, len, 1U) == 0U);
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASES
+// -----------------------------------------------------------------------------
+
+TEST_CASE("W25QSim: identification")
+{
+    std::vector<uint8_t> memory(16U * 1024U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+
+    REQUIRE(W25QSIM_JedecId(&sim) == 0xEF4018U);
+    REQUIRE(W25QSIM_Type(&sim) == 0xEF17U);
+
+    uint8_t id[3] = {0};
+    REQUIRE(W25QSIM_Transfer(&sim, 0x9FU, 1U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, NULL, 0U, id, 3U, 1U) == 0U);
+    REQUIRE(id[0] == 0xEFU);
+    REQUIRE(id[1] == 0x40U);
+    REQUIRE(id[2] == 0x18U);
+}
+
+TEST_CASE("W25QSim: program timing and semantics")
+{
+    std::vector<uint8_t> memory(64U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+
+    const uint8_t first[] = {0xF0U, 0xFFU};
+    const uint8_t second[] = {0x3CU, 0x0FU};
+
+    // Needs write enable
+    REQUIRE(W25QSIM_Transfer(&sim, 0x02U, 1U, 0x100U, 1U, 3U, 0U, 0U, 0U, 0U, (uint8_t*)first, 2U, NULL, 0U, 1U) == 0U);
+    REQUIRE(memory[0x100U] == 0xFFU);
+    REQUIRE(sim.stats.violations == 1U);
+
+    Program(&sim, 0x100U, first, 2U);
+    REQUIRE((Status1(&sim) & 0x01U) != 0U);
+    REQUIRE((Status1(&sim) & 0x02U) == 0U);
+
+    // Reading during the program is a violation
+    uint8_t out[2] = {0};
+    Read(&sim, 0x100U, out, 2U);
+    REQUIRE(sim.stats.violations == 2U);
+
+    const uint64_t start = sim.nowNs;
+    W25QSIM_WaitReady(&sim);
+    REQUIRE(sim.nowNs - start <= 400000U);
+    REQUIRE(sim.nowNs >= 400000U);
+    REQUIRE((Status1(&sim) & 0x01U) == 0U);
+
+    // Bits only clear
+    Program(&sim, 0x100U, second, 2U);
+    W25QSIM_WaitReady(&sim);
+    Read(&sim, 0x100U, out, 2U);
+    REQUIRE(out[0] == 0x30U);
+    REQUIRE(out[1] == 0x0FU);
+
+    // Page wrap
+    const uint8_t wrap[] = {0x11U, 0x22U};
+    Program(&sim, 0x2FFU, wrap, 2U);
+    W25QSIM_WaitReady(&sim);
+    REQUIRE(memory[0x2FFU] == 0x11U);
+    REQUIRE(memory[0x200U] == 0x22U);
+    REQUIRE(memory[0x300U] == 0xFFU);
+
+    REQUIRE(sim.stats.pagePrograms == 3U);
+    REQUIRE(sim.stats.violations == 2U);
+}
+
+TEST_CASE("W25QSim: bus time")
+{
+    std::vector<uint8_t> memory(64U * 1024U);
+    W25QSim_t sim;
+    W25QSimTiming_t timing = W25QSIM_TIMING_W25Q128JV;
+    timing.transactionNs = 0U;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), &timing);
+
+    std::vector<uint8_t> out(256U);
+
+    // 8 + 24 + 2048 cycles at 50 MHz
+    Read(&sim, 0U, out.data(), 256U);
+    REQUIRE(sim.nowNs == 2080U * 20U);
+
+    // Quad I/O: 8 + 6 + 2 + 4 + 512 cycles
+    const uint64_t start = sim.nowNs;
+    REQUIRE(W25QSIM_Transfer(&sim, 0xEBU, 1U, 0U, 4U, 3U, 0xFFU, 4U, 1U, 4U, NULL, 0U, out.data(), 256U, 4U) == 0U);
+    REQUIRE(sim.nowNs - start == 532U * 20U);
+}
+
+TEST_CASE("W25QSim: erase suspend and resume")
+{
+    std::vector<uint8_t> memory(256U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+
+    const uint8_t data[] = {0x00U};
+    Program(&sim, 0x1000U, data, 1U);
+    Program(&sim, 0x2000U, data, 1U);
+    REQUIRE(sim.stats.violations == 1U);
+    W25QSIM_WaitReady(&sim);
+    Program(&sim, 0x2000U, data, 1U);
+    W25QSIM_WaitReady(&sim);
+
+    Command(&sim, 0x06U);
+    REQUIRE(W25QSIM_Transfer(&sim, 0x20U, 1U, 0x1000U, 1U, 3U, 0U, 0U, 0U, 0U, NULL, 0U, NULL, 0U, 0U) == 0U);
+    const uint64_t eraseEnd = sim.busyUntilNs;
+    W25QSIM_Advance(&sim, 10000000U);
+
+    Command(&sim, 0x75U);
+    const uint64_t remaining = eraseEnd - sim.nowNs;
+    REQUIRE((Status1(&sim) & 0x01U) != 0U);
+    W25QSIM_WaitReady(&sim);
+    REQUIRE(sim.suspended);
+
+    // Other sector reads fine, the erased one does not
+    uint8_t out = 0xFFU;
+    const uint64_t violations = sim.stats.violations;
+    Read(&sim, 0x2000U, &out, 1U);
+    REQUIRE(out == 0x00U);
+    REQUIRE(sim.stats.violations == violations);
+    Read(&sim, 0x1000U, &out, 1U);
+    REQUIRE(sim.stats.violations == violations + 1U);
+
+    Command(&sim, 0x7AU);
+    REQUIRE_FALSE(sim.suspended);
+    const uint64_t resumedAt = sim.nowNs;
+    W25QSIM_WaitReady(&sim);
+
+    // Remaining erase time continues after the resume
+    REQUIRE(sim.nowNs - resumedAt == remaining);
+    REQUIRE(memory[0x1000U] == 0xFFU);
+    REQUIRE(sim.stats.suspends == 1U);
+}
+
+TEST_CASE("W25QSim: continuous read mode")
+{
+    std::vector<uint8_t> memory(64U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+
+    uint8_t out[4];
+    REQUIRE(W25QSIM_Transfer(&sim, 0xEBU, 1U, 0U, 4U, 3U, 0x20U, 4U, 1U, 4U, NULL, 0U, out, 4U, 4U) == 0U);
+    REQUIRE(sim.continuous);
+
+    // No instruction phase in continuous mode
+    REQUIRE(W25QSIM_Transfer(&sim, 0xEBU, 0U, 4U, 4U, 3U, 0xFFU, 4U, 1U, 4U, NULL, 0U, out, 4U, 4U) == 0U);
+    REQUIRE_FALSE(sim.continuous);
+    REQUIRE(sim.stats.bytesRead == 8U);
+    REQUIRE(sim.stats.violations == 0U);
+
+    // Instruction while in continuous mode is lost
+    REQUIRE(W25QSIM_Transfer(&sim, 0xEBU, 1U, 0U, 4U, 3U, 0x20U, 4U, 1U, 4U, NULL, 0U, out, 4U, 4U) == 0U);
+    Command(&sim, 0x06U);
+    REQUIRE(sim.stats.violations == 1U);
+    REQUIRE_FALSE(sim.continuous);
+}
+
+TEST_CASE("W25QSim: SPI handle sends the command in the data")
+{
+    std::vector<uint8_t> memory(64U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+
+    uint8_t writeEnable[] = {0x06U};
+    uint8_t program[] = {0x02U, 0x00U, 0x12U, 0x34U, 0xA5U, 0x5AU};
+    REQUIRE(W25QSIM_Transfer(&sim, 0x00U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, writeEnable, 1U, NULL, 0U, 1U) == 0U);
+    REQUIRE(W25QSIM_Transfer(&sim, 0x00U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, program, sizeof(program), NULL, 0U, 1U) == 0U);
+    REQUIRE(memory[0x1234U] == 0xA5U);
+    REQUIRE(memory[0x1235U] == 0x5AU);
+    W25QSIM_WaitReady(&sim);
+
+    // Fast read with the dummy byte in the data
+    uint8_t fastRead[] = {0x0BU, 0x00U, 0x12U, 0x34U, 0x00U};
+    uint8_t out[2] = {0};
+    REQUIRE(W25QSIM_Transfer(&sim, 0x00U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, fastRead, sizeof(fastRead), out, 2U, 1U) == 0U);
+    REQUIRE(out[0] == 0xA5U);
+    REQUIRE(out[1] == 0x5AU);
+    REQUIRE(sim.stats.pagePrograms == 1U);
+    REQUIRE(sim.stats.violations == 0U);
+
+    // Address cut short
+    REQUIRE(W25QSIM_Transfer(&sim, 0x00U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, fastRead, 2U, out, 2U, 1U) == 0U);
+    REQUIRE(sim.stats.violations == 1U);
+}
+
+TEST_CASE("W25QSim: QPI mode")
+{
+    std::vector<uint8_t> memory(64U * 1024U);
+    W25QSim_t sim;
+    W25QSIM_Init(&sim, memory.data(), memory.size(), NULL);
+    memory[0x100U] = 0x42U;
+
+    Command(&sim, 0x38U);
+    REQUIRE(sim.qpi);
+    REQUIRE(sim.stats.violations == 0U);
+
+    // Instructions on 4 lines, single line ones are not decoded
+    uint8_t out = 0U;
+    REQUIRE(W25QSIM_Transfer(&sim, 0x0BU, 4U, 0x100U, 4U, 3U, 0U, 0U, 0U, 2U, NULL, 0U, &out, 1U, 4U) == 0U);
+    REQUIRE(out == 0x42U);
+    REQUIRE(sim.stats.violations == 0U);
+    Read(&sim, 0x100U, &out, 1U);
+    REQUIRE(sim.stats.violations == 1U);
+
+    // Read data is not supported in QPI mode
+    REQUIRE(W25QSIM_Transfer(&sim, 0x03U, 4U, 0x100U, 4U, 3U, 0U, 0U, 0U, 0U, NULL, 0U, &out, 1U, 4U) == 0U);
+    REQUIRE(sim.stats.violations == 2U);
+
+    REQUIRE(W25QSIM_Transfer(&sim, 0xFFU, 4U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, NULL, 0U, NULL, 0U, 0U) == 0U);
+    REQUIRE_FALSE(sim.qpi);
+    Read(&sim, 0x100U, &out, 1U);
+    REQUIRE(out == 0x42U);
+    REQUIRE(sim.stats.violations == 2U);
+
+    // Quad enable is required
+    sim.status[1] = 0U;
+    Command(&sim, 0x38U);
+    REQUIRE_FALSE(sim.qpi);
+    REQUIRE(sim.stats.violations == 3U);
+}
+
+TEST_CASE("W25QSim: asynchronous interface in virtual time")
+{
+    SimFlash flash(1024U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, flash.memory.size(), NULL));
+    W25Qxx_ASYNC_SetBlockingInstance(&handle);
+
+    std::vector<uint8_t> data(1024U);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (uint8_t)(i * 13U);
+    }
+    std::vector<uint8_t> out(data.size());
+
+    REQUIRE(W25Qxx_ASYNC_WriteFlash(0x10000U, data.size(), data.data()));
+    REQUIRE(W25Qxx_ASYNC_ReadFlash(0x10000U, out.size(), out.data()));
+    REQUIRE(out == data);
+    REQUIRE(flash.sim.stats.pagePrograms == 4U);
+
+    const uint64_t start = flash.sim.nowNs;
+    REQUIRE(W25Qxx_ASYNC_EraseFlash(0x10000U, 0x1000U));
+    const uint64_t elapsed = flash.sim.nowNs - start;
+    REQUIRE(elapsed >= 45000000U);
+    REQUIRE(elapsed < 45000000U + 2U * SimFlash::TICK_NS);
+    REQUIRE(flash.memory[0x10000U] == 0xFFU);
+
+    REQUIRE(flash.sim.stats.violations == 0U);
+    W25Qxx_ASYNC_SetBlockingInstance(NULL);
+}
@@ -0,0 +1,563 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+//
+// async_interface_test.cpp
+//
+// Unit tests for the queued asynchronous W25Qxx interface
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <vector>
+
+#include "w25qxx/async_interface.h"
+
+// -----------------------------------------------------------------------------
+// PRIVATE TYPE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+// Command level flash model completing one transfer at a time
+class FakeFlash
+{
+public:
+    explicit FakeFlash(size_t size) : memory(size, 0xFFU) {}
+
+    static bool Transfer(void* port, const uint8_t* cmd, size_t cmdLen, const uint8_t* tx, uint8_t* rx, size_t dataLen)
+    {
+        FakeFlash* self = (FakeFlash*)port;
+        if (self->pending || self->failTransfers || (cmd[0] == self->failCommand))
+        {
+            self->failCommand = -1;
+            return false;
+        }
+        self->pending = true;
+        self->cmd.assign(cmd, cmd + cmdLen);
+        self->tx = tx;
+        self->rx = rx;
+        self->dataLen = dataLen;
+        return true;
+    }
+
+    static void Idle(void* port)
+    {
+        ((FakeFlash*)port)->Step();
+    }
+
+    // Complete pending transfer or tick the status polling
+    void Step()
+    {
+        if (pending)
+        {
+            pending = false;
+            Execute();
+            W25Qxx_ASYNC_OnTransferDone(handle, true);
+        }
+        else
+        {
+            W25Qxx_ASYNC_OnTick(handle);
+        }
+    }
+
+    void RunUntilIdle()
+    {
+        while (W25Qxx_ASYNC_IsBusy(handle))
+        {
+            Step();
+        }
+    }
+
+    W25QxxAsyncPort_t Port()
+    {
+        W25QxxAsyncPort_t port = {};
+        port.Transfer = Transfer;
+        port.Idle = Idle;
+        port.port = this;
+        return port;
+    }
+
+    std::vector<uint8_t> memory;
+    W25QxxAsync_t* handle = nullptr;
+    bool failTransfers = false;
+    int failCommand = -1;       // Fail the next transfer of this command
+    size_t ignoredCommands = 0;
+    size_t eraseCommands = 0;
+    size_t programCommands = 0;
+    size_t statusPolls = 0;
+    size_t suspendCommands = 0;
+    int eraseBusy = 3;
+
+private:
+    uint32_t Address() const
+    {
+        return ((uint32_t)cmd[1] << 16U) | ((uint32_t)cmd[2] << 8U) | cmd[3];
+    }
+
+    // Programs and erases are ignored while busy or suspended
+    bool Ignored()
+    {
+        if (busy > 0)
+        {
+            ignoredCommands++;
+            writeEnabled = false;
+            return true;
+        }
+        return false;
+    }
+
+    void Erase(uint32_t address, size_t size)
+    {
+        if (Ignored())
+        {
+            return;
+        }
+        REQUIRE(writeEnabled);
+        REQUIRE(address % size == 0U);
+        memset(&memory[address], 0xFF, size);
+        writeEnabled = false;
+        busy = eraseBusy;
+        busyAddress = address;
+        busySize = size;
+        eraseCommands++;
+    }
+
+    void Execute()
+    {
+        switch (cmd[0])
+        {
+        case 0x06U:
+            writeEnabled = true;
+            break;
+        case 0x05U:
+            rx[0] = ((busy > 0) && !suspended) ? 0x01U : 0x00U;
+            busy = ((busy > 0) && !suspended) ? (busy - 1) : busy;
+            statusPolls++;
+            break;
+        case 0x03U:
+        {
+            const uint32_t address = Address();
+            REQUIRE(((busy == 0) || suspended));
+            REQUIRE(((busy == 0) || (address + dataLen <= busyAddress) || (address >= busyAddress + busySize)));
+            memcpy(rx, &memory[address], dataLen);
+            break;
+        }
+        case 0x75U:
+            suspended = (busy > 0);
+            suspendCommands++;
+            break;
+        case 0x7AU:
+            suspended = false;
+            break;
+        case 0x02U:
+        {
+            if (Ignored())
+            {
+                break;
+            }
+            REQUIRE(writeEnabled);
+            const uint32_t address = Address();
+            REQUIRE((address % 256U) + dataLen <= 256U);
+            for (size_t i = 0; i < dataLen; i++)
+            {
+                memory[address + i] &= tx[i];
+            }
+            writeEnabled = false;
+            busy = 1;
+            busyAddress = address;
+            busySize = (uint32_t)dataLen;
+            programCommands++;
+            break;
+        }
+        case 0x20U:
+            Erase(Address(), 4096U);
+            break;
+        case 0x52U:
+            Erase(Address(), 32768U);
+            break;
+        case 0xD8U:
+            Erase(Address(), 65536U);
+            break;
+        case 0xC7U:
+            Erase(0U, memory.size());
+            break;
+        default:
+            FAIL("Unknown command");
+        }
+    }
+
+    bool pending = false;
+    std::vector<uint8_t> cmd;
+    const uint8_t* tx = nullptr;
+    uint8_t* rx = nullptr;
+    size_t dataLen = 0;
+    bool writeEnabled = false;
+    bool suspended = false;
+    int busy = 0;
+    uint32_t busyAddress = 0;
+    uint32_t busySize = 0;
+};
+
+// -----------------------------------------------------------------------------
+// VARIABLE DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static W25QxxAsync_t f_flashA;
+static W25QxxAsync_t f_flashB;
+
+W25QXX_ASYNC_ADAPTERS(FlashA, f_flashA)
+W25QXX_ASYNC_ADAPTERS(FlashB, f_flashB)
+
+// -----------------------------------------------------------------------------
+// PRIVATE FUNCTION DEFINITIONS
+// -----------------------------------------------------------------------------
+
+static void CountDone(void* ctx, bool ok)
+{
+    if (ok)
+    {
+        (*(int*)ctx)++;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// TEST CASES
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Async: queued program, read and erase")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, 0U, NULL));
+
+    std::vector<uint8_t> data(1000);
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = (uint8_t)(i * 7U);
+    }
+    std::vector<uint8_t> readBack(data.size());
+
+    int completed = 0;
+    const W25QxxAsyncRequest_t program = {W25QXX_ASYNC_PROGRAM, 0x1080U, data.size(), data.data(), CountDone, &completed};
+    const W25QxxAsyncRequest_t read = {W25QXX_ASYNC_READ, 0x1080U, readBack.size(), readBack.data(), CountDone, &completed};
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x1000U, 0x1000U, NULL, CountDone, &completed};
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &program));
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &read));
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    REQUIRE(W25Qxx_ASYNC_IsBusy(&handle));
+
+    flash.RunUntilIdle();
+
+    REQUIRE(completed == 3);
+    REQUIRE(readBack == data);
+    REQUIRE(flash.programCommands == 5U);   // 128 + 256 + 256 + 256 + 104
+    REQUIRE(flash.statusPolls > 0U);
+    REQUIRE(flash.memory[0x1080U] == 0xFFU);
+}
+
+TEST_CASE("Async: blocking shim")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[2];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 2U, 256U * 1024U, NULL));
+    W25Qxx_ASYNC_SetBlockingInstance(&handle);
+
+    const uint8_t data[] = {1, 2, 3, 4, 5};
+    uint8_t out[sizeof(data)] = {0};
+
+    REQUIRE(W25Qxx_ASYNC_WriteFlash(0x10000U, sizeof(data), data));
+    REQUIRE(W25Qxx_ASYNC_ReadFlash(0x10000U, sizeof(out), out));
+    REQUIRE(memcmp(data, out, sizeof(data)) == 0);
+
+    // Exactly one 64 KB block
+    REQUIRE(W25Qxx_ASYNC_EraseFlash(0x10000U, 0x10000U));
+    REQUIRE(flash.eraseCommands == 1U);
+    REQUIRE(W25Qxx_ASYNC_ReadFlash(0x10000U, sizeof(out), out));
+    REQUIRE(out[0] == 0xFFU);
+
+    REQUIRE_FALSE(W25Qxx_ASYNC_EraseFlash(0x10001U, 0x1000U));
+    W25Qxx_ASYNC_SetBlockingInstance(NULL);
+}
+
+TEST_CASE("Async: queue full and transfer errors")
+{
+    FakeFlash flash(64U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[1];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 1U, 0U, NULL));
+
+    uint8_t buf[16];
+    int completed = 0;
+    const W25QxxAsyncRequest_t read = {W25QXX_ASYNC_READ, 0U, sizeof(buf), buf, CountDone, &completed};
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &read));
+    REQUIRE_FALSE(W25Qxx_ASYNC_Submit(&handle, &read));
+    flash.RunUntilIdle();
+    REQUIRE(completed == 1);
+
+    flash.failTransfers = true;
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &read));
+    REQUIRE_FALSE(W25Qxx_ASYNC_IsBusy(&handle));
+    REQUIRE(completed == 1);
+}
+
+TEST_CASE("Async: requests beyond 3-byte addresses are rejected")
+{
+    FakeFlash flash(64U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[2];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    const size_t deviceSize = GENERATE(0U, 64U * 1024U * 1024U);
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 2U, deviceSize, NULL));
+
+    uint8_t buf[16];
+    const uint32_t limit = 16U * 1024U * 1024U;
+    const W25QxxAsyncRequest_t high = {W25QXX_ASYNC_READ, limit, sizeof(buf), buf, NULL, NULL};
+    const W25QxxAsyncRequest_t across = {W25QXX_ASYNC_PROGRAM, limit - 8U, sizeof(buf), buf, NULL, NULL};
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, limit, 0x1000U, NULL, NULL, NULL};
+    const W25QxxAsyncRequest_t last = {W25QXX_ASYNC_READ, limit - sizeof(buf), sizeof(buf), buf, NULL, NULL};
+
+    REQUIRE_FALSE(W25Qxx_ASYNC_Submit(&handle, &high));
+    REQUIRE_FALSE(W25Qxx_ASYNC_Submit(&handle, &across));
+    REQUIRE_FALSE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    REQUIRE_FALSE(W25Qxx_ASYNC_IsBusy(&handle));
+
+    // Within the limit, only checked against the queue
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 2U, 64U * 1024U, NULL));
+    REQUIRE_FALSE(W25Qxx_ASYNC_Submit(&handle, &last));
+    const W25QxxAsyncRequest_t end = {W25QXX_ASYNC_READ, 64U * 1024U - sizeof(buf), sizeof(buf), buf, NULL, NULL};
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &end));
+    flash.RunUntilIdle();
+}
+
+TEST_CASE("Async: read served by suspending erase")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+    flash.eraseBusy = 100;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, 0U, NULL));
+
+    int erased = 0;
+    int read = 0;
+    uint8_t buf[32];
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x10000U, 0x10000U, NULL, CountDone, &erased};
+    const W25QxxAsyncRequest_t readOther = {W25QXX_ASYNC_READ, 0x100U, sizeof(buf), buf, CountDone, &read};
+    const W25QxxAsyncRequest_t readErased = {W25QXX_ASYNC_READ, 0x10100U, sizeof(buf), buf, CountDone, &read};
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    for (int i = 0; i < 10; i++)
+    {
+        flash.Step();
+    }
+
+    // Independent read completes within a few transfers
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &readOther));
+    for (int i = 0; (i < 5) && (read == 0); i++)
+    {
+        flash.Step();
+    }
+    REQUIRE(read == 1);
+    REQUIRE(erased == 0);
+    REQUIRE(flash.suspendCommands == 1U);
+
+    // Read of the erased block waits for the erase
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &readErased));
+    flash.RunUntilIdle();
+    REQUIRE(erased == 1);
+    REQUIRE(read == 2);
+    REQUIRE(flash.suspendCommands == 1U);
+    REQUIRE(buf[0] == 0xFFU);
+}
+
+TEST_CASE("Async: transfer error while suspended resumes the device")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+    flash.eraseBusy = 100;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, 0U, NULL));
+
+    int erased = 0;
+    int read = 0;
+    int programmed = 0;
+    uint8_t buf[4];
+    const uint8_t data[] = {0x12, 0x34, 0x56, 0x78};
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x10000U, 0x10000U, NULL, CountDone, &erased};
+    const W25QxxAsyncRequest_t readOther = {W25QXX_ASYNC_READ, 0x100U, sizeof(buf), buf, CountDone, &read};
+    const W25QxxAsyncRequest_t program = {W25QXX_ASYNC_PROGRAM, 0x200U, sizeof(data), (uint8_t*)data, CountDone, &programmed};
+
+    // Suspend, suspend poll, suspended read and resume
+    const int command = GENERATE(0x75, 0x05, 0x03, 0x7A);
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    for (int i = 0; i < 10; i++)
+    {
+        flash.Step();
+    }
+
+    flash.failCommand = command;
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &readOther));
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &program));
+    flash.RunUntilIdle();
+
+    REQUIRE(flash.failCommand == -1);
+    REQUIRE(erased <= 1);
+    REQUIRE(programmed == 1);
+    REQUIRE(flash.ignoredCommands == 0U);
+    REQUIRE(memcmp(&flash.memory[0x200U], data, sizeof(data)) == 0);
+    REQUIRE(flash.memory[0x10000U] == 0xFFU);
+}
+
+TEST_CASE("Async: transfer error while busy waits for the device")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, 0U, NULL));
+
+    int erased = 0;
+    int programmed = 0;
+    const uint8_t data[] = {0x12, 0x34, 0x56, 0x78};
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x10000U, 0x10000U, NULL, CountDone, &erased};
+    const W25QxxAsyncRequest_t program = {W25QXX_ASYNC_PROGRAM, 0x200U, sizeof(data), (uint8_t*)data, CountDone, &programmed};
+
+    // Status poll or the erase command itself fails while the erase runs
+    const int command = GENERATE(0x05, 0xD8);
+    flash.eraseBusy = 100;
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    for (int i = 0; i < 6; i++)
+    {
+        flash.Step();
+    }
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &program));
+    flash.failCommand = command;
+    flash.RunUntilIdle();
+
+    REQUIRE(erased <= 1);
+    REQUIRE(programmed == 1);
+    REQUIRE(flash.ignoredCommands == 0U);
+    REQUIRE(memcmp(&flash.memory[0x200U], data, sizeof(data)) == 0);
+}
+
+TEST_CASE("Async: suspend limit")
+{
+    FakeFlash flash(256U * 1024U);
+    W25QxxAsync_t handle;
+    W25QxxAsyncRequest_t queue[4];
+    flash.handle = &handle;
+    flash.eraseBusy = 1000;
+
+    const W25QxxAsyncPort_t port = flash.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&handle, &port, queue, 4U, 0U, NULL));
+    W25Qxx_ASYNC_SetSuspendLimit(&handle, 2U);
+
+    int erased = 0;
+    int read = 0;
+    uint8_t buf[4];
+    const W25QxxAsyncRequest_t erase = {W25QXX_ASYNC_ERASE, 0x10000U, 0x10000U, NULL, CountDone, &erased};
+    const W25QxxAsyncRequest_t readOther = {W25QXX_ASYNC_READ, 0x0U, sizeof(buf), buf, CountDone, &read};
+
+    REQUIRE(W25Qxx_ASYNC_Submit(&handle, &erase));
+    for (int i = 0; i < 3; i++)
+    {
+        REQUIRE(W25Qxx_ASYNC_Submit(&handle, &readOther));
+        for (int j = 0; j < 10; j++)
+        {
+            flash.Step();
+        }
+    }
+
+    REQUIRE(read == 2);
+    REQUIRE(flash.suspendCommands == 2U);
+
+    flash.RunUntilIdle();
+    REQUIRE(erased == 1);
+    REQUIRE(read == 3);
+}
+
+TEST_CASE("Async: two instances through adapters")
+{
+    FakeFlash flashA(64U * 1024U);
+    FakeFlash flashB(64U * 1024U);
+    W25QxxAsyncRequest_t queueA[2];
+    W25QxxAsyncRequest_t queueB[2];
+    flashA.handle = &f_flashA;
+    flashB.handle = &f_flashB;
+
+    const W25QxxAsyncPort_t portA = flashA.Port();
+    const W25QxxAsyncPort_t portB = flashB.Port();
+    REQUIRE(W25Qxx_ASYNC_Init(&f_flashA, &portA, queueA, 2U, 0U, NULL));
+    REQUIRE(W25Qxx_ASYNC_Init(&f_flashB, &portB, queueB, 2U, 0U, NULL));
+
+    const ReadMemory_t readA = FlashA_ReadFlash;
+    const WriteMemory_t writeB = FlashB_WriteFlash;
+    const EraseSectors_t eraseA = FlashA_EraseFlash;
+
+    const uint8_t data[] = {0x12, 0x34};
+    uint8_t out[sizeof(data)];
+
+    REQUIRE(writeB(0x100U, sizeof(data), data));
+    REQUIRE(flashB.memory[0x100U] == 0x12U);
+    REQUIRE(flashA.memory[0x100U] == 0xFFU);
+
+    REQUIRE(readA(0x100U, sizeof(out), out));
+    REQUIRE(out[0] == 0xFFU);
+    REQUIRE(FlashB_ReadFlash(0x100U, sizeof(out), out));
+    REQUIRE(out[1] == 0x34U);
+
+    REQUIRE(eraseA(0U, 0x1000U));
+    REQUIRE(flashA.eraseCommands == 1U);
+    REQUIRE(flashB.eraseCommands == 0U);
+}
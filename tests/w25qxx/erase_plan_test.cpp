@@ -0,0 +1,154 @@
+// MIT License
+// 
+// Copyright (c) 2026 Mikael Penttinen
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+//
+// erase_plan_test.cpp
+//
+// Unit tests for the W25Qxx erase planner
+//
+
+// -----------------------------------------------------------------------------
+// INCLUDE DIRECTIVES
+// -----------------------------------------------------------------------------
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch_all.hpp>
+
+#include "w25qxx/erase_plan.h"
+
+// -----------------------------------------------------------------------------
+// MACRO DEFINITIONS
+// -----------------------------------------------------------------------------
+
+#define KB      (1024U)
+#define MB      (1024U * KB)
+
+// -----------------------------------------------------------------------------
+// TEST CASES
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Erase plan: invalid ranges")
+{
+    W25QxxErasePlan_t plan;
+
+    REQUIRE_FALSE(W25Qxx_ERASE_Plan(0U, 0U, 0U, NULL, &plan));
+    REQUIRE_FALSE(W25Qxx_ERASE_Plan(1U, 4U * KB, 0U, NULL, &plan));
+    REQUIRE_FALSE(W25Qxx_ERASE_Plan(0U, 4U * KB + 1U, 0U, NULL, &plan));
+    REQUIRE_FALSE(W25Qxx_ERASE_Plan(0U, 4U * KB, 0U, NULL, NULL));
+}
+
+TEST_CASE("Erase plan: exact fit blocks")
+{
+    W25QxxErasePlan_t plan;
+
+    REQUIRE(W25Qxx_ERASE_Plan(64U * KB, 64U * KB, 0U, NULL, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 1U);
+    REQUIRE(plan.count[W25QXX_ERASE_32K] == 0U);
+    REQUIRE(plan.count[W25QXX_ERASE_4K] == 0U);
+    REQUIRE(plan.totalUs == W25QXX_ERASE_TIMES_TYPICAL.timeUs[W25QXX_ERASE_64K]);
+
+    REQUIRE(W25Qxx_ERASE_Plan(32U * KB, 32U * KB, 0U, NULL, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_32K] == 1U);
+    REQUIRE(plan.count[W25QXX_ERASE_4K] == 0U);
+}
+
+TEST_CASE("Erase plan: unaligned range")
+{
+    W25QxxErasePlan_t plan;
+
+    // 4 KB .. 132 KB: 7 x 4 KB, 32 KB, 64 KB, 4 KB
+    REQUIRE(W25Qxx_ERASE_Plan(4U * KB, 128U * KB, 0U, NULL, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_4K] == 8U);
+    REQUIRE(plan.count[W25QXX_ERASE_32K] == 1U);
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 1U);
+    REQUIRE(plan.totalUs == 8U * 45000U + 120000U + 150000U);
+}
+
+TEST_CASE("Erase plan: slow large blocks are split")
+{
+    W25QxxEraseTimes_t times = W25QXX_ERASE_TIMES_TYPICAL;
+    W25QxxErasePlan_t plan;
+
+    times.timeUs[W25QXX_ERASE_64K] = 300000U;
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 64U * KB, 0U, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 0U);
+    REQUIRE(plan.count[W25QXX_ERASE_32K] == 2U);
+    REQUIRE(plan.totalUs == 240000U);
+
+    times.timeUs[W25QXX_ERASE_64K] = 800000U;
+    times.timeUs[W25QXX_ERASE_32K] = 400000U;
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 64U * KB, 0U, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_4K] == 16U);
+    REQUIRE(plan.totalUs == 16U * 45000U);
+}
+
+TEST_CASE("Erase plan: chip erase for whole device")
+{
+    W25QxxEraseTimes_t times = W25QXX_ERASE_TIMES_TYPICAL;
+    W25QxxErasePlan_t plan;
+
+    // Typical W25Q128JV chip erase is slower than 256 block erases
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 16U * MB, 16U * MB, NULL, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_CHIP] == 0U);
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 256U);
+
+    times.timeUs[W25QXX_ERASE_CHIP] = 20000000U;
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 16U * MB, 16U * MB, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_CHIP] == 1U);
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 0U);
+    REQUIRE(plan.totalUs == 20000000U);
+
+    // Unknown device size or partial range
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 16U * MB, 0U, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_CHIP] == 0U);
+    REQUIRE(W25Qxx_ERASE_Plan(64U * KB, 16U * MB - 64U * KB, 16U * MB, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_CHIP] == 0U);
+
+    // Small device where blocks are faster
+    REQUIRE(W25Qxx_ERASE_Plan(0U, 128U * KB, 128U * KB, &times, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_CHIP] == 0U);
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 2U);
+}
+
+TEST_CASE("Erase plan: range ending at 4 GB")
+{
+    W25QxxErasePlan_t plan;
+
+    REQUIRE(W25Qxx_ERASE_Plan(0xFFFF0000U, 64U * KB, 0U, NULL, &plan));
+    REQUIRE(plan.count[W25QXX_ERASE_64K] == 1U);
+    REQUIRE_FALSE(W25Qxx_ERASE_Plan(0xFFFF0000U, 128U * KB, 0U, NULL, &plan));
+
+    if (sizeof(size_t) > sizeof(uint32_t))
+    {
+        // Whole 32-bit range, offset must not wrap
+        const size_t size = (size_t)UINT32_MAX + 1U;
+        REQUIRE(W25Qxx_ERASE_Plan(0U, size, 0U, NULL, &plan));
+        REQUIRE(plan.count[W25QXX_ERASE_64K] == (size / (64U * KB)));
+        REQUIRE(plan.count[W25QXX_ERASE_32K] == 0U);
+        REQUIRE(plan.count[W25QXX_ERASE_4K] == 0U);
+
+        REQUIRE_FALSE(W25Qxx_ERASE_Plan(4U * KB, size, 0U, NULL, &plan));
+    }
+}
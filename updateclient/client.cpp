@@ -32,7 +32,9 @@
 /*----------------------------------------------------------------------------*/
 
 #include "client.hpp"
+#include "fragmentstore/wire.h"
 #include "updateserver/protocol.h"
+#include <cstring>
 #include <iostream>
 
 /*----------------------------------------------------------------------------*/
@@ -214,16 +216,41 @@ bool UpdateClient::PutMetadata(const Metadata_t& metadata)
 
 bool UpdateClient::PutFragment(const Fragment_t& fragment)
 {
-    std::vector<uint8_t> req = {PROTOCOL_SID_PUT_FRAGMENT};
+    std::vector<uint8_t> req(1U + sizeof(fragment));
+    req[0] = PROTOCOL_SID_PUT_FRAGMENT;
 
-    const uint8_t* pFrag = (const uint8_t*)(&fragment);
-    for (size_t i = 0; i < sizeof(fragment); i++)
+    /* Only the used content is sent, the server restores the padding */
+    const size_t len = WIRE_EncodeFragment(&fragment, &req[1], sizeof(fragment));
+    if (len == 0U)
     {
-        req.push_back(pFrag[i]);
+        std::cerr << "Invalid fragment size " << fragment.size << std::endl;
+        return false;
     }
 
+    if (!m_fullFragments)
+    {
+        const auto res = _Request(std::vector<uint8_t>(req.begin(), req.begin() + 1U + len));
+
+        if (IsPositiveProtocolResponse(res, PROTOCOL_SID_PUT_FRAGMENT))
+        {
+            return true;
+        }
+
+        /* Servers before the compact form reject any other size as out of range */
+        if ((len == sizeof(fragment)) ||
+            (res.size() < 2U) ||
+            (res.at(1) != PROTOCOL_NACK_REQUEST_OUT_OF_RANGE))
+        {
+            std::cerr << "Negative put fragment id response" << std::endl;
+            return false;
+        }
+    }
+
+    memcpy(&req[1], &fragment, sizeof(fragment));
+
     if (IsPositiveProtocolResponse(_Request(req), PROTOCOL_SID_PUT_FRAGMENT))
     {
+        m_fullFragments = true;
         return true;
     }
 
@@ -63,6 +63,7 @@ private:
     std::vector<uint8_t> _Request(const std::vector<uint8_t>& req);
 
     UdpSocket& m_sock;
+    bool m_fullFragments = false;   // Server accepts only sizeof(Fragment_t)
 };
 
 /* EoF client.hpp */
@@ -31,16 +31,17 @@
 /* INCLUDE DIRECTIVES                                                         */
 /*----------------------------------------------------------------------------*/
 
-#include "crc32.hpp"
-
 extern "C" {
+    #include "crc/crc32.h"
     #include "ed25519_extra.h"
+    #include "ed25519_keyring.h"
     #include "ed25519.h"
     #include "sha512.h"
 }
 
 #include "keyfile/openSSH_key.hpp"
 #include "fragmentstore/fragmentstore.h" // Default types
+#include "fragmentstore/wire.h"
 #include "udpsocket.hpp"
 #include "updateserver/server.h"
 #include "updateserver/protocol.h"
@@ -64,6 +65,8 @@ typedef struct
     Metadata_t recvMetadata;
     std::map<uint32_t, Fragment_t> recvFragments;
     KeyPair keys;
+    ed25519_keyring_entry_t keyringEntry;
+    ed25519_keyring_t keyring;
 } TestServer_t;
 
 /*----------------------------------------------------------------------------*/
@@ -87,6 +90,9 @@ return -1; \
 
 static TestServer_t f_self;
 
+/* Requests are reassembled here, fragments are decoded in place */
+static uint8_t f_transferBuffer[5 * 1024];
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /*----------------------------------------------------------------------------*/
@@ -109,7 +115,7 @@ static bool VerifyMetadata(const Metadata_t* meta)
 {
     const uint8_t* msg = (const uint8_t*)(meta);
     const size_t msgLen = sizeof(Metadata_t)-sizeof(meta->metadataSignature);
-    return 1 == ed25519_verify(meta->metadataSignature, msg, msgLen, f_self.keys.GetPublicKey().data());
+    return 1 == ed25519_keyring_verify(&f_self.keyring, meta->keyId, meta->metadataSignature, msg, msgLen);
 }
 
 static bool VerifyFragment(const Fragment_t* frag)
@@ -120,7 +126,7 @@ static bool VerifyFragment(const Fragment_t* frag)
     if (0U == frag->verifyMethod)
     {
         printf("Verifying fragment with ed25519\r\n");
-        return 1 == ed25519_verify(frag->signature, msg, msgLen, f_self.keys.GetPublicKey().data());
+        return 1 == ed25519_verify_precomputed(frag->signature, msg, msgLen, &f_self.keyringEntry.key);
     }
     else if (1U == frag->verifyMethod)
     {
@@ -165,8 +171,16 @@ static bool TryInstallFirmware(const Metadata_t* meta)
         return false;
     }
 
+    const ed25519_precomputed_key_t* key = ed25519_keyring_find(&f_self.keyring, meta->keyId);
+
+    if (key == NULL)
+    {
+        printf("Unknown signing key ID %08X\r\n", meta->keyId);
+        return false;
+    }
+
     ed25519_multipart_t ctx;
-    int ed = ed25519_multipart_init(&ctx, f_self.recvMetadata.firmwareSignature, f_self.keys.GetPublicKey().data());
+    int ed = ed25519_multipart_init_precomputed(&ctx, f_self.recvMetadata.firmwareSignature, key);
 
     if (ed != 1)
     {
@@ -239,6 +253,17 @@ static void SignalHandler( int signum )
    exit(2);
 }
 
+/* Truncated SHA-512 of a request for the response cache */
+static void RequestDigest(
+    const uint8_t* data, 
+    size_t size, 
+    uint8_t* digest)
+{
+    uint8_t hash[64];
+    sha512(data, size, hash);
+    memcpy(digest, hash, US_REQUEST_DIGEST_SIZE);
+}
+
 static uint8_t TEST_ReadDataById(
     uint8_t id, 
     uint8_t* out, 
@@ -308,12 +333,13 @@ static uint8_t TEST_WriteDataById(
 }
 
 static uint8_t TEST_PutMetadata(
-    const uint8_t* data, 
-    size_t size)
+    uint8_t* data, 
+    size_t size,
+    size_t)
 {
     std::stringstream ss;
     ss << std::hex;
-    ss << "Received metadata " << InlineCrc32(data, size);
+    ss << "Received metadata " << CRC32_Calculate(data, size);
     std::cout << ss.str() << std::endl;
 
     if (size == sizeof(Metadata_t))
@@ -341,17 +367,21 @@ static uint8_t TEST_PutMetadata(
 }
 
 static uint8_t TEST_PutFragment(
-    const uint8_t* data, 
-    size_t size)
+    uint8_t* data, 
+    size_t size,
+    size_t capacity)
 {
-    std::stringstream ss;
-    ss << std::hex;
-    ss << "Received fragment " << InlineCrc32(data, size);
-    std::cout << ss.str() << std::endl;
+    /* data is the aligned transfer payload, decoded where it was received */
+    const Fragment_t* frag = WIRE_DecodeFragmentInPlace(data, size, capacity);
 
-    if (size == sizeof(Fragment_t))
+    if (frag != nullptr)
     {
-        const Fragment_t* frag = (const Fragment_t*)data;
+        std::stringstream ss;
+        ss << std::hex;
+        ss << "Received fragment " << CRC32_Calculate((const uint8_t*)frag, sizeof(Fragment_t));
+        ss << std::dec << " (" << size << " bytes)";
+        std::cout << ss.str() << std::endl;
+
         if (VerifyFragment(frag))
         {
             f_self.recvFragments[frag->number] = *frag;
@@ -387,18 +417,28 @@ int main(int argc, const char* argv[])
         std::cout << "Loaded keys from " << argv[1] << std::endl;
         PrintBytes(f_self.keys.GetPrivateKey().data(), f_self.keys.GetPrivateKey().size(), "Private key: ");
         PrintBytes(f_self.keys.GetPublicKey().data(), f_self.keys.GetPublicKey().size(), "Public key: ");
+
+        // Single key keyring, fragments are verified with the same key
+        REQUIRE(1 == ed25519_precompute_key(&f_self.keyringEntry.key, f_self.keys.GetPublicKey().data()));
+        f_self.keyringEntry.key_id = f_self.keys.GetKeyId();
+        f_self.keyringEntry.in_use = 1U;
+        f_self.keyring.entries = &f_self.keyringEntry;
+        f_self.keyring.size = 1U;
     }
 
     static UdpSocket udp(8U);
 
     uint8_t packet[1472U];
-    uint8_t transferBuffer[5 * 1024];
 
     UpdateServer_t us;
     REQUIRE(US_InitServer(&us, TEST_ReadDataById, TEST_WriteDataById, TEST_PutMetadata, TEST_PutFragment));
 
+    ResponseCache_t cache;
+    ResponseCacheEntry_t cacheEntries[8U];
+    REQUIRE(US_SetResponseCache(&us, &cache, cacheEntries, 8U, RequestDigest));
+
     TransferBuffer_t tb;
-    REQUIRE(TRANSFER_Init(&tb, &us, transferBuffer, sizeof(transferBuffer)));
+    REQUIRE(TRANSFER_InitAligned(&tb, &us, f_transferBuffer, sizeof(f_transferBuffer), 8U));
 
     std::cout << "Listening on port 8" << std::endl;
 
@@ -35,7 +35,6 @@
 #include "udpsocket.hpp"
 
 #include "argparse/argparse.hpp"
-#include "crc32.hpp"
 #include "fragmentstore/fragmentstore.h"
 #include "hexfile.hpp"
 #include "updateserver/protocol.h"
@@ -43,6 +42,7 @@
 
 extern "C"
 {
+    #include "crc/crc32.h"
     #include "sha512.h"
     #include "ed25519.h"
 }
@@ -116,14 +116,8 @@ static bool VerifyKeys(const KeyPair& keyPair)
     const char msg[] = "Test message to verify asymmetric keys";
     uint8_t signature[64];
 
-    const auto seed = keyPair.GetPrivateKey();
-    const auto pubFile = keyPair.GetPublicKey();
-
-    // Verify key sizes
-    if ((seed.size() < 32) || (pubFile.size() != 32))
-    {
-        return false;
-    }
+    const auto& seed = keyPair.GetPrivateKey();
+    const auto& pubFile = keyPair.GetPublicKey();
 
     // Generate signing keys from the keyPair
     uint8_t pubGen[32];
@@ -313,7 +307,7 @@ static int ClientExecuteUpdate(UpdateClient& client, std::string& argStr, std::s
 
     if (client.PutMetadata(sec.metadata))
     {
-        std::cout << "Successfully uploaded metadata: " << std::hex << InlineCrc32((const uint8_t*)&sec.metadata, sizeof(sec.metadata)) << std::endl;
+        std::cout << "Successfully uploaded metadata: " << std::hex << CRC32_Calculate((const uint8_t*)&sec.metadata, sizeof(sec.metadata)) << std::endl;
     }
     else
     {
@@ -325,7 +319,7 @@ static int ClientExecuteUpdate(UpdateClient& client, std::string& argStr, std::s
     {
         if (client.PutFragment(frag))
         {
-            std::cout << "Successfully uploaded fragment at " << frag.startAddress << ": " << std::hex << InlineCrc32((const uint8_t*)&frag, sizeof(frag)) << std::endl;
+            std::cout << "Successfully uploaded fragment at " << frag.startAddress << ": " << std::hex << CRC32_Calculate((const uint8_t*)&frag, sizeof(frag)) << std::endl;
         }
         else
         {
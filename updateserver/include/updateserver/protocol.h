@@ -43,6 +43,14 @@ extern "C" {
 #define TRANSFER_MULTI_PACKET_TRANSFER  (0x02)
 #define TRANSFER_MULTI_PACKET_END       (0x03)
 
+#define SMALLFRAME_TYPE_MASK            (0xC0U)
+#define SMALLFRAME_SEQUENCE_MASK        (0x3FU)
+#define SMALLFRAME_LENGTH_MASK          (0x3FU)
+#define SMALLFRAME_SINGLE               (0x00U)
+#define SMALLFRAME_FIRST                (0x40U)
+#define SMALLFRAME_CONSECUTIVE          (0x80U)
+#define SMALLFRAME_FLOW_CONTROL         (0xC0U)
+
 #define PROTOCOL_SID_PING               (0x01U)
 #define PROTOCOL_SID_READ_DATA_BY_ID    (0x02U)
 #define PROTOCOL_SID_WRITE_DATA_BY_ID   (0x03U)
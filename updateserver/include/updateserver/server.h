@@ -42,6 +42,15 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+/* Bytes of request digest stored per response cache entry */
+#ifndef US_REQUEST_DIGEST_SIZE
+#define US_REQUEST_DIGEST_SIZE      (32U)
+#endif
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC TYPE DEFINITIONS                                                    */
 /*----------------------------------------------------------------------------*/
@@ -78,34 +87,82 @@ typedef uint8_t (*WriteDataById_t)(
 
 /** Put new metadata
  * 
- * @param data Data buffer
+ * The data may be decoded in place, e.g. with WIRE_DecodeFragmentInPlace.
+ * 
+ * @param data Data buffer, request payload after the SID
  * @param size Data size
+ * @param capacity Writable bytes from data onwards, at least size
  * 
  * @return Result code
  */
 typedef uint8_t (*PutMetadata_t)(
-    const uint8_t* data, 
-    size_t size
+    uint8_t* data, 
+    size_t size,
+    size_t capacity
 );
 
 /** Put new fragment
  * 
- * @param data Data buffer
+ * The data may be decoded in place, e.g. with WIRE_DecodeFragmentInPlace.
+ * 
+ * @param data Data buffer, request payload after the SID
  * @param size Data size
+ * @param capacity Writable bytes from data onwards, at least size
  * 
  * @return Result code
  */
 typedef uint8_t (*PutFragment_t)(
+    uint8_t* data, 
+    size_t size,
+    size_t capacity
+);
+
+/** Hash a request for the response cache
+ * 
+ * A request with the same digest and length as a cached one is taken as
+ * its retransmission and is not passed to the service, so the hash must
+ * be collision resistant, e.g. SHA-512 truncated to the digest size. A
+ * CRC is not enough.
+ * 
+ * @param data Request buffer
+ * @param size Request size
+ * @param digest US_REQUEST_DIGEST_SIZE bytes of request digest
+ */
+typedef void (*RequestHash_t)(
     const uint8_t* data, 
-    size_t size
+    size_t size,
+    uint8_t* digest
 );
 
+typedef struct
+{
+    uint8_t  digest[US_REQUEST_DIGEST_SIZE];  /* Digest of the whole request */
+    uint32_t length;                          /* Request length, 0 if empty */
+} ResponseCacheEntry_t;
+
+/** Cache of recently completed requests
+ * 
+ * Put metadata and put fragment requests which completed with
+ * PROTOCOL_ACK_OK are remembered here. An exact retransmission of one
+ * of the last entries is answered with PROTOCOL_ACK_OK again without
+ * calling the service, so a lost response does not cost another
+ * signature verification and flash program.
+ */
+typedef struct
+{
+    RequestHash_t           Hash;
+    ResponseCacheEntry_t*   entries;
+    size_t                  size;
+    size_t                  next;
+} ResponseCache_t;
+
 typedef struct 
 {
     ReadDataById_t  ReadDid;
     WriteDataById_t WriteDid;
     PutMetadata_t   PutMetadata;
     PutFragment_t   PutFragment;
+    ResponseCache_t* cache;
 } UpdateServer_t;
 
 /*----------------------------------------------------------------------------*/
@@ -129,10 +186,41 @@ extern bool US_InitServer(
     PutMetadata_t   putMetadata,
     PutFragment_t   putFragment);
 
+/** Attach a response cache to the server
+ * 
+ * Any write data by ID request clears the cache, as it may start a new
+ * update in which the same metadata and fragments are sent again. Accepted
+ * metadata clears it too, as fragments of the previous update no longer
+ * apply.
+ * 
+ * @param server Server instance
+ * @param cache Cache instance, NULL to disable caching
+ * @param entries Cache entry storage
+ * @param size Number of entries
+ * @param hash Request hash function
+ * 
+ * @return Cache attached
+ */
+extern bool US_SetResponseCache(
+    UpdateServer_t* server,
+    ResponseCache_t* cache,
+    ResponseCacheEntry_t* entries,
+    size_t size,
+    RequestHash_t hash);
+
+/** Forget all cached requests
+ * 
+ * @param server Server instance
+ */
+extern void US_ClearResponseCache(const UpdateServer_t* server);
+
 /** Process incoming update server request
+ * 
+ * The request buffer is passed on to the put handlers, which may modify it.
  * 
  * @param request Request buffer
  * @param requestLength Request length
+ * @param requestCapacity Size of the request buffer, at least requestLength
  * @param response Response buffer
  * @param maxResponseLength Maximum number of bytes to put to response buffer
  * 
@@ -140,8 +228,9 @@ extern bool US_InitServer(
  */
 extern size_t US_ProcessRequest(
     const UpdateServer_t* server,
-    const uint8_t* request,
+    uint8_t* request,
     size_t requestLength,
+    size_t requestCapacity,
     uint8_t* response,
     size_t maxResponseLength);
 
@@ -0,0 +1,134 @@
+/* MIT License
+ * 
+ * Copyright (c) 2025 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * smallframe.h
+ *
+ * @brief Transport layer for update server protocol on small frame links
+ * 
+ * Meant for CAN-FD and other links with a frame size of 8 to 64 bytes. Every
+ * frame starts with a single header byte, the two upper bits give the type:
+ * 
+ *  SMALLFRAME_SINGLE       Whole request or response: [0x00 | length][SID][data...]
+ *  SMALLFRAME_FIRST        Start of a longer request: [0x40][size u32 BE][data...]
+ *  SMALLFRAME_CONSECUTIVE  Continuation: [0x80 | sequence][data...]
+ *  SMALLFRAME_FLOW_CONTROL Server clear to send: [0xC0][block size]
+ * 
+ * The single frame length counts the bytes after the header, 1 to 63. Frames
+ * may be padded, e.g. to the CAN-FD data lengths of 12, 16, 20, 24, 32, 48
+ * and 64 bytes: bytes past the single frame length or past the end of the
+ * request in the first or last consecutive frame are ignored.
+ * 
+ * The first frame has sequence number 0 and consecutive frames count up from
+ * 1 modulo 64. The server answers a first frame with flow control and then
+ * stays silent until block size consecutive frames have arrived, when it sends
+ * flow control again. Block size 0 lets the client send the rest of the
+ * request without waiting. A completed request is answered with a single
+ * frame response. Transfer errors, e.g. a sequence gap, are answered with a
+ * single frame [0x02][0x00][code] and the request must be sent again;
+ * consecutive frames after an error are ignored.
+*/
+
+#ifndef UPDATESERVER_SMALLFRAME_H_
+#define UPDATESERVER_SMALLFRAME_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "updateserver/transfer.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+/* Classic CAN frame size */
+#define SMALLFRAME_MIN_FRAME_SIZE   (8U)
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    TransferBuffer_t    tb;
+    uint8_t             blockSize;      /* Consecutive frames per flow control */
+    uint8_t             sequence;       /* Next expected sequence number */
+    uint8_t             blockFrames;    /* Frames received in current block */
+} SmallFrameTransfer_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Initialize small frame transfer layer
+ * 
+ * @param sf Small frame transfer instance
+ * @param server Update server instance for the transfer
+ * @param buf Transfer buffer memory
+ * @param bufSize Size of buf* area, includes up to alignment - 1 bytes padding
+ * @param alignment Payload alignment, power of two
+ * @param blockSize Consecutive frames between flow control, 0 for none
+ * 
+ * @return Init successful
+ */
+extern bool SMALLFRAME_Init(
+    SmallFrameTransfer_t* sf,
+    const UpdateServer_t* server,
+    uint8_t* buf,
+    size_t bufSize,
+    size_t alignment,
+    uint8_t blockSize);
+
+/** Process incoming frame
+ * 
+ * @param sf Small frame transfer instance
+ * @param frame Frame buffer
+ * @param frameSize Size of actual frame in frame* area
+ * @param maxFrameSize Maximum size of frame* area for response encoding
+ * 
+ * @return Num bytes encoded in frame* as a response, 0 if nothing to send
+ * 
+ * @note Responses are always single frame, longer ones are truncated to the
+ *       frame size and at most 63 bytes after the header
+ */
+extern size_t SMALLFRAME_Process(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t frameSize,
+    size_t maxFrameSize);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF smallframe.h */
+
+#endif /* UPDATESERVER_SMALLFRAME_H_ */
@@ -24,7 +24,14 @@
  *
  * transfer.h
  *
- * @brief {Short description of the source file}
+ * @brief Simple multi packet transport layer for update server protocol
+ * 
+ * Requests are reassembled into the transfer buffer with the SID in the byte
+ * before the service payload. TRANSFER_InitAligned places that payload at a
+ * given alignment, so handlers can use Metadata_t or Fragment_t data in place
+ * without copying it out first. A fragment in the compact wire form is
+ * expanded in place with WIRE_DecodeFragmentInPlace when the buffer has room
+ * for the full Fragment_t after the payload start.
 */
 
 #ifndef UPDATESERVER_TRANSFER_H_
@@ -56,8 +63,8 @@ typedef enum
 
 typedef struct
 {
-    uint8_t*                buf;
-    size_t                  bufSize;
+    uint8_t*                buf;        /* Request start, SID followed by payload */
+    size_t                  bufSize;    /* Space from buf onwards */
     size_t                  msgSize;
     size_t                  transferSize;
     TransferState_t         state;
@@ -83,6 +90,26 @@ extern bool TRANSFER_Init(
     uint8_t* buf, 
     size_t bufSize);
 
+/** Initialize Transfer layer with aligned service payload
+ * 
+ * Leading bytes of buf are skipped so that the payload after the SID starts
+ * at a multiple of alignment.
+ * 
+ * @param tb Transfer buffer instance
+ * @param server Update server instance for the transfer buffer
+ * @param buf Transfer buffer memory
+ * @param bufSize Size of buf* area, includes up to alignment - 1 bytes padding
+ * @param alignment Payload alignment, power of two
+ * 
+ * @return Init successful
+ */
+extern bool TRANSFER_InitAligned(
+    TransferBuffer_t* tb, 
+    const UpdateServer_t* server, 
+    uint8_t* buf, 
+    size_t bufSize,
+    size_t alignment);
+
 /** Process incoming packet
  * 
  * @param tb Transfer buffer instance
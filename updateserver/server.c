@@ -34,6 +34,8 @@
 #include "updateserver/server.h"
 #include "updateserver/protocol.h"
 
+#include <string.h>
+
 /*----------------------------------------------------------------------------*/
 /* PRIVATE TYPE DEFINITIONS                                                   */
 /*----------------------------------------------------------------------------*/
@@ -41,8 +43,9 @@
 typedef struct
 {
     const uint8_t sid;
-    const uint8_t* req;
+    uint8_t* req;
     const size_t reqLen;
+    const size_t reqCapacity;
     uint8_t* res;
     const size_t maxResLen;
 } ServiceArg_t;
@@ -71,6 +74,44 @@ static size_t BasicResponse(uint8_t sid, uint8_t code, uint8_t* buf)
     return MINIMUM_RESPONSE_LENGTH;
 }
 
+static bool IsCacheable(uint8_t sid)
+{
+    return (sid == PROTOCOL_SID_PUT_METADATA) ||
+           (sid == PROTOCOL_SID_PUT_FRAGMENT);
+}
+
+static bool CacheLookup(
+    const ResponseCache_t* cache, 
+    const uint8_t* digest, 
+    size_t length)
+{
+    for (size_t i = 0U; i < cache->size; ++i)
+    {
+        const ResponseCacheEntry_t* entry = &cache->entries[i];
+
+        if ((entry->length == length) && 
+            (memcmp(entry->digest, digest, US_REQUEST_DIGEST_SIZE) == 0))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void CacheInsert(
+    ResponseCache_t* cache, 
+    const uint8_t* digest, 
+    size_t length)
+{
+    ResponseCacheEntry_t* entry = &cache->entries[cache->next];
+
+    memcpy(entry->digest, digest, US_REQUEST_DIGEST_SIZE);
+    entry->length = (uint32_t)length;
+
+    cache->next = (cache->next + 1U) % cache->size;
+}
+
 static size_t HandlePing(
     const UpdateServer_t* server,
     const ServiceArg_t* arg)
@@ -152,10 +193,10 @@ static size_t HandlePutMetadata(
         return BasicResponse(arg->sid, code, arg->res);
     }
 
-    const uint8_t*  data    = &arg->req[1];
+    uint8_t*        data    = &arg->req[1];
     const size_t    len     = arg->reqLen - 1U;
 
-    const uint8_t result = server->PutMetadata(data, len);
+    const uint8_t result = server->PutMetadata(data, len, arg->reqCapacity - 1U);
 
     return BasicResponse(arg->sid, result, arg->res);
 }
@@ -171,10 +212,10 @@ static size_t HandlePutFragment(
         return BasicResponse(arg->sid, code, arg->res);
     }
 
-    const uint8_t*  data    = &arg->req[1];
+    uint8_t*        data    = &arg->req[1];
     const size_t    len     = arg->reqLen - 1U;
 
-    const uint8_t result = server->PutFragment(data, len);
+    const uint8_t result = server->PutFragment(data, len, arg->reqCapacity - 1U);
 
     return BasicResponse(arg->sid, result, arg->res);
 }
@@ -203,14 +244,65 @@ bool US_InitServer(
     server->WriteDid = writeDid;
     server->PutMetadata = putMetadata;
     server->PutFragment = putFragment;
+    server->cache = NULL;
 
     return true;
 }
 
+bool US_SetResponseCache(
+    UpdateServer_t* server,
+    ResponseCache_t* cache,
+    ResponseCacheEntry_t* entries,
+    size_t size,
+    RequestHash_t hash)
+{
+    if (IS_NULL(server))
+    {
+        return false;
+    }
+
+    if (IS_NULL(cache))
+    {
+        server->cache = NULL;
+        return true;
+    }
+
+    if (IS_NULL(entries) ||
+        IS_NULL(hash) ||
+        (size == 0U))
+    {
+        return false;
+    }
+
+    cache->Hash = hash;
+    cache->entries = entries;
+    cache->size = size;
+    cache->next = 0U;
+
+    server->cache = cache;
+    US_ClearResponseCache(server);
+
+    return true;
+}
+
+void US_ClearResponseCache(const UpdateServer_t* server)
+{
+    if (IS_NULL(server) || IS_NULL(server->cache))
+    {
+        return;
+    }
+
+    ResponseCache_t* cache = server->cache;
+
+    memset(cache->entries, 0, cache->size * sizeof(ResponseCacheEntry_t));
+    cache->next = 0U;
+}
+
 size_t US_ProcessRequest(
     const UpdateServer_t* server,
-    const uint8_t* request,
+    uint8_t* request,
     size_t requestLength,
+    size_t requestCapacity,
     uint8_t* response,
     size_t maxResponseLength)
 {
@@ -218,6 +310,7 @@ size_t US_ProcessRequest(
         IS_NULL(request) ||
         IS_NULL(response) ||
         (requestLength == 0U) ||
+        (requestCapacity < requestLength) ||
         (maxResponseLength < MINIMUM_RESPONSE_LENGTH))
     {
         return 0U;
@@ -227,10 +320,26 @@ size_t US_ProcessRequest(
         .sid = request[0U],
         .req = request,
         .reqLen = requestLength,
+        .reqCapacity = requestCapacity,
         .res = response,
         .maxResLen = maxResponseLength
     };
 
+    ResponseCache_t* cache = server->cache;
+    const bool cacheable = !IS_NULL(cache) && IsCacheable(arg.sid);
+    uint8_t digest[US_REQUEST_DIGEST_SIZE];
+
+    if (cacheable)
+    {
+        cache->Hash(request, requestLength, digest);
+
+        if (CacheLookup(cache, digest, requestLength))
+        {
+            /* Retransmission of a completed request */
+            return BasicResponse(arg.sid, PROTOCOL_ACK_OK, arg.res);
+        }
+    }
+
     size_t responseLength = 0U;
 
     switch (arg.sid)
@@ -243,9 +352,15 @@ size_t US_ProcessRequest(
         break;
     case PROTOCOL_SID_WRITE_DATA_BY_ID:
         responseLength = HandleWriteDataById(server, &arg);
+        US_ClearResponseCache(server);
         break;
     case PROTOCOL_SID_PUT_METADATA:
         responseLength = HandlePutMetadata(server, &arg);
+        if (arg.res[1U] == PROTOCOL_ACK_OK)
+        {
+            /* New update, earlier fragments must be written again */
+            US_ClearResponseCache(server);
+        }
         break;
     case PROTOCOL_SID_PUT_FRAGMENT:
         responseLength = HandlePutFragment(server, &arg);
@@ -258,6 +373,11 @@ size_t US_ProcessRequest(
         break;
     }
 
+    if (cacheable && (arg.res[1U] == PROTOCOL_ACK_OK))
+    {
+        CacheInsert(cache, digest, requestLength);
+    }
+
     return responseLength;
 }
 
@@ -0,0 +1,264 @@
+/* MIT License
+ * 
+ * Copyright (c) 2025 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * smallframe.c
+ *
+ * @brief Transport layer for update server protocol on small frame links
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "updateserver/smallframe.h"
+#include <stdint.h>
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) (ptr == NULL)
+
+#define FIRST_FRAME_HEADER_SIZE (5U)
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static inline size_t MinSz(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static inline size_t ErrorResponse(
+    SmallFrameTransfer_t* sf, 
+    uint8_t* frame, 
+    uint8_t code)
+{
+    sf->tb.state = TRANSFER_IDLE;
+
+    frame[0] = SMALLFRAME_SINGLE | 2U;  // transfer layer
+    frame[1] = 0U;                  // SID
+    frame[2] = code;                // arg
+    return 3U;
+}
+
+static inline size_t FlowControl(SmallFrameTransfer_t* sf, uint8_t* frame)
+{
+    sf->blockFrames = 0U;
+
+    frame[0] = SMALLFRAME_FLOW_CONTROL;
+    frame[1] = sf->blockSize;
+    return 2U;
+}
+
+static inline uint32_t DecodeU32Be(const uint8_t* buf)
+{
+    uint32_t val = (uint32_t)(buf[0]) << 24U;
+    val += (uint32_t)(buf[1]) << 16U;
+    val += (uint32_t)(buf[2]) << 8U;
+    val += (uint32_t)(buf[3]);
+    return val;
+}
+
+static size_t Complete(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t maxFrameSize)
+{
+    sf->tb.state = TRANSFER_IDLE;
+
+    const size_t length = US_ProcessRequest(
+        sf->tb.server,
+        sf->tb.buf,
+        sf->tb.msgSize,
+        sf->tb.bufSize,
+        &frame[1],
+        MinSz(maxFrameSize - 1U, SMALLFRAME_LENGTH_MASK)
+    );
+
+    frame[0] = SMALLFRAME_SINGLE | (uint8_t)length;
+    return 1U + length;
+}
+
+static size_t HandleSingle(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t frameSize,
+    size_t maxFrameSize)
+{
+    // Frame may be padded past the length, e.g. to a CAN-FD DLC size
+    const size_t length = frame[0] & SMALLFRAME_LENGTH_MASK;
+
+    if ((length == 0U) || (length > (frameSize - 1U)))
+    {
+        return ErrorResponse(sf, frame, PROTOCOL_NACK_INVALID_REQUEST);
+    }
+
+    sf->tb.msgSize = length;
+    sf->tb.transferSize = 0U;
+
+    memcpy(sf->tb.buf, &frame[1], length);
+
+    return Complete(sf, frame, maxFrameSize);
+}
+
+static size_t HandleFirst(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t frameSize,
+    size_t maxFrameSize)
+{
+    if (frameSize < FIRST_FRAME_HEADER_SIZE)
+    {
+        return ErrorResponse(sf, frame, PROTOCOL_NACK_INVALID_REQUEST);
+    }
+
+    const uint32_t transferSize = DecodeU32Be(&frame[1]);
+
+    if ((transferSize == 0U) || 
+        (transferSize > sf->tb.bufSize))
+    {
+        return ErrorResponse(sf, frame, PROTOCOL_NACK_REQUEST_OUT_OF_RANGE);
+    }
+
+    // Bytes past the transfer size are padding
+    const size_t dataSize = MinSz(frameSize - FIRST_FRAME_HEADER_SIZE, transferSize);
+
+    memcpy(sf->tb.buf, &frame[FIRST_FRAME_HEADER_SIZE], dataSize);
+
+    sf->tb.state = TRANSFER_RX;
+    sf->tb.msgSize = dataSize;
+    sf->tb.transferSize = transferSize;
+    sf->sequence = 1U;
+
+    if (dataSize == transferSize)
+    {
+        return Complete(sf, frame, maxFrameSize);
+    }
+
+    return FlowControl(sf, frame);
+}
+
+static size_t HandleConsecutive(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t frameSize,
+    size_t maxFrameSize)
+{
+    // Not receiving, e.g. rest of a request that already failed
+    if (sf->tb.state != TRANSFER_RX)
+    {
+        return 0U;
+    }
+
+    if (frameSize < 2U)
+    {
+        return ErrorResponse(sf, frame, PROTOCOL_NACK_INVALID_REQUEST);
+    }
+
+    // Lost or repeated frame
+    if ((frame[0] & SMALLFRAME_SEQUENCE_MASK) != sf->sequence)
+    {
+        return ErrorResponse(sf, frame, PROTOCOL_NACK_REQUEST_FAILED);
+    }
+
+    // Last frame may be padded past the end of the transfer
+    const size_t dataSize = MinSz(frameSize - 1U, sf->tb.transferSize - sf->tb.msgSize);
+
+    memcpy(&sf->tb.buf[sf->tb.msgSize], &frame[1], dataSize);
+    sf->tb.msgSize += dataSize;
+    sf->sequence = (sf->sequence + 1U) & SMALLFRAME_SEQUENCE_MASK;
+    sf->blockFrames++;
+
+    if (sf->tb.msgSize == sf->tb.transferSize)
+    {
+        return Complete(sf, frame, maxFrameSize);
+    }
+
+    if ((sf->blockSize != 0U) && (sf->blockFrames == sf->blockSize))
+    {
+        return FlowControl(sf, frame);
+    }
+
+    return 0U;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool SMALLFRAME_Init(
+    SmallFrameTransfer_t* sf,
+    const UpdateServer_t* server,
+    uint8_t* buf,
+    size_t bufSize,
+    size_t alignment,
+    uint8_t blockSize)
+{
+    if (IS_NULL(sf) ||
+        !TRANSFER_InitAligned(&sf->tb, server, buf, bufSize, alignment))
+    {
+        return false;
+    }
+
+    sf->blockSize = blockSize;
+    sf->sequence = 0U;
+    sf->blockFrames = 0U;
+
+    return true;
+}
+
+size_t SMALLFRAME_Process(
+    SmallFrameTransfer_t* sf,
+    uint8_t* frame,
+    size_t frameSize,
+    size_t maxFrameSize)
+{
+    if (IS_NULL(sf) ||
+        IS_NULL(frame) ||
+        (frameSize < 1U) ||
+        (frameSize > maxFrameSize) ||
+        (frameSize > sf->tb.bufSize) ||
+        (maxFrameSize < SMALLFRAME_MIN_FRAME_SIZE))
+    {
+        return 0U;
+    }
+
+    switch (frame[0] & SMALLFRAME_TYPE_MASK)
+    {
+    case SMALLFRAME_SINGLE:
+        return HandleSingle(sf, frame, frameSize, maxFrameSize);
+    case SMALLFRAME_FIRST:
+        return HandleFirst(sf, frame, frameSize, maxFrameSize);
+    case SMALLFRAME_CONSECUTIVE:
+        return HandleConsecutive(sf, frame, frameSize, maxFrameSize);
+    default:
+        // Flow control is only sent by the server
+        return 0U;
+    }
+}
+
+/* EoF smallframe.c */
@@ -32,6 +32,7 @@
 /*----------------------------------------------------------------------------*/
 
 #include "updateserver/transfer.h"
+#include <stdint.h>
 #include <string.h>
 
 /*----------------------------------------------------------------------------*/
@@ -82,6 +83,7 @@ static size_t HandleSinglePacket(
         tb->server,
         tb->buf,
         tb->msgSize,
+        tb->bufSize,
         &packet[1],
         maxPacketSize - 1U
     );
@@ -176,6 +178,7 @@ static size_t HandleTransferEnd(
         tb->server,
         tb->buf,
         tb->msgSize,
+        tb->bufSize,
         &packet[1],
         maxPacketSize - 1U
     );
@@ -190,17 +193,37 @@ bool TRANSFER_Init(
     const UpdateServer_t* server, 
     uint8_t* buf, 
     size_t bufSize)
+{
+    return TRANSFER_InitAligned(tb, server, buf, bufSize, 1U);
+}
+
+bool TRANSFER_InitAligned(
+    TransferBuffer_t* tb, 
+    const UpdateServer_t* server, 
+    uint8_t* buf, 
+    size_t bufSize,
+    size_t alignment)
 {
     if (IS_NULL(tb) ||
         IS_NULL(server) ||
         IS_NULL(buf) ||
-        (bufSize < 2U))
+        (alignment == 0U) ||
+        ((alignment & (alignment - 1U)) != 0U))
+    {
+        return false;
+    }
+
+    /* SID goes to the byte before the aligned payload */
+    const uintptr_t payload = (uintptr_t)buf + 1U;
+    const size_t padding = (size_t)((alignment - (payload % alignment)) % alignment);
+
+    if ((bufSize < padding) || ((bufSize - padding) < 2U))
     {
         return false;
     }
 
-    tb->buf = buf;
-    tb->bufSize = bufSize;
+    tb->buf = &buf[padding];
+    tb->bufSize = bufSize - padding;
     tb->server = server;
     tb->msgSize = 0U;
     tb->transferSize = 0U;
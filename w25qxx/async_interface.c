@@ -0,0 +1,737 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * async_interface.c
+ *
+ * @brief Queued asynchronous W25Qxx interface driven by SPI DMA
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "w25qxx/async_interface.h"
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE TYPE DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+typedef struct
+{
+    volatile bool done;
+    volatile bool ok;
+} BlockingResult_t;
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define IS_NULL(ptr) ((ptr) == NULL)
+
+#define CMD_WRITE_ENABLE    (0x06U)
+#define CMD_READ_STATUS1    (0x05U)
+#define CMD_READ_DATA       (0x03U)
+#define CMD_PAGE_PROGRAM    (0x02U)
+#define CMD_SECTOR_ERASE    (0x20U)
+#define CMD_BLOCK_ERASE_32K (0x52U)
+#define CMD_BLOCK_ERASE_64K (0xD8U)
+#define CMD_CHIP_ERASE      (0xC7U)
+#define CMD_SUSPEND         (0x75U)
+#define CMD_RESUME          (0x7AU)
+
+#define STATUS1_BUSY        (0x01U)
+
+#define PAGE_SIZE           (256U)
+#define SECTOR_SIZE         (4096U)
+#define ADDRESS_LIMIT       (16U*1024U*1024U)   /* 3-byte addresses */
+
+#define Aligned(val, alignment) (0 == ((val) % (alignment)))
+#define Min(a,b) (((a) < (b)) ? (a) : (b))
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+static W25QxxAsync_t* f_blocking;
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+static void StartNext(W25QxxAsync_t* handle);
+
+static W25QxxAsyncRequest_t* At(W25QxxAsync_t* handle, size_t offset)
+{
+    return &handle->queue[(handle->head + offset) % handle->queueSize];
+}
+
+static W25QxxAsyncRequest_t* Current(W25QxxAsync_t* handle)
+{
+    return At(handle, 0U);
+}
+
+static bool Overlaps(const W25QxxAsyncRequest_t* a, const W25QxxAsyncRequest_t* b)
+{
+    return ((uint64_t)a->address < ((uint64_t)b->address + b->size)) &&
+           ((uint64_t)b->address < ((uint64_t)a->address + a->size));
+}
+
+/* Queue offset of the first read not depending on an earlier write, 0 if none */
+static size_t FindIndependentRead(W25QxxAsync_t* handle)
+{
+    for (size_t i = 1U; i < handle->count; i++)
+    {
+        const W25QxxAsyncRequest_t* read = At(handle, i);
+
+        if (read->op != W25QXX_ASYNC_READ)
+        {
+            continue;
+        }
+
+        bool independent = true;
+        for (size_t j = 0U; (j < i) && independent; j++)
+        {
+            const W25QxxAsyncRequest_t* earlier = At(handle, j);
+            independent = (earlier->op == W25QXX_ASYNC_READ) || !Overlaps(read, earlier);
+        }
+
+        if (independent)
+        {
+            return i;
+        }
+    }
+
+    return 0U;
+}
+
+/* Remove request served out of order, keeping the order of the others */
+static void RemoveAt(W25QxxAsync_t* handle, size_t offset)
+{
+    for (size_t i = offset; (i + 1U) < handle->count; i++)
+    {
+        *At(handle, i) = *At(handle, i + 1U);
+    }
+    handle->count--;
+}
+
+static void EnterCritical(W25QxxAsync_t* handle)
+{
+    if (!IS_NULL(handle->spi.EnterCritical))
+    {
+        handle->spi.EnterCritical(handle->spi.port);
+    }
+}
+
+static void ExitCritical(W25QxxAsync_t* handle)
+{
+    if (!IS_NULL(handle->spi.ExitCritical))
+    {
+        handle->spi.ExitCritical(handle->spi.port);
+    }
+}
+
+static size_t SetCommand(W25QxxAsync_t* handle, uint8_t cmd, Address_t address)
+{
+    handle->cmd[0] = cmd;
+    handle->cmd[1] = (uint8_t)(address >> 16U);
+    handle->cmd[2] = (uint8_t)(address >> 8U);
+    handle->cmd[3] = (uint8_t)(address);
+    return 4U;
+}
+
+static void Finish(W25QxxAsync_t* handle, bool ok)
+{
+    const W25QxxAsyncRequest_t request = *Current(handle);
+
+    handle->head = (handle->head + 1U) % handle->queueSize;
+    handle->count--;
+    handle->state = W25QXX_ASYNC_STATE_IDLE;
+
+    if (!IS_NULL(request.Done))
+    {
+        request.Done(request.ctx, ok);
+    }
+
+    StartNext(handle);
+}
+
+static void CompleteRead(W25QxxAsync_t* handle, bool ok)
+{
+    const W25QxxAsyncRequest_t request = *At(handle, handle->readIndex);
+
+    RemoveAt(handle, handle->readIndex);
+
+    if (!IS_NULL(request.Done))
+    {
+        request.Done(request.ctx, ok);
+    }
+}
+
+/* Transfer failed, the current request is failed too as the device state is unknown */
+static void Abort(W25QxxAsync_t* handle)
+{
+    switch (handle->state)
+    {
+    case W25QXX_ASYNC_STATE_COMMAND:
+        /* A program or erase may have started */
+        if (Current(handle)->op != W25QXX_ASYNC_READ)
+        {
+            handle->needsResume = true;
+        }
+        break;
+    case W25QXX_ASYNC_STATE_SUSPEND_READ:
+        CompleteRead(handle, false);
+        handle->needsResume = true;
+        break;
+    case W25QXX_ASYNC_STATE_BUSY:
+    case W25QXX_ASYNC_STATE_POLL:
+    case W25QXX_ASYNC_STATE_SUSPEND:
+    case W25QXX_ASYNC_STATE_SUSPEND_POLL:
+    case W25QXX_ASYNC_STATE_RESUME:
+    case W25QXX_ASYNC_STATE_RECOVER:
+    case W25QXX_ASYNC_STATE_RECOVER_WAIT:
+    case W25QXX_ASYNC_STATE_RECOVER_POLL:
+        /* The device may be busy or suspended, it ignores programs and erases
+         * until resumed and done */
+        handle->needsResume = true;
+        break;
+    default:
+        break;
+    }
+
+    Finish(handle, false);
+}
+
+static void Transfer(
+    W25QxxAsync_t* handle,
+    W25QxxAsyncState_t state,
+    size_t cmdLen,
+    const uint8_t* tx,
+    uint8_t* rx,
+    size_t dataLen
+)
+{
+    handle->state = state;
+
+    if (!handle->spi.Transfer(handle->spi.port, handle->cmd, cmdLen, tx, rx, dataLen))
+    {
+        Abort(handle);
+    }
+}
+
+static bool TrySuspend(W25QxxAsync_t* handle)
+{
+    if ((handle->state != W25QXX_ASYNC_STATE_BUSY) ||
+        handle->resumed ||
+        handle->chipErase ||
+        (handle->suspends >= handle->maxSuspends) ||
+        (Current(handle)->op == W25QXX_ASYNC_READ))
+    {
+        return false;
+    }
+
+    handle->readIndex = FindIndependentRead(handle);
+
+    if (handle->readIndex == 0U)
+    {
+        return false;
+    }
+
+    handle->suspends++;
+    handle->cmd[0] = CMD_SUSPEND;
+    Transfer(handle, W25QXX_ASYNC_STATE_SUSPEND, 1U, NULL, NULL, 0U);
+
+    return true;
+}
+
+static void PollSuspended(W25QxxAsync_t* handle)
+{
+    handle->cmd[0] = CMD_READ_STATUS1;
+    Transfer(handle, W25QXX_ASYNC_STATE_SUSPEND_POLL, 1U, NULL, &handle->status, 1U);
+}
+
+static void ServeRead(W25QxxAsync_t* handle)
+{
+    W25QxxAsyncRequest_t* read = At(handle, handle->readIndex);
+    const size_t cmdLen = SetCommand(handle, CMD_READ_DATA, read->address);
+    Transfer(handle, W25QXX_ASYNC_STATE_SUSPEND_READ, cmdLen, NULL, read->data, read->size);
+}
+
+static void Resume(W25QxxAsync_t* handle)
+{
+    handle->cmd[0] = CMD_RESUME;
+    Transfer(handle, W25QXX_ASYNC_STATE_RESUME, 1U, NULL, NULL, 0U);
+}
+
+static void WriteEnable(W25QxxAsync_t* handle)
+{
+    handle->cmd[0] = CMD_WRITE_ENABLE;
+    Transfer(handle, W25QXX_ASYNC_STATE_WRITE_ENABLE, 1U, NULL, NULL, 0U);
+}
+
+static void ProgramPage(W25QxxAsync_t* handle)
+{
+    const W25QxxAsyncRequest_t* request = Current(handle);
+    const size_t offset = handle->pos - request->address;
+    const size_t remaining = request->size - offset;
+    const size_t pageLeft = PAGE_SIZE - (handle->pos % PAGE_SIZE);
+
+    handle->step = Min(remaining, pageLeft);
+    handle->suspends = 0U;
+    handle->resumed = false;
+
+    const size_t cmdLen = SetCommand(handle, CMD_PAGE_PROGRAM, handle->pos);
+    Transfer(handle, W25QXX_ASYNC_STATE_COMMAND, cmdLen, &request->data[offset], NULL, handle->step);
+}
+
+static void EraseBlock(W25QxxAsync_t* handle)
+{
+    const W25QxxAsyncRequest_t* request = Current(handle);
+
+    handle->suspends = 0U;
+    handle->resumed = false;
+
+    if (handle->chipErase)
+    {
+        handle->step = request->size;
+        handle->cmd[0] = CMD_CHIP_ERASE;
+        Transfer(handle, W25QXX_ASYNC_STATE_COMMAND, 1U, NULL, NULL, 0U);
+        return;
+    }
+
+    static const uint8_t commands[] = {
+        [W25QXX_ERASE_4K] = CMD_SECTOR_ERASE,
+        [W25QXX_ERASE_32K] = CMD_BLOCK_ERASE_32K,
+        [W25QXX_ERASE_64K] = CMD_BLOCK_ERASE_64K,
+    };
+
+    const Address_t end = request->address + request->size;
+    const W25QxxEraseOp_t op = W25Qxx_ERASE_Next(handle->pos, end, handle->eraseTimes);
+
+    handle->step = W25Qxx_ERASE_OpSize(op, handle->deviceSize);
+
+    const size_t cmdLen = SetCommand(handle, commands[op], handle->pos);
+    Transfer(handle, W25QXX_ASYNC_STATE_COMMAND, cmdLen, NULL, NULL, 0U);
+}
+
+static void Begin(W25QxxAsync_t* handle)
+{
+    W25QxxAsyncRequest_t* request = Current(handle);
+
+    /* Resume and let a running or suspended command complete before the next request */
+    if (handle->needsResume)
+    {
+        handle->cmd[0] = CMD_RESUME;
+        Transfer(handle, W25QXX_ASYNC_STATE_RECOVER, 1U, NULL, NULL, 0U);
+        return;
+    }
+
+    handle->pos = request->address;
+    handle->step = 0U;
+    handle->chipErase = false;
+
+    switch (request->op)
+    {
+    case W25QXX_ASYNC_READ:
+    {
+        const size_t cmdLen = SetCommand(handle, CMD_READ_DATA, request->address);
+        handle->step = request->size;
+        Transfer(handle, W25QXX_ASYNC_STATE_COMMAND, cmdLen, NULL, request->data, request->size);
+        break;
+    }
+    case W25QXX_ASYNC_ERASE:
+    {
+        W25QxxErasePlan_t plan;
+        if (!W25Qxx_ERASE_Plan(request->address, request->size, handle->deviceSize, handle->eraseTimes, &plan))
+        {
+            /* Checked in submit already */
+            Finish(handle, false);
+            break;
+        }
+        handle->chipErase = (plan.count[W25QXX_ERASE_CHIP] != 0U);
+        WriteEnable(handle);
+        break;
+    }
+    case W25QXX_ASYNC_PROGRAM:
+    default:
+        WriteEnable(handle);
+        break;
+    }
+}
+
+static void StartNext(W25QxxAsync_t* handle)
+{
+    if ((handle->state == W25QXX_ASYNC_STATE_IDLE) && (handle->count > 0U))
+    {
+        Begin(handle);
+    }
+}
+
+static void BlockingDone(void* ctx, bool ok)
+{
+    BlockingResult_t* result = (BlockingResult_t*)ctx;
+    result->ok = ok;
+    result->done = true;
+}
+
+static bool Blocking(W25QxxAsync_t* handle, W25QxxAsyncOp_t op, Address_t address, size_t size, uint8_t* data)
+{
+    if (IS_NULL(handle))
+    {
+        return false;
+    }
+
+    BlockingResult_t result = {.done = false, .ok = false};
+
+    const W25QxxAsyncRequest_t request = {
+        .op = op,
+        .address = address,
+        .size = size,
+        .data = data,
+        .Done = BlockingDone,
+        .ctx = &result
+    };
+
+    if (!W25Qxx_ASYNC_Submit(handle, &request))
+    {
+        return false;
+    }
+
+    while (!result.done)
+    {
+        if (!IS_NULL(handle->spi.Idle))
+        {
+            handle->spi.Idle(handle->spi.port);
+        }
+    }
+
+    return result.ok;
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+bool W25Qxx_ASYNC_Init(
+    W25QxxAsync_t* handle,
+    const W25QxxAsyncPort_t* port,
+    W25QxxAsyncRequest_t* queue,
+    size_t queueSize,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* eraseTimes
+)
+{
+    if (IS_NULL(handle) ||
+        IS_NULL(port) ||
+        IS_NULL(port->Transfer) ||
+        IS_NULL(queue) ||
+        (queueSize == 0U))
+    {
+        return false;
+    }
+
+    memset(handle, 0, sizeof(W25QxxAsync_t));
+    handle->spi = *port;
+    handle->queue = queue;
+    handle->queueSize = queueSize;
+    handle->deviceSize = deviceSize;
+    handle->eraseTimes = IS_NULL(eraseTimes) ? &W25QXX_ERASE_TIMES_TYPICAL : eraseTimes;
+    handle->state = W25QXX_ASYNC_STATE_IDLE;
+    handle->maxSuspends = W25QXX_ASYNC_MAX_SUSPENDS;
+
+    return true;
+}
+
+bool W25Qxx_ASYNC_Submit(
+    W25QxxAsync_t* handle,
+    const W25QxxAsyncRequest_t* request
+)
+{
+    if (IS_NULL(handle) ||
+        IS_NULL(request) ||
+        (request->size == 0U) ||
+        ((request->op != W25QXX_ASYNC_ERASE) && IS_NULL(request->data)))
+    {
+        return false;
+    }
+
+    /* Commands carry 3-byte addresses */
+    const size_t limit = ((handle->deviceSize != 0U) && (handle->deviceSize < ADDRESS_LIMIT)) ?
+        handle->deviceSize : ADDRESS_LIMIT;
+
+    if (((uint64_t)request->address + request->size) > limit)
+    {
+        return false;
+    }
+
+    W25QxxErasePlan_t plan;
+
+    if ((request->op == W25QXX_ASYNC_ERASE) &&
+        (!Aligned(request->address, SECTOR_SIZE) || 
+         !Aligned(request->size, SECTOR_SIZE) ||
+         !W25Qxx_ERASE_Plan(request->address, request->size, handle->deviceSize, handle->eraseTimes, &plan)))
+    {
+        return false;
+    }
+
+    bool queued = false;
+
+    EnterCritical(handle);
+
+    if (handle->count < handle->queueSize)
+    {
+        const size_t tail = (handle->head + handle->count) % handle->queueSize;
+        handle->queue[tail] = *request;
+        handle->count++;
+        queued = true;
+
+        StartNext(handle);
+        (void)TrySuspend(handle);
+    }
+
+    ExitCritical(handle);
+
+    return queued;
+}
+
+void W25Qxx_ASYNC_SetSuspendLimit(W25QxxAsync_t* handle, size_t maxSuspends)
+{
+    if (!IS_NULL(handle))
+    {
+        handle->maxSuspends = maxSuspends;
+    }
+}
+
+bool W25Qxx_ASYNC_IsBusy(const W25QxxAsync_t* handle)
+{
+    return !IS_NULL(handle) && (handle->count > 0U);
+}
+
+void W25Qxx_ASYNC_OnTransferDone(W25QxxAsync_t* handle, bool ok)
+{
+    if (IS_NULL(handle) || (handle->count == 0U))
+    {
+        return;
+    }
+
+    if (!ok)
+    {
+        Abort(handle);
+        return;
+    }
+
+    const W25QxxAsyncRequest_t* request = Current(handle);
+
+    switch (handle->state)
+    {
+    case W25QXX_ASYNC_STATE_WRITE_ENABLE:
+        if (request->op == W25QXX_ASYNC_PROGRAM)
+        {
+            ProgramPage(handle);
+        }
+        else
+        {
+            EraseBlock(handle);
+        }
+        break;
+
+    case W25QXX_ASYNC_STATE_COMMAND:
+        if (request->op == W25QXX_ASYNC_READ)
+        {
+            Finish(handle, true);
+        }
+        else
+        {
+            handle->pos += handle->step;
+            handle->state = W25QXX_ASYNC_STATE_BUSY;
+        }
+        break;
+
+    case W25QXX_ASYNC_STATE_POLL:
+        if ((handle->status & STATUS1_BUSY) != 0U)
+        {
+            handle->state = W25QXX_ASYNC_STATE_BUSY;
+            (void)TrySuspend(handle);
+        }
+        else if ((handle->pos - request->address) >= request->size)
+        {
+            Finish(handle, true);
+        }
+        else
+        {
+            WriteEnable(handle);
+        }
+        break;
+
+    case W25QXX_ASYNC_STATE_SUSPEND:
+        PollSuspended(handle);
+        break;
+
+    case W25QXX_ASYNC_STATE_SUSPEND_POLL:
+        /* BUSY clears within tSUS, also when the command completed instead */
+        if ((handle->status & STATUS1_BUSY) != 0U)
+        {
+            PollSuspended(handle);
+        }
+        else
+        {
+            ServeRead(handle);
+        }
+        break;
+
+    case W25QXX_ASYNC_STATE_SUSPEND_READ:
+        CompleteRead(handle, true);
+        handle->readIndex = FindIndependentRead(handle);
+        if (handle->readIndex != 0U)
+        {
+            ServeRead(handle);
+        }
+        else
+        {
+            /* Ignored by the device if the command already completed */
+            Resume(handle);
+        }
+        break;
+
+    case W25QXX_ASYNC_STATE_RESUME:
+        handle->resumed = true;
+        handle->state = W25QXX_ASYNC_STATE_BUSY;
+        break;
+
+    case W25QXX_ASYNC_STATE_RECOVER:
+        handle->needsResume = false;
+        handle->state = W25QXX_ASYNC_STATE_RECOVER_WAIT;
+        break;
+
+    case W25QXX_ASYNC_STATE_RECOVER_POLL:
+        if ((handle->status & STATUS1_BUSY) != 0U)
+        {
+            handle->state = W25QXX_ASYNC_STATE_RECOVER_WAIT;
+        }
+        else
+        {
+            Begin(handle);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void W25Qxx_ASYNC_OnTick(W25QxxAsync_t* handle)
+{
+    if (IS_NULL(handle))
+    {
+        return;
+    }
+
+    if (handle->state == W25QXX_ASYNC_STATE_RECOVER_WAIT)
+    {
+        handle->cmd[0] = CMD_READ_STATUS1;
+        Transfer(handle, W25QXX_ASYNC_STATE_RECOVER_POLL, 1U, NULL, &handle->status, 1U);
+        return;
+    }
+
+    if (handle->state != W25QXX_ASYNC_STATE_BUSY)
+    {
+        return;
+    }
+
+    /* Let the command progress for a tick after resume */
+    if (handle->resumed)
+    {
+        handle->resumed = false;
+    }
+    else if (TrySuspend(handle))
+    {
+        return;
+    }
+
+    handle->cmd[0] = CMD_READ_STATUS1;
+    Transfer(handle, W25QXX_ASYNC_STATE_POLL, 1U, NULL, &handle->status, 1U);
+}
+
+bool W25Qxx_ASYNC_ReadBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+)
+{
+    return Blocking(handle, W25QXX_ASYNC_READ, address, size, out);
+}
+
+bool W25Qxx_ASYNC_WriteBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+)
+{
+    return Blocking(handle, W25QXX_ASYNC_PROGRAM, address, size, (uint8_t*)in);
+}
+
+bool W25Qxx_ASYNC_EraseBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size
+)
+{
+    return Blocking(handle, W25QXX_ASYNC_ERASE, address, size, NULL);
+}
+
+void W25Qxx_ASYNC_SetBlockingInstance(W25QxxAsync_t* handle)
+{
+    f_blocking = handle;
+}
+
+bool W25Qxx_ASYNC_ReadFlash(
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+)
+{
+    return W25Qxx_ASYNC_ReadBlocking(f_blocking, address, size, out);
+}
+
+bool W25Qxx_ASYNC_WriteFlash(
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+)
+{
+    return W25Qxx_ASYNC_WriteBlocking(f_blocking, address, size, in);
+}
+
+bool W25Qxx_ASYNC_EraseFlash(
+    Address_t address, 
+    size_t size
+)
+{
+    return W25Qxx_ASYNC_EraseBlocking(f_blocking, address, size);
+}
+
+/* EoF async_interface.c */
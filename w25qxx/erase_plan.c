@@ -0,0 +1,181 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * erase_plan.c
+ *
+ * @brief Minimum time erase sequences for W25Qxx devices
+*/
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include "w25qxx/erase_plan.h"
+#include <string.h>
+
+/*----------------------------------------------------------------------------*/
+/* MACRO DEFINITIONS                                                          */
+/*----------------------------------------------------------------------------*/
+
+#define KB      (1024U)
+#define _4KB    (4U*KB)
+#define _32KB   (32U*KB)
+#define _64KB   (64U*KB)
+
+#define Aligned(val, alignment) (0 == ((val) % (alignment)))
+#define Min(a,b) (((a) < (b)) ? (a) : (b))
+
+/*----------------------------------------------------------------------------*/
+/* VARIABLE DEFINITIONS                                                       */
+/*----------------------------------------------------------------------------*/
+
+const W25QxxEraseTimes_t W25QXX_ERASE_TIMES_TYPICAL = {
+    .timeUs = {
+        [W25QXX_ERASE_4K]   = 45000U,
+        [W25QXX_ERASE_32K]  = 120000U,
+        [W25QXX_ERASE_64K]  = 150000U,
+        [W25QXX_ERASE_CHIP] = 40000000U,
+    }
+};
+
+/*----------------------------------------------------------------------------*/
+/* PRIVATE FUNCTION DEFINITIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/* Best time to erase a fully covered aligned 32 KB block */
+static uint64_t BestTime32K(const W25QxxEraseTimes_t* times)
+{
+    return Min((uint64_t)times->timeUs[W25QXX_ERASE_32K],
+               8U * (uint64_t)times->timeUs[W25QXX_ERASE_4K]);
+}
+
+/* Best time to erase a fully covered aligned 64 KB block */
+static uint64_t BestTime64K(const W25QxxEraseTimes_t* times)
+{
+    return Min((uint64_t)times->timeUs[W25QXX_ERASE_64K],
+               2U * BestTime32K(times));
+}
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+size_t W25Qxx_ERASE_OpSize(W25QxxEraseOp_t op, size_t deviceSize)
+{
+    switch (op)
+    {
+    case W25QXX_ERASE_4K:
+        return _4KB;
+    case W25QXX_ERASE_32K:
+        return _32KB;
+    case W25QXX_ERASE_64K:
+        return _64KB;
+    case W25QXX_ERASE_CHIP:
+        return deviceSize;
+    default:
+        return 0U;
+    }
+}
+
+W25QxxEraseOp_t W25Qxx_ERASE_Next(
+    uint32_t pos,
+    uint32_t end,
+    const W25QxxEraseTimes_t* times
+)
+{
+    /* end wraps to 0 for a range ending at 4 GB, pos == end is then 4 GB */
+    uint64_t remaining = (uint32_t)(end - pos);
+    if (remaining == 0U)
+    {
+        remaining = (uint64_t)UINT32_MAX + 1U;
+    }
+
+    /* Ties prefer the larger block, fewer commands */
+    if (Aligned(pos, _64KB) && (remaining >= _64KB) &&
+        ((uint64_t)times->timeUs[W25QXX_ERASE_64K] <= BestTime64K(times)))
+    {
+        return W25QXX_ERASE_64K;
+    }
+
+    if (Aligned(pos, _32KB) && (remaining >= _32KB) &&
+        ((uint64_t)times->timeUs[W25QXX_ERASE_32K] <= BestTime32K(times)))
+    {
+        return W25QXX_ERASE_32K;
+    }
+
+    return W25QXX_ERASE_4K;
+}
+
+bool W25Qxx_ERASE_Plan(
+    uint32_t address,
+    size_t size,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times,
+    W25QxxErasePlan_t* plan
+)
+{
+    if ((NULL == plan) ||
+        !Aligned(address, _4KB) ||
+        !Aligned(size, _4KB) ||
+        (size == 0U) ||
+        ((uint64_t)size > ((uint64_t)UINT32_MAX - address + 1U)))
+    {
+        return false;
+    }
+
+    if (NULL == times)
+    {
+        times = &W25QXX_ERASE_TIMES_TYPICAL;
+    }
+
+    memset(plan, 0, sizeof(W25QxxErasePlan_t));
+
+    /* end wraps to 0 for a range ending at 4 GB, so count the offset in
+     * 64 bits: size may be 4 GB itself */
+    const uint32_t end = address + (uint32_t)size;
+    uint64_t offset = 0U;
+    uint64_t total = 0U;
+
+    while (offset < size)
+    {
+        const W25QxxEraseOp_t op = W25Qxx_ERASE_Next(address + (uint32_t)offset, end, times);
+        plan->count[op]++;
+        total += times->timeUs[op];
+        offset += W25Qxx_ERASE_OpSize(op, deviceSize);
+    }
+
+    if ((address == 0U) && (size == deviceSize) &&
+        ((uint64_t)times->timeUs[W25QXX_ERASE_CHIP] < total))
+    {
+        memset(plan, 0, sizeof(W25QxxErasePlan_t));
+        plan->count[W25QXX_ERASE_CHIP] = 1U;
+        total = times->timeUs[W25QXX_ERASE_CHIP];
+    }
+
+    plan->totalUs = (total > UINT32_MAX) ? UINT32_MAX : (uint32_t)total;
+
+    return true;
+}
+
+/* EoF erase_plan.c */
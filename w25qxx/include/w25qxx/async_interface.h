@@ -0,0 +1,306 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * async_interface.h
+ *
+ * @brief Queued asynchronous W25Qxx interface driven by SPI DMA
+ * 
+ * Read, program and erase requests are queued and executed by a state machine
+ * that is advanced from two interrupt contexts: the SPI DMA transfer complete
+ * interrupt calls W25Qxx_ASYNC_OnTransferDone and a periodic timer calls
+ * W25Qxx_ASYNC_OnTick to poll the status register while the device is busy.
+ * The CPU is free during transfers and while the device programs or erases.
+ * 
+ * A read that does not depend on queued writes is served ahead of them by
+ * suspending a block erase or page program in progress, up to maxSuspends
+ * times per command so that the erase or program still completes. If a
+ * transfer fails while suspended, the failed request completes with an error
+ * and the next request first resumes the device and waits for it.
+ * 
+ * Standard SPI commands with 3 byte addresses are used.
+*/
+
+#ifndef ASYNC_INTERFACE_H_
+#define ASYNC_INTERFACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fragmentstore/fragmentstore.h"    // Address_t
+#include "w25qxx/erase_plan.h"
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC MACRO DEFINITIONS                                                   */
+/*----------------------------------------------------------------------------*/
+
+#define W25QXX_ASYNC_CMD_MAX_SIZE   (5U)    /* Command, address and dummy */
+
+/** Define blocking memory callbacks prefix_ReadFlash, prefix_WriteFlash and
+ *  prefix_EraseFlash bound to an instance
+ * 
+ * Callbacks the including file does not use are marked unused.
+ * 
+ * @param prefix    Function name prefix
+ * @param handle    W25QxxAsync_t variable
+ */
+#define W25QXX_ASYNC_ADAPTERS(prefix, handle) \
+    __attribute__((unused)) static bool prefix##_ReadFlash(Address_t address, size_t size, uint8_t* out) \
+    { \
+        return W25Qxx_ASYNC_ReadBlocking(&(handle), address, size, out); \
+    } \
+    __attribute__((unused)) static bool prefix##_WriteFlash(Address_t address, size_t size, const uint8_t* in) \
+    { \
+        return W25Qxx_ASYNC_WriteBlocking(&(handle), address, size, in); \
+    } \
+    __attribute__((unused)) static bool prefix##_EraseFlash(Address_t address, size_t size) \
+    { \
+        return W25Qxx_ASYNC_EraseBlocking(&(handle), address, size); \
+    }
+
+/* Default limit of suspends per erase or program command */
+#ifndef W25QXX_ASYNC_MAX_SUSPENDS
+#define W25QXX_ASYNC_MAX_SUSPENDS   (8U)
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    W25QXX_ASYNC_READ = 0,
+    W25QXX_ASYNC_PROGRAM,
+    W25QXX_ASYNC_ERASE
+} W25QxxAsyncOp_t;
+
+/** Request completion, called from the interrupt context advancing the queue
+ * @param ctx Request context
+ * @param ok Request completed successfully
+ */
+typedef void (*W25QxxAsyncDone_t)(void* ctx, bool ok);
+
+typedef struct
+{
+    W25QxxAsyncOp_t     op;
+    Address_t           address;
+    size_t              size;
+    uint8_t*            data;       /* Destination for reads, source for programs */
+    W25QxxAsyncDone_t   Done;       /* May be NULL */
+    void*               ctx;
+} W25QxxAsyncRequest_t;
+
+typedef struct
+{
+    /** Start SPI transfer with chip select held over both phases
+     * 
+     * Sends cmd, then transmits tx or receives into rx for dataLen bytes.
+     * Completion must be reported with W25Qxx_ASYNC_OnTransferDone, not from
+     * within this call.
+     * 
+     * @return Transfer started
+     */
+    bool (*Transfer)(
+        void* port,
+        const uint8_t* cmd,
+        size_t cmdLen,
+        const uint8_t* tx,
+        uint8_t* rx,
+        size_t dataLen
+    );
+
+    /** Protect the queue from the completion interrupts, may be NULL */
+    void (*EnterCritical)(void* port);
+    void (*ExitCritical)(void* port);
+
+    /** Wait in the blocking shim, e.g. __WFI(), may be NULL */
+    void (*Idle)(void* port);
+
+    void* port;
+} W25QxxAsyncPort_t;
+
+typedef enum
+{
+    W25QXX_ASYNC_STATE_IDLE = 0,
+    W25QXX_ASYNC_STATE_WRITE_ENABLE,
+    W25QXX_ASYNC_STATE_COMMAND,
+    W25QXX_ASYNC_STATE_BUSY,            /* Waiting for the next tick */
+    W25QXX_ASYNC_STATE_POLL,            /* Status register read in flight */
+    W25QXX_ASYNC_STATE_SUSPEND,         /* Suspend command in flight */
+    W25QXX_ASYNC_STATE_SUSPEND_POLL,    /* Waiting for the suspend to take effect */
+    W25QXX_ASYNC_STATE_SUSPEND_READ,    /* Read served while suspended */
+    W25QXX_ASYNC_STATE_RESUME,          /* Resume command in flight */
+    W25QXX_ASYNC_STATE_RECOVER,         /* Resume after a failed transfer in flight */
+    W25QXX_ASYNC_STATE_RECOVER_WAIT,    /* Waiting for the resumed command to complete */
+    W25QXX_ASYNC_STATE_RECOVER_POLL     /* Status register read in flight */
+} W25QxxAsyncState_t;
+
+typedef struct
+{
+    W25QxxAsyncPort_t           spi;
+    const W25QxxEraseTimes_t*   eraseTimes;
+    size_t                      deviceSize;
+
+    /* Request queue */
+    W25QxxAsyncRequest_t*       queue;
+    size_t                      queueSize;
+    size_t                      head;
+    size_t                      count;
+
+    /* Current request */
+    W25QxxAsyncState_t          state;
+    Address_t                   pos;
+    size_t                      step;       /* Bytes handled by the current command */
+    bool                        chipErase;
+
+    /* Suspend and resume */
+    size_t                      maxSuspends;
+    size_t                      suspends;   /* Suspends of the current command */
+    size_t                      readIndex;  /* Queue offset of the read served */
+    bool                        resumed;    /* No suspend before the next tick */
+    bool                        needsResume;/* Transfer failed while a command may run */
+    uint8_t                     cmd[W25QXX_ASYNC_CMD_MAX_SIZE];
+    uint8_t                     status;
+} W25QxxAsync_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Initialize asynchronous interface
+ * 
+ * @param handle Interface instance
+ * @param port SPI port
+ * @param queue Request storage
+ * @param queueSize Number of requests in queue
+ * @param deviceSize Device size in bytes, 0 if unknown: disables chip erase
+ *                   and limits requests to 16 MB only
+ * @param eraseTimes Erase times, NULL for W25QXX_ERASE_TIMES_TYPICAL
+ * @return Init ok
+ */
+extern bool W25Qxx_ASYNC_Init(
+    W25QxxAsync_t* handle,
+    const W25QxxAsyncPort_t* port,
+    W25QxxAsyncRequest_t* queue,
+    size_t queueSize,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* eraseTimes
+);
+
+/** Queue request
+ * 
+ * Requests must end within the device and the first 16 MB, as commands use
+ * 3-byte addresses. Erase requests must be 4 KB aligned. The request is
+ * copied, its data buffer must stay valid until completion.
+ * 
+ * @return false if the queue is full or the request is invalid
+ */
+extern bool W25Qxx_ASYNC_Submit(
+    W25QxxAsync_t* handle,
+    const W25QxxAsyncRequest_t* request
+);
+
+/** Set limit of suspends per erase or program command
+ * 
+ * @param handle Interface instance
+ * @param maxSuspends Limit, 0 disables suspending
+ */
+extern void W25Qxx_ASYNC_SetSuspendLimit(W25QxxAsync_t* handle, size_t maxSuspends);
+
+/** Any request queued or in progress */
+extern bool W25Qxx_ASYNC_IsBusy(const W25QxxAsync_t* handle);
+
+/** SPI DMA transfer complete, call from the interrupt handler
+ * @param ok Transfer succeeded
+ */
+extern void W25Qxx_ASYNC_OnTransferDone(W25QxxAsync_t* handle, bool ok);
+
+/** Periodic tick for status polling, call from a timer interrupt */
+extern void W25Qxx_ASYNC_OnTick(W25QxxAsync_t* handle);
+
+/** Submit request and wait for completion in the port Idle hook */
+extern bool W25Qxx_ASYNC_ReadBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+);
+
+extern bool W25Qxx_ASYNC_WriteBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+);
+
+extern bool W25Qxx_ASYNC_EraseBlocking(
+    W25QxxAsync_t* handle,
+    Address_t address, 
+    size_t size
+);
+
+/** Select instance used by the blocking functions below */
+extern void W25Qxx_ASYNC_SetBlockingInstance(W25QxxAsync_t* handle);
+
+/** Blocking read
+ * @note ReadMemory_t signature
+ */
+extern bool W25Qxx_ASYNC_ReadFlash(
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+);
+
+/** Blocking write
+ * @note WriteMemory_t signature
+ */
+extern bool W25Qxx_ASYNC_WriteFlash(
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+);
+
+/** Blocking erase
+ * @note EraseSectors_t signature
+ */
+extern bool W25Qxx_ASYNC_EraseFlash(
+    Address_t address, 
+    size_t size
+);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF async_interface.h */
+
+#endif /* ASYNC_INTERFACE_H_ */
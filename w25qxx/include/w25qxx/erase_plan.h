@@ -0,0 +1,130 @@
+/* MIT License
+ * 
+ * Copyright (c) 2026 Mikael Penttinen
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * erase_plan.h
+ *
+ * @brief Minimum time erase sequences for W25Qxx devices
+ * 
+ * Erase blocks are naturally aligned and nest (16 x 4 KB in 32 KB... in 64 KB),
+ * so for every aligned block fully inside the range it is enough to compare
+ * the block erase time against erasing its halves or sectors. Chip erase is
+ * used when the whole device is requested and it is faster than the blocks.
+*/
+
+#ifndef ERASE_PLAN_H_
+#define ERASE_PLAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* INCLUDE DIRECTIVES                                                         */
+/*----------------------------------------------------------------------------*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC TYPE DEFINITIONS                                                    */
+/*----------------------------------------------------------------------------*/
+
+typedef enum
+{
+    W25QXX_ERASE_4K = 0,
+    W25QXX_ERASE_32K,
+    W25QXX_ERASE_64K,
+    W25QXX_ERASE_CHIP,
+    W25QXX_ERASE_OP_COUNT
+} W25QxxEraseOp_t;
+
+typedef struct
+{
+    uint32_t timeUs[W25QXX_ERASE_OP_COUNT];  /* Erase time per operation */
+} W25QxxEraseTimes_t;
+
+typedef struct
+{
+    uint32_t count[W25QXX_ERASE_OP_COUNT];   /* Operations in the plan */
+    uint32_t totalUs;                        /* Planned erase time */
+} W25QxxErasePlan_t;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC VARIABLE DEFINITIONS                                                */
+/*----------------------------------------------------------------------------*/
+
+/* Typical times from the W25Q128JV datasheet (tSE, tBE1, tBE2, tCE) */
+extern const W25QxxEraseTimes_t W25QXX_ERASE_TIMES_TYPICAL;
+
+/*----------------------------------------------------------------------------*/
+/* PUBLIC FUNCTION DECLARATIONS                                               */
+/*----------------------------------------------------------------------------*/
+
+/** Size of area erased by the operation
+ * 
+ * @param op Erase operation
+ * @param deviceSize Device size in bytes, for W25QXX_ERASE_CHIP
+ * @return Size in bytes
+ */
+extern size_t W25Qxx_ERASE_OpSize(W25QxxEraseOp_t op, size_t deviceSize);
+
+/** Next block erase of the minimum time sequence, chip erase excluded
+ * 
+ * @param pos Current position, 4 KB aligned
+ * @param end End of the range, 4 KB aligned and larger than pos, 0 for
+ *            a range ending at 4 GB, where pos == 0 means the whole 4 GB
+ * @param times Erase times
+ * @return Operation to erase at pos
+ */
+extern W25QxxEraseOp_t W25Qxx_ERASE_Next(
+    uint32_t pos,
+    uint32_t end,
+    const W25QxxEraseTimes_t* times
+);
+
+/** Plan minimum time erase of a range
+ * 
+ * @param address Range start, 4 KB aligned
+ * @param size Range size, non-zero multiple of 4 KB
+ * @param deviceSize Device size in bytes, 0 disables chip erase
+ * @param times Erase times, NULL for W25QXX_ERASE_TIMES_TYPICAL
+ * @param plan Output for the operation counts and planned time
+ * @return false on invalid range
+ */
+extern bool W25Qxx_ERASE_Plan(
+    uint32_t address,
+    size_t size,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times,
+    W25QxxErasePlan_t* plan
+);
+
+#ifdef __cplusplus
+} /* extern C */
+#endif
+
+/* EoF erase_plan.h */
+
+#endif /* ERASE_PLAN_H_ */
@@ -25,6 +25,11 @@
  * flash_interface.h
  *
  * @brief Interface wrapper for the w25qxx driver
+ * 
+ * W25Qxx_INTERFACE_ functions use a single built-in instance. Several chips
+ * are used through W25QxxInstance_t and the W25Qxx_INSTANCE_ functions, and
+ * W25QXX_INSTANCE_ADAPTERS generates the fragmentstore memory callbacks for
+ * an instance.
 */
 
 #ifndef FLASH_INTERFACE_H_
@@ -40,15 +45,80 @@ extern "C" {
 
 #include "driver_w25qxx.h"
 #include "fragmentstore/fragmentstore.h"    // Address_t
+#include "w25qxx/erase_plan.h"
 
 /*----------------------------------------------------------------------------*/
 /* PUBLIC TYPE DEFINITIONS                                                    */
 /*----------------------------------------------------------------------------*/
 
+typedef enum
+{
+    W25QXX_READ_STANDARD = 0,           /* Driver default w25qxx_read */
+    W25QXX_READ_FAST,                   /* 0Bh */
+    W25QXX_READ_DUAL_OUTPUT,            /* 3Bh */
+    W25QXX_READ_QUAD_OUTPUT,            /* 6Bh, QE bit must be set */
+    W25QXX_READ_QUAD_IO,                /* EBh, QE bit must be set */
+    W25QXX_READ_QUAD_IO_CONTINUOUS,     /* EBh without instruction after the first read */
+    W25QXX_READ_AUTO                    /* Fast read, driver read in QPI mode */
+} W25QxxReadMode_t;
+
+typedef enum
+{
+    W25QXX_VERIFY_COMPARE = 0,          /* Compare readback in the work buffer */
+    W25QXX_VERIFY_CRC                   /* Compare CRC32 of source and readback */
+} W25QxxVerifyMode_t;
+
+typedef struct
+{
+    w25qxx_handle_t*            device;
+    uint8_t*                    buf;            /* Verify buffer, may be NULL */
+    size_t                      bufSize;
+    W25QxxVerifyMode_t          verifyMode;
+
+    /* Erase planning */
+    size_t                      deviceSize;
+    const W25QxxEraseTimes_t*   eraseTimes;
+
+    /* Read mode and read-ahead */
+    W25QxxReadMode_t            readMode;
+    bool                        continuous;     /* Device expects no instruction */
+    uint8_t*                    readAhead;
+    size_t                      readAheadSize;
+    Address_t                   cacheAddress;
+    size_t                      cacheSize;
+    Address_t                   lastReadEnd;
+} W25QxxInstance_t;
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC MACRO DEFINITIONS                                                   */
 /*----------------------------------------------------------------------------*/
 
+/** Define memory callbacks prefix_ReadFlash, prefix_WriteFlash,
+ *  prefix_WriteAndVerifyFlash and prefix_EraseFlash bound to an instance
+ * 
+ * Callbacks the including file does not use are marked unused.
+ * 
+ * @param prefix    Function name prefix
+ * @param instance  W25QxxInstance_t variable
+ */
+#define W25QXX_INSTANCE_ADAPTERS(prefix, instance) \
+    __attribute__((unused)) static bool prefix##_ReadFlash(Address_t address, size_t size, uint8_t* out) \
+    { \
+        return W25Qxx_INSTANCE_ReadFlash(&(instance), address, size, out); \
+    } \
+    __attribute__((unused)) static bool prefix##_WriteFlash(Address_t address, size_t size, const uint8_t* in) \
+    { \
+        return W25Qxx_INSTANCE_WriteFlash(&(instance), address, size, in); \
+    } \
+    __attribute__((unused)) static bool prefix##_WriteAndVerifyFlash(Address_t address, size_t size, const uint8_t* in) \
+    { \
+        return W25Qxx_INSTANCE_WriteAndVerifyFlash(&(instance), address, size, in); \
+    } \
+    __attribute__((unused)) static bool prefix##_EraseFlash(Address_t address, size_t size) \
+    { \
+        return W25Qxx_INSTANCE_EraseFlash(&(instance), address, size); \
+    }
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC VARIABLE DEFINITIONS                                                */
 /*----------------------------------------------------------------------------*/
@@ -57,6 +127,85 @@ extern "C" {
 /* PUBLIC FUNCTION DECLARATIONS                                               */
 /*----------------------------------------------------------------------------*/
 
+/** Initialize interface instance
+ * 
+ * Clears erase and read configuration, configure them after init.
+ * 
+ * @param inst              Instance
+ * @param device            Initialized w25qxx device handle
+ * @param workBuffer        Memory buffer for verify operations, NULL selects
+ *                          W25QXX_VERIFY_CRC with a small stack buffer
+ * @param workBufferSize    Size of workBuffer
+ * 
+ * @return Init ok
+ */
+extern bool W25Qxx_INSTANCE_Init(
+    W25QxxInstance_t* inst,
+    w25qxx_handle_t* device, 
+    uint8_t* workBuffer, 
+    size_t workBufferSize
+);
+
+/** See W25Qxx_INTERFACE_ConfigureRead */
+extern bool W25Qxx_INSTANCE_ConfigureRead(
+    W25QxxInstance_t* inst,
+    W25QxxReadMode_t mode,
+    uint8_t* readAheadBuffer,
+    size_t readAheadSize
+);
+
+/** See W25Qxx_INTERFACE_ReadFlash */
+extern bool W25Qxx_INSTANCE_ReadFlash(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+);
+
+/** See W25Qxx_INTERFACE_WriteFlash */
+extern bool W25Qxx_INSTANCE_WriteFlash(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+);
+
+/** See W25Qxx_INTERFACE_WriteAndVerifyFlash */
+extern bool W25Qxx_INSTANCE_WriteAndVerifyFlash(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+);
+
+/** See W25Qxx_INTERFACE_ConfigureVerify */
+extern bool W25Qxx_INSTANCE_ConfigureVerify(
+    W25QxxInstance_t* inst,
+    W25QxxVerifyMode_t mode
+);
+
+/** See W25Qxx_INTERFACE_ConfigureErase */
+extern bool W25Qxx_INSTANCE_ConfigureErase(
+    W25QxxInstance_t* inst,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times
+);
+
+/** See W25Qxx_INTERFACE_PlanErase */
+extern bool W25Qxx_INSTANCE_PlanErase(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size,
+    W25QxxErasePlan_t* plan
+);
+
+/** See W25Qxx_INTERFACE_EraseFlash */
+extern bool W25Qxx_INSTANCE_EraseFlash(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size
+);
+
 /** Initialize interface wrapper for W25Qxx flash driver
  * 
  * @param device            Initialized w25qxx device handle
@@ -71,6 +220,34 @@ extern bool W25Qxx_INTERFACE_Init(
     size_t workBufferSize
 );
 
+/** Configure read mode and read-ahead
+ * 
+ * Sequential reads smaller than the read-ahead buffer are served from data
+ * prefetched with a single command. Writes and erases invalidate the buffer.
+ * 
+ * Read commands other than W25QXX_READ_STANDARD are issued directly:
+ *  - SPI handles get the command bytes in in_buf with instruction_line 0
+ *    and support only W25QXX_READ_FAST
+ *  - QSPI handles without dual/quad keep the device in SPI mode, the
+ *    instruction uses 1 line and all read commands are supported
+ *  - QSPI handles with dual/quad put the device in QPI mode, only
+ *    W25QXX_READ_STANDARD is supported as the driver handles QPI reads
+ * 
+ * Without a device size from W25Qxx_INTERFACE_ConfigureErase, read-ahead
+ * stops at the end of the 3 or 4 byte address space.
+ * 
+ * @param mode              Read command, W25QXX_READ_AUTO selects fast read,
+ *                          or the driver read in QPI mode
+ * @param readAheadBuffer   Read-ahead buffer, NULL disables read-ahead
+ * @param readAheadSize     Size of readAheadBuffer
+ * @return false if the mode is not supported by the handle configuration
+ */
+extern bool W25Qxx_INTERFACE_ConfigureRead(
+    W25QxxReadMode_t mode,
+    uint8_t* readAheadBuffer,
+    size_t readAheadSize
+);
+
 /** Read flash memory from the W25Qxx device
  * @note ReadMemory_t signature
  * @param address   Flash address
@@ -95,7 +272,7 @@ extern bool W25Qxx_INTERFACE_WriteFlash(
     const uint8_t* in
 );
 
-/** Write to the W25Qxx device flash memory
+/** Write to the W25Qxx device flash memory and verify the written data
  * @note WriteMemory_t signature
  * @param address   Flash address
  * @param size      Write length
@@ -107,7 +284,44 @@ extern bool W25Qxx_INTERFACE_WriteAndVerifyFlash(
     const uint8_t* in
 );
 
+/** Select how W25Qxx_INTERFACE_WriteAndVerifyFlash verifies
+ * 
+ * W25QXX_VERIFY_CRC streams the readback through CRC32 (CRC32_SetKernel
+ * selects e.g. a hardware CRC) and needs no work buffer.
+ * 
+ * @param mode      Verify mode, W25QXX_VERIFY_COMPARE needs a work buffer
+ */
+extern bool W25Qxx_INTERFACE_ConfigureVerify(
+    W25QxxVerifyMode_t mode
+);
+
+/** Configure erase planning
+ * 
+ * Chip erase is only used when the device size is known.
+ * 
+ * @param deviceSize    Device size in bytes, 0 disables chip erase
+ * @param times         Erase times, NULL for W25QXX_ERASE_TIMES_TYPICAL
+ */
+extern bool W25Qxx_INTERFACE_ConfigureErase(
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times
+);
+
+/** Plan erase without erasing, e.g. for scheduling around the erase time
+ * @param address   Flash address
+ * @param size      Erase size (Multiple of 4096)
+ * @param plan      Output for operation counts and planned time
+ */
+extern bool W25Qxx_INTERFACE_PlanErase(
+    Address_t address, 
+    size_t size,
+    W25QxxErasePlan_t* plan
+);
+
 /** Erase sectors in W25Qxx device flash memory
+ * 
+ * Uses the minimum time sequence of chip, 64 KB, 32 KB and 4 KB erases.
+ * 
  * @note EraseSectors_t signature
  * @param address   Flash address
  * @param size      Erase size (Multiple of 4096)
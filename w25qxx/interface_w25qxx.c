@@ -32,19 +32,34 @@
 /*----------------------------------------------------------------------------*/
 
 #include "w25qxx/flash_interface.h"
+#include "w25qxx/erase_plan.h"
+#include "crc/crc32.h"
+#include <string.h>
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE TYPE DEFINITIONS                                                   */
 /*----------------------------------------------------------------------------*/
 
+typedef struct
+{
+    uint8_t instruction;
+    uint8_t addressLines;
+    uint8_t modeLines;      /* 0 if no mode byte */
+    uint8_t dummyCycles;
+    uint8_t dataLines;
+} ReadCommand_t;
+
 /*----------------------------------------------------------------------------*/
 /* MACRO DEFINITIONS                                                          */
 /*----------------------------------------------------------------------------*/
 
 #define KB      (1024U)
 #define _4KB    (4U*KB)
-#define _32KB   (32U*KB)
-#define _64KB   (64U*KB)
+
+#define VERIFY_CHUNK_SIZE   (64U)       /* Stack chunk without work buffer */
+
+#define MODE_CONTINUOUS     (0x20U)     /* M5-4 = 10b keeps continuous read */
+#define MODE_EXIT           (0xFFU)
 
 #define Aligned(val, alignment) (0 == ((val) % (alignment)))
 #define Min(a,b) (((a) < (b)) ? (a) : (b))
@@ -53,79 +68,351 @@
 /* VARIABLE DEFINITIONS                                                       */
 /*----------------------------------------------------------------------------*/
 
-static w25qxx_handle_t* f_w25qxx;
-static uint8_t*         f_buf;
-static size_t           f_bufSize;
+/* Instance behind the W25Qxx_INTERFACE_ functions */
+static W25QxxInstance_t f_instance;
+
+static const ReadCommand_t f_readCommands[] = {
+    [W25QXX_READ_FAST]                  = {0x0BU, 1U, 0U, 8U, 1U},
+    [W25QXX_READ_DUAL_OUTPUT]           = {0x3BU, 1U, 0U, 8U, 2U},
+    [W25QXX_READ_QUAD_OUTPUT]           = {0x6BU, 1U, 0U, 8U, 4U},
+    [W25QXX_READ_QUAD_IO]               = {0xEBU, 4U, 4U, 4U, 4U},
+    [W25QXX_READ_QUAD_IO_CONTINUOUS]    = {0xEBU, 4U, 4U, 4U, 4U},
+};
 
 /*----------------------------------------------------------------------------*/
 /* PRIVATE FUNCTION DEFINITIONS                                               */
 /*----------------------------------------------------------------------------*/
 
+static uint8_t AddressLength(const W25QxxInstance_t* inst)
+{
+    return (inst->device->address_mode == W25QXX_ADDRESS_MODE_4_BYTE) ? 4U : 3U;
+}
+
+/* SPI handles take the whole command in in_buf with instruction_line 0 */
+static bool IsSpi(const W25QxxInstance_t* inst)
+{
+    return inst->device->spi_qspi == W25QXX_INTERFACE_SPI;
+}
+
+/* QSPI with dual/quad enabled puts the device in QPI mode (38h) where every
+ * phase uses 4 lines */
+static bool IsQpi(const W25QxxInstance_t* inst)
+{
+    return (inst->device->spi_qspi == W25QXX_INTERFACE_QSPI) &&
+           (inst->device->dual_quad_spi_enable != 0U);
+}
+
+/* Direct read commands are issued only where their line encoding is known */
+static bool ModeSupported(const W25QxxInstance_t* inst, W25QxxReadMode_t mode)
+{
+    if ((mode == W25QXX_READ_STANDARD) || (mode == W25QXX_READ_AUTO))
+    {
+        return true;
+    }
+
+    if (IsQpi(inst))
+    {
+        return false;
+    }
+
+    return !IsSpi(inst) || (mode == W25QXX_READ_FAST);
+}
+
+/* End of the readable range, the address space if the device size is not set */
+static uint64_t ReadLimit(const W25QxxInstance_t* inst)
+{
+    return (inst->deviceSize != 0U) ? (uint64_t)inst->deviceSize :
+                                      ((uint64_t)1U << (8U * AddressLength(inst)));
+}
+
+/* Single line read with instruction, address and dummy bytes in in_buf */
+static uint8_t SpiRead(W25QxxInstance_t* inst, const ReadCommand_t* cmd, Address_t address, size_t size, uint8_t* out)
+{
+    uint8_t header[1U + 4U + 1U];
+    size_t len = 0U;
+
+    header[len++] = cmd->instruction;
+    for (uint8_t i = AddressLength(inst); i > 0U; i--)
+    {
+        header[len++] = (uint8_t)(address >> (8U * (i - 1U)));
+    }
+    for (uint8_t i = 0U; i < (cmd->dummyCycles / 8U); i++)
+    {
+        header[len++] = 0U;
+    }
+
+    return inst->device->spi_qspi_write_read(
+        0U, 0U,
+        0U, 0U, 0U,
+        0U, 0U, 0U,
+        0U,
+        header, len,
+        out, size,
+        1U
+    );
+}
+
+/* Leave continuous read mode before any other command */
+static bool ExitContinuousRead(W25QxxInstance_t* inst)
+{
+    if (!inst->continuous)
+    {
+        return true;
+    }
+
+    const ReadCommand_t* cmd = &f_readCommands[W25QXX_READ_QUAD_IO_CONTINUOUS];
+    uint8_t scratch;
+
+    inst->continuous = false;
+
+    return 0U == inst->device->spi_qspi_write_read(
+        cmd->instruction, 0U,
+        0U, cmd->addressLines, AddressLength(inst),
+        MODE_EXIT, cmd->modeLines, 1U,
+        cmd->dummyCycles,
+        NULL, 0U,
+        &scratch, 1U,
+        cmd->dataLines
+    );
+}
+
+static bool ReadDirect(W25QxxInstance_t* inst, Address_t address, size_t size, uint8_t* out)
+{
+    if (inst->readMode == W25QXX_READ_STANDARD)
+    {
+        return 0U == w25qxx_read(inst->device, address, out, size);
+    }
+
+    const ReadCommand_t* cmd = &f_readCommands[inst->readMode];
+
+    if (IsSpi(inst))
+    {
+        return 0U == SpiRead(inst, cmd, address, size, out);
+    }
+
+    const bool continuous = (inst->readMode == W25QXX_READ_QUAD_IO_CONTINUOUS);
+
+    /* Instruction is skipped while the device is in continuous read mode */
+    const uint8_t result = inst->device->spi_qspi_write_read(
+        cmd->instruction, inst->continuous ? 0U : 1U,
+        address, cmd->addressLines, AddressLength(inst),
+        continuous ? MODE_CONTINUOUS : MODE_EXIT, cmd->modeLines, (cmd->modeLines != 0U) ? 1U : 0U,
+        cmd->dummyCycles,
+        NULL, 0U,
+        out, size,
+        cmd->dataLines
+    );
+
+    inst->continuous = continuous && (0U == result);
+
+    return 0U == result;
+}
+
+/* Stream flash contents through CRC32 without keeping them */
+static bool VerifyCrc(W25QxxInstance_t* inst, Address_t address, size_t size, uint32_t expected)
+{
+    uint8_t stackChunk[VERIFY_CHUNK_SIZE];
+    uint8_t* const chunk = (NULL != inst->buf) ? inst->buf : stackChunk;
+    const size_t chunkSize = (NULL != inst->buf) ? inst->bufSize : sizeof(stackChunk);
+
+    uint32_t crc = 0U;
+    size_t pos = 0U;
+
+    while (pos < size)
+    {
+        const size_t blockSize = Min(size - pos, chunkSize);
+
+        if (!ReadDirect(inst, address + pos, blockSize, chunk))
+        {
+            return false;
+        }
+
+        crc = CRC32_Update(crc, chunk, blockSize);
+        pos += blockSize;
+    }
+
+    return crc == expected;
+}
+
+/* Writes and erases change flash contents and end continuous read mode */
+static bool PrepareModify(W25QxxInstance_t* inst)
+{
+    inst->cacheSize = 0U;
+    return ExitContinuousRead(inst);
+}
+
+static bool Erase(W25QxxInstance_t* inst, W25QxxEraseOp_t op, Address_t address)
+{
+    switch (op)
+    {
+    case W25QXX_ERASE_4K:
+        return 0U == w25qxx_sector_erase_4k(inst->device, address);
+    case W25QXX_ERASE_32K:
+        return 0U == w25qxx_block_erase_32k(inst->device, address);
+    case W25QXX_ERASE_64K:
+        return 0U == w25qxx_block_erase_64k(inst->device, address);
+    case W25QXX_ERASE_CHIP:
+        return 0U == w25qxx_chip_erase(inst->device);
+    default:
+        return false;
+    }
+}
+
 /*----------------------------------------------------------------------------*/
 /* PUBLIC FUNCTION DEFINITIONS                                                */
 /*----------------------------------------------------------------------------*/
 
-bool W25Qxx_INTERFACE_Init(
+bool W25Qxx_INSTANCE_Init(
+    W25QxxInstance_t* inst,
     w25qxx_handle_t* device, 
     uint8_t* workBuffer, 
     size_t workBufferSize
 )
 {
-    if ((NULL != device) &&
-        (NULL != workBuffer) &&
-        (0U != workBufferSize))
+    if ((NULL != inst) &&
+        (NULL != device) &&
+        ((NULL == workBuffer) == (0U == workBufferSize)))
     {
-        f_w25qxx = device;
-        f_buf = workBuffer;
-        f_bufSize = workBufferSize;
+        memset(inst, 0, sizeof(W25QxxInstance_t));
+        inst->device = device;
+        inst->buf = workBuffer;
+        inst->bufSize = workBufferSize;
+        inst->eraseTimes = &W25QXX_ERASE_TIMES_TYPICAL;
+        inst->readMode = W25QXX_READ_STANDARD;
+        inst->verifyMode = (NULL != workBuffer) ? W25QXX_VERIFY_COMPARE : W25QXX_VERIFY_CRC;
         return true;
     }
     return false;
 }
 
-bool W25Qxx_INTERFACE_ReadFlash(
+bool W25Qxx_INSTANCE_ConfigureRead(
+    W25QxxInstance_t* inst,
+    W25QxxReadMode_t mode,
+    uint8_t* readAheadBuffer,
+    size_t readAheadSize
+)
+{
+    if ((NULL == inst->device) ||
+        (mode > W25QXX_READ_AUTO) ||
+        !ModeSupported(inst, mode) ||
+        ((NULL == readAheadBuffer) != (0U == readAheadSize)))
+    {
+        return false;
+    }
+
+    if (mode == W25QXX_READ_AUTO)
+    {
+        /* The driver reads QPI with 4 lines itself */
+        mode = IsQpi(inst) ? W25QXX_READ_STANDARD : W25QXX_READ_FAST;
+    }
+
+    if (!PrepareModify(inst))
+    {
+        return false;
+    }
+
+    inst->readMode = mode;
+    inst->readAhead = readAheadBuffer;
+    inst->readAheadSize = readAheadSize;
+    inst->lastReadEnd = 0U;
+
+    return true;
+}
+
+bool W25Qxx_INSTANCE_ReadFlash(
+    W25QxxInstance_t* inst,
     Address_t address, 
     size_t size, 
     uint8_t* out
 )
 {
-    return 0U == w25qxx_read(f_w25qxx, address, out, size);
+    size_t pos = 0U;
+
+    /* Serve the cached part */
+    if ((inst->cacheSize != 0U) &&
+        (address >= inst->cacheAddress) &&
+        ((address - inst->cacheAddress) < inst->cacheSize))
+    {
+        const size_t offset = address - inst->cacheAddress;
+        pos = Min(size, inst->cacheSize - offset);
+        memcpy(out, &inst->readAhead[offset], pos);
+    }
+
+    if (pos < size)
+    {
+        const Address_t next = address + pos;
+        const size_t remaining = size - pos;
+        const bool sequential = (next == inst->lastReadEnd) || (pos != 0U);
+
+        const uint64_t limit = ReadLimit(inst);
+        const size_t fill = ((uint64_t)next >= limit) ? 0U :
+                            (size_t)Min((uint64_t)inst->readAheadSize, limit - next);
+
+        if (sequential && (remaining < fill))
+        {
+            inst->cacheSize = 0U;
+            if (!ReadDirect(inst, next, fill, inst->readAhead))
+            {
+                return false;
+            }
+            inst->cacheAddress = next;
+            inst->cacheSize = fill;
+
+            memcpy(&out[pos], inst->readAhead, remaining);
+        }
+        else if (!ReadDirect(inst, next, remaining, &out[pos]))
+        {
+            return false;
+        }
+    }
+
+    inst->lastReadEnd = address + size;
+
+    return true;
 }
 
-bool W25Qxx_INTERFACE_WriteFlash(
+bool W25Qxx_INSTANCE_WriteFlash(
+    W25QxxInstance_t* inst,
     Address_t address, 
     size_t size, 
     const uint8_t* in
 )
 {
-    return 0U == w25qxx_write(f_w25qxx, address, (uint8_t*)in, size);
+    return PrepareModify(inst) &&
+           (0U == w25qxx_write(inst->device, address, (uint8_t*)in, size));
 }
 
-bool W25Qxx_INTERFACE_WriteAndVerifyFlash(
+bool W25Qxx_INSTANCE_WriteAndVerifyFlash(
+    W25QxxInstance_t* inst,
     Address_t address, 
     size_t size, 
     const uint8_t* in
 )
 {
-    if (!W25Qxx_INTERFACE_WriteFlash(address, size, in))
+    if (!W25Qxx_INSTANCE_WriteFlash(inst, address, size, in))
     {
         return false;
     }
 
+    if (inst->verifyMode == W25QXX_VERIFY_CRC)
+    {
+        return VerifyCrc(inst, address, size, CRC32_Calculate(in, size));
+    }
+
     size_t pos = 0U;
 
     while (pos < size)
     {
         const size_t remaining = size - pos;
-        const size_t blockSize = Min(remaining, f_bufSize);
+        const size_t blockSize = Min(remaining, inst->bufSize);
 
         const Address_t readAddr = address + pos;
-        if (0U != w25qxx_read(f_w25qxx, readAddr, f_buf, blockSize))
+        if (!ReadDirect(inst, readAddr, blockSize, inst->buf))
         {
             break;
         }
 
-        if (0 != memcmp(f_buf, &in[pos], blockSize))
+        if (0 != memcmp(inst->buf, &in[pos], blockSize))
         {
             break;
         }
@@ -136,62 +423,158 @@ bool W25Qxx_INTERFACE_WriteAndVerifyFlash(
     return pos == size;
 }
 
-bool W25Qxx_INTERFACE_EraseFlash(
+bool W25Qxx_INSTANCE_ConfigureVerify(
+    W25QxxInstance_t* inst,
+    W25QxxVerifyMode_t mode
+)
+{
+    if ((NULL == inst) ||
+        (mode > W25QXX_VERIFY_CRC) ||
+        ((mode == W25QXX_VERIFY_COMPARE) && (NULL == inst->buf)))
+    {
+        return false;
+    }
+
+    inst->verifyMode = mode;
+    return true;
+}
+
+bool W25Qxx_INSTANCE_ConfigureErase(
+    W25QxxInstance_t* inst,
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times
+)
+{
+    inst->deviceSize = deviceSize;
+    inst->eraseTimes = (NULL != times) ? times : &W25QXX_ERASE_TIMES_TYPICAL;
+    return true;
+}
+
+bool W25Qxx_INSTANCE_PlanErase(
+    W25QxxInstance_t* inst,
+    Address_t address, 
+    size_t size,
+    W25QxxErasePlan_t* plan
+)
+{
+    return W25Qxx_ERASE_Plan(address, size, inst->deviceSize, inst->eraseTimes, plan);
+}
+
+bool W25Qxx_INSTANCE_EraseFlash(
+    W25QxxInstance_t* inst,
     Address_t address, 
     size_t size
 )
 {
-    if (!Aligned(address, _4KB) ||
-        !Aligned(size, _4KB) ||
-        (size == 0U))
+    W25QxxErasePlan_t plan;
+
+    if (!W25Qxx_INSTANCE_PlanErase(inst, address, size, &plan) ||
+        !PrepareModify(inst))
     {
         return false;
     }
 
-    const Address_t start = address;
+    if (plan.count[W25QXX_ERASE_CHIP] != 0U)
+    {
+        return Erase(inst, W25QXX_ERASE_CHIP, 0U);
+    }
+
+    /* end wraps to 0 for a range ending at 4 GB, so count the offset in
+     * 64 bits: size may be 4 GB itself */
     const Address_t end = address + size;
-    Address_t pos = start;
+    uint64_t offset = 0U;
 
-    while (pos < end)
+    while (offset < size)
     {
-        const size_t remaining = end - pos;
-        
-        if (Aligned(pos, _64KB) && (remaining > _64KB))
-        {
-            if (0U == w25qxx_block_erase_64k(f_w25qxx, pos))
-            {
-                pos += _64KB;
-            }
-            else
-            {
-                break;
-            }
-        }
-        else if (Aligned(pos, _32KB) && (remaining > _32KB))
-        {
-            if (0U == w25qxx_block_erase_32k(f_w25qxx, pos))
-            {
-                pos += _32KB;
-            }
-            else
-            {
-                break;
-            }
-        }
-        else
+        const Address_t pos = address + (Address_t)offset;
+        const W25QxxEraseOp_t op = W25Qxx_ERASE_Next(pos, end, inst->eraseTimes);
+
+        if (!Erase(inst, op, pos))
         {
-            if (0U == w25qxx_sector_erase_4k(f_w25qxx, pos))
-            {
-                pos += _4KB;
-            }
-            else
-            {
-                break;
-            }
+            break;
         }
+
+        offset += W25Qxx_ERASE_OpSize(op, inst->deviceSize);
     }
 
-    return pos == end;
+    return offset == size;
+}
+
+bool W25Qxx_INTERFACE_Init(
+    w25qxx_handle_t* device, 
+    uint8_t* workBuffer, 
+    size_t workBufferSize
+)
+{
+    return W25Qxx_INSTANCE_Init(&f_instance, device, workBuffer, workBufferSize);
+}
+
+bool W25Qxx_INTERFACE_ConfigureRead(
+    W25QxxReadMode_t mode,
+    uint8_t* readAheadBuffer,
+    size_t readAheadSize
+)
+{
+    return W25Qxx_INSTANCE_ConfigureRead(&f_instance, mode, readAheadBuffer, readAheadSize);
+}
+
+bool W25Qxx_INTERFACE_ReadFlash(
+    Address_t address, 
+    size_t size, 
+    uint8_t* out
+)
+{
+    return W25Qxx_INSTANCE_ReadFlash(&f_instance, address, size, out);
+}
+
+bool W25Qxx_INTERFACE_WriteFlash(
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+)
+{
+    return W25Qxx_INSTANCE_WriteFlash(&f_instance, address, size, in);
+}
+
+bool W25Qxx_INTERFACE_WriteAndVerifyFlash(
+    Address_t address, 
+    size_t size, 
+    const uint8_t* in
+)
+{
+    return W25Qxx_INSTANCE_WriteAndVerifyFlash(&f_instance, address, size, in);
+}
+
+bool W25Qxx_INTERFACE_ConfigureVerify(
+    W25QxxVerifyMode_t mode
+)
+{
+    return W25Qxx_INSTANCE_ConfigureVerify(&f_instance, mode);
+}
+
+bool W25Qxx_INTERFACE_ConfigureErase(
+    size_t deviceSize,
+    const W25QxxEraseTimes_t* times
+)
+{
+    return W25Qxx_INSTANCE_ConfigureErase(&f_instance, deviceSize, times);
+}
+
+bool W25Qxx_INTERFACE_PlanErase(
+    Address_t address, 
+    size_t size,
+    W25QxxErasePlan_t* plan
+)
+{
+    return W25Qxx_INSTANCE_PlanErase(&f_instance, address, size, plan);
+}
+
+bool W25Qxx_INTERFACE_EraseFlash(
+    Address_t address, 
+    size_t size
+)
+{
+    return W25Qxx_INSTANCE_EraseFlash(&f_instance, address, size);
 }
 
 /* EoF interface_w25qxx.c */